@@ -0,0 +1,295 @@
+#include "Analysis/AliasAnalysis.h"
+
+#include "Util/Timer.h"
+#include "Util/Log.h"
+
+namespace Analysis {
+	/*!
+	 * \brief Check whether two byte ranges overlap
+	 * \param a Start of first range
+	 * \param aSize Size of first range
+	 * \param b Start of second range
+	 * \param bSize Size of second range
+	 * \return True if the ranges overlap
+	 */
+	static bool overlaps(int a, int aSize, int b, int bSize)
+	{
+		return a < b + bSize && b < a + aSize;
+	}
+
+	/*!
+	 * \brief Constructor
+	 * \param procedure Procedure to analyze
+	 * \param reachingDefs Reaching def information for the procedure
+	 * \param useDefs Use-def chains for the procedure
+	 */
+	AliasAnalysis::AliasAnalysis(const IR::Procedure &procedure, const ReachingDefs &reachingDefs, const UseDefs &useDefs)
+		: mReachingDefs(reachingDefs), mUseDefs(useDefs)
+	{
+		Util::Timer timer;
+		timer.start();
+
+		for(const IR::Entry *entry : procedure.entries()) {
+			if(entry->type == IR::Entry::Type::New && checkEscape(entry)) {
+				mEscaping.insert(entry);
+			}
+		}
+
+		Util::log("opt.time") << "  AliasAnalysis(" << procedure.name() << "): " << timer.stop() << "ms" << std::endl;
+	}
+
+	/*!
+	 * \brief Check whether two memory accesses may refer to the same memory
+	 * \param a First LoadMem or StoreMem entry
+	 * \param b Second LoadMem or StoreMem entry
+	 * \return False if the accesses can never overlap
+	 */
+	bool AliasAnalysis::mayAlias(const IR::Entry *a, const IR::Entry *b) const
+	{
+		return mayAlias(a, a, b, b);
+	}
+
+	/*!
+	 * \brief Check whether two memory accesses may refer to the same memory, with each
+	 *        access's address evaluated at a given point in the procedure
+	 * \param a First LoadMem or StoreMem entry
+	 * \param aPoint Entry at which to evaluate the address of a
+	 * \param b Second LoadMem or StoreMem entry
+	 * \param bPoint Entry at which to evaluate the address of b
+	 * \return False if the accesses can never overlap
+	 */
+	bool AliasAnalysis::mayAlias(const IR::Entry *a, const IR::Entry *aPoint, const IR::Entry *b, const IR::Entry *bPoint) const
+	{
+		const IR::EntryThreeAddr *aThreeAddr = (const IR::EntryThreeAddr*)a;
+		const IR::EntryThreeAddr *bThreeAddr = (const IR::EntryThreeAddr*)b;
+		const IR::MemoryRegion &aRegion = aThreeAddr->region;
+		const IR::MemoryRegion &bRegion = bThreeAddr->region;
+
+		// Class fields never overlap array elements, and an array's elements all have the
+		// same size.  Fields of any two objects overlap only if their offsets do.
+		if(aRegion.kind != IR::MemoryRegion::Kind::Unknown && bRegion.kind != IR::MemoryRegion::Kind::Unknown) {
+			if(aRegion.kind != bRegion.kind) {
+				return false;
+			}
+
+			if(aRegion.kind == IR::MemoryRegion::Kind::Element && aRegion.size != bRegion.size) {
+				return false;
+			}
+
+			if(aRegion.kind == IR::MemoryRegion::Kind::Field && !aThreeAddr->rhs2 && !bThreeAddr->rhs2 && !overlaps(aThreeAddr->imm, aRegion.size, bThreeAddr->imm, bRegion.size)) {
+				return false;
+			}
+		}
+
+		// Constant offsets from the same address
+		if(aThreeAddr->rhs1 == bThreeAddr->rhs1 && !aThreeAddr->rhs2 && !bThreeAddr->rhs2 && sameValue(aThreeAddr->rhs1, aPoint, bPoint)) {
+			if(!overlaps(aThreeAddr->imm, aThreeAddr->lhs->size, bThreeAddr->imm, bThreeAddr->lhs->size)) {
+				return false;
+			}
+		}
+
+		// Addresses from distinct allocation sites never alias.  An address of unknown origin
+		// can only alias an allocation whose address has escaped the procedure.
+		Sites aSites = allocationSites(aThreeAddr->rhs1, aPoint);
+		Sites bSites = allocationSites(bThreeAddr->rhs1, bPoint);
+		for(const IR::Entry *site : aSites.sites) {
+			if(bSites.sites.find(site) != bSites.sites.end()) {
+				return true;
+			}
+		}
+
+		if(aSites.unknown && bSites.unknown) {
+			return true;
+		}
+
+		if(aSites.unknown) {
+			for(const IR::Entry *site : bSites.sites) {
+				if(escapes(site)) {
+					return true;
+				}
+			}
+		}
+
+		if(bSites.unknown) {
+			for(const IR::Entry *site : aSites.sites) {
+				if(escapes(site)) {
+					return true;
+				}
+			}
+		}
+
+		return false;
+	}
+
+	/*!
+	 * \brief Check whether two memory accesses always refer to the same memory
+	 * \param a First LoadMem or StoreMem entry
+	 * \param b Second LoadMem or StoreMem entry
+	 * \return True if the accesses are to the same address, with the same size
+	 */
+	bool AliasAnalysis::mustAlias(const IR::Entry *a, const IR::Entry *b) const
+	{
+		const IR::EntryThreeAddr *aThreeAddr = (const IR::EntryThreeAddr*)a;
+		const IR::EntryThreeAddr *bThreeAddr = (const IR::EntryThreeAddr*)b;
+
+		if(aThreeAddr->rhs1 != bThreeAddr->rhs1 || aThreeAddr->rhs2 != bThreeAddr->rhs2 || aThreeAddr->imm != bThreeAddr->imm || aThreeAddr->lhs->size != bThreeAddr->lhs->size) {
+			return false;
+		}
+
+		if(!sameValue(aThreeAddr->rhs1, a, b)) {
+			return false;
+		}
+
+		return !aThreeAddr->rhs2 || sameValue(aThreeAddr->rhs2, a, b);
+	}
+
+	/*!
+	 * \brief Check whether a memory access is to memory which is invisible outside the
+	 *        procedure
+	 * \param entry LoadMem or StoreMem entry
+	 * \return True if the access's address can only come from non-escaping allocations
+	 */
+	bool AliasAnalysis::isLocal(const IR::Entry *entry) const
+	{
+		const IR::EntryThreeAddr *threeAddr = (const IR::EntryThreeAddr*)entry;
+		Sites sites = allocationSites(threeAddr->rhs1, entry);
+		if(sites.unknown || sites.sites.empty()) {
+			return false;
+		}
+
+		for(const IR::Entry *site : sites.sites) {
+			if(escapes(site)) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	/*!
+	 * \brief Determine the allocation sites from which the value of a symbol may come
+	 * \param symbol Symbol holding an address
+	 * \param point Entry at which to evaluate the symbol
+	 * \return Allocation sites
+	 */
+	AliasAnalysis::Sites AliasAnalysis::allocationSites(const IR::Symbol *symbol, const IR::Entry *point) const
+	{
+		Sites sites;
+		sites.unknown = false;
+		std::set<const IR::Entry*> visited;
+		addSites(symbol, point, sites, visited);
+
+		return sites;
+	}
+
+	/*!
+	 * \brief Add the allocation sites of a symbol, following chains of copies
+	 * \param symbol Symbol holding an address
+	 * \param point Entry at which to evaluate the symbol
+	 * \param sites Sites to add to
+	 * \param visited Definitions already followed
+	 */
+	void AliasAnalysis::addSites(const IR::Symbol *symbol, const IR::Entry *point, Sites &sites, std::set<const IR::Entry*> &visited) const
+	{
+		std::set<const IR::Entry*> defs = mReachingDefs.defsForSymbol(point, symbol);
+		if(defs.empty()) {
+			sites.unknown = true;
+			return;
+		}
+
+		for(const IR::Entry *def : defs) {
+			if(!visited.insert(def).second) {
+				continue;
+			}
+
+			const IR::EntryThreeAddr *threeAddr = (const IR::EntryThreeAddr*)def;
+			if(def->type == IR::Entry::Type::New) {
+				sites.sites.insert(def);
+			} else if(def->type == IR::Entry::Type::Move && threeAddr->rhs1) {
+				addSites(threeAddr->rhs1, def, sites, visited);
+			} else {
+				sites.unknown = true;
+			}
+		}
+	}
+
+	/*!
+	 * \brief Check whether a symbol holds the same value at two points
+	 * \param symbol Symbol to check
+	 * \param aPoint First entry
+	 * \param bPoint Second entry
+	 * \return True if the same single definition of the symbol reaches both points
+	 */
+	bool AliasAnalysis::sameValue(const IR::Symbol *symbol, const IR::Entry *aPoint, const IR::Entry *bPoint) const
+	{
+		if(aPoint == bPoint) {
+			return true;
+		}
+
+		std::set<const IR::Entry*> aDefs = mReachingDefs.defsForSymbol(aPoint, symbol);
+		return aDefs.size() == 1 && aDefs == mReachingDefs.defsForSymbol(bPoint, symbol);
+	}
+
+	/*!
+	 * \brief Check whether the address produced by an allocation site escapes the procedure
+	 * \param site New entry
+	 * \return True if the address escapes
+	 */
+	bool AliasAnalysis::escapes(const IR::Entry *site) const
+	{
+		return mEscaping.find(site) != mEscaping.end();
+	}
+
+	/*!
+	 * \brief Follow the uses of an allocation site's address to see whether it escapes
+	 *
+	 * The address escapes unless it is only ever copied, compared, or used as the base
+	 * address of a load or store.
+	 * \param site New entry
+	 * \return True if the address escapes
+	 */
+	bool AliasAnalysis::checkEscape(const IR::Entry *site) const
+	{
+		std::vector<const IR::Entry*> queue;
+		std::set<const IR::Entry*> visited;
+		queue.push_back(site);
+		visited.insert(site);
+		while(!queue.empty()) {
+			const IR::Entry *def = queue.back();
+			queue.pop_back();
+			const IR::Symbol *symbol = def->assign();
+
+			for(const IR::Entry *use : mUseDefs.uses(def)) {
+				const IR::EntryThreeAddr *threeAddr = (const IR::EntryThreeAddr*)use;
+				switch(use->type) {
+					case IR::Entry::Type::LoadMem:
+						if(threeAddr->rhs2 == symbol) {
+							return true;
+						}
+						break;
+
+					case IR::Entry::Type::StoreMem:
+						if(threeAddr->lhs == symbol || threeAddr->rhs2 == symbol) {
+							return true;
+						}
+						break;
+
+					case IR::Entry::Type::Equal:
+					case IR::Entry::Type::Nequal:
+						break;
+
+					case IR::Entry::Type::Move:
+						if(visited.insert(use).second) {
+							queue.push_back(use);
+						}
+						break;
+
+					default:
+						return true;
+				}
+			}
+		}
+
+		return false;
+	}
+}
\ No newline at end of file
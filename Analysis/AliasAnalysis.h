@@ -0,0 +1,55 @@
+#ifndef ANALYSIS_ALIAS_ANALYSIS_H
+#define ANALYSIS_ALIAS_ANALYSIS_H
+
+#include "IR/Entry.h"
+#include "IR/Symbol.h"
+#include "IR/Procedure.h"
+
+#include "Analysis/ReachingDefs.h"
+#include "Analysis/UseDefs.h"
+
+#include <set>
+#include <vector>
+
+namespace Analysis {
+	/*!
+	 * \brief Determine whether memory accesses may refer to the same memory
+	 *
+	 * Two LoadMem/StoreMem entries are known not to alias when:
+	 *  - They access different kinds of memory (a class field and an array element), or
+	 *    array elements of different sizes
+	 *  - They access class fields at non-overlapping offsets, or use the same base address
+	 *    with non-overlapping constant offsets
+	 *  - Their base addresses come from different allocation sites.  An allocation whose
+	 *    address never escapes the procedure also cannot alias an address from anywhere else
+	 */
+	class AliasAnalysis {
+	public:
+		AliasAnalysis(const IR::Procedure &procedure, const ReachingDefs &reachingDefs, const UseDefs &useDefs);
+
+		bool mayAlias(const IR::Entry *a, const IR::Entry *b) const;
+		bool mayAlias(const IR::Entry *a, const IR::Entry *aPoint, const IR::Entry *b, const IR::Entry *bPoint) const;
+		bool mustAlias(const IR::Entry *a, const IR::Entry *b) const;
+		bool isLocal(const IR::Entry *entry) const;
+
+	private:
+		/*!
+		 * \brief Allocation sites which may produce an address
+		 */
+		struct Sites {
+			std::set<const IR::Entry*> sites; //!< New entries which may produce the address
+			bool unknown; //!< True if the address may also come from elsewhere
+		};
+
+		Sites allocationSites(const IR::Symbol *symbol, const IR::Entry *point) const;
+		void addSites(const IR::Symbol *symbol, const IR::Entry *point, Sites &sites, std::set<const IR::Entry*> &visited) const;
+		bool sameValue(const IR::Symbol *symbol, const IR::Entry *aPoint, const IR::Entry *bPoint) const;
+		bool escapes(const IR::Entry *site) const;
+		bool checkEscape(const IR::Entry *site) const;
+
+		const ReachingDefs &mReachingDefs; //!< Reaching def information for the procedure
+		const UseDefs &mUseDefs; //!< Use-def chains for the procedure
+		std::set<const IR::Entry*> mEscaping; //!< Allocation sites whose address escapes the procedure
+	};
+}
+#endif
\ No newline at end of file
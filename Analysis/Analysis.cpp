@@ -42,8 +42,18 @@ namespace Analysis {
 		return *mConstants;
 	}
 
+	const AliasAnalysis &Analysis::aliasAnalysis()
+	{
+		if(!mAliasAnalysis) {
+			mAliasAnalysis = std::make_unique<AliasAnalysis>(mProcedure, reachingDefs(), useDefs());
+		}
+
+		return *mAliasAnalysis;
+	}
+
 	void Analysis::invalidate()
 	{
+		mAliasAnalysis.reset();
 		mConstants.reset();
 		mUseDefs.reset();
 		mReachingDefs.reset();
@@ -52,6 +62,9 @@ namespace Analysis {
 
 	void Analysis::replace(IR::Entry *oldEntry, IR::Entry *newEntry)
 	{
+		// A new entry may use an address in a way which lets it escape
+		mAliasAnalysis.reset();
+
 		if(mUseDefs) {
 			mUseDefs->replace(oldEntry, newEntry);
 		}
@@ -63,6 +76,8 @@ namespace Analysis {
 
 	void Analysis::replaceUse(IR::Entry *entry, const IR::Symbol *oldSymbol, const IR::Symbol *newSymbol)
 	{
+		mAliasAnalysis.reset();
+
 		if(mUseDefs) {
 			mUseDefs->replaceUse(entry, oldSymbol, newSymbol);
 		}
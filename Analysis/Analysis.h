@@ -5,6 +5,7 @@
 #include "Analysis/ReachingDefs.h"
 #include "Analysis/UseDefs.h"
 #include "Analysis/Constants.h"
+#include "Analysis/AliasAnalysis.h"
 
 #include "IR/Procedure.h"
 
@@ -19,6 +20,7 @@ namespace Analysis {
 		const ReachingDefs &reachingDefs();
 		const UseDefs &useDefs();
 		const Constants &constants();
+		const AliasAnalysis &aliasAnalysis();
 
 		void invalidate();
 
@@ -31,6 +33,7 @@ namespace Analysis {
 		std::unique_ptr<ReachingDefs> mReachingDefs;
 		std::unique_ptr<UseDefs> mUseDefs;
 		std::unique_ptr<Constants> mConstants;
+		std::unique_ptr<AliasAnalysis> mAliasAnalysis;
 
 		const IR::Procedure &mProcedure;
 	};
@@ -0,0 +1,112 @@
+#include "Analysis/CallGraph.h"
+
+#include "IR/Entry.h"
+
+namespace Analysis {
+	static std::set<IR::Procedure*> emptyProcedureSet; //!< Empty procedure set, used when lookup fails
+
+	/*!
+	 * \brief Constructor
+	 * \param program Program to analyze
+	 */
+	CallGraph::CallGraph(IR::Program &program)
+	{
+		for(std::unique_ptr<IR::Procedure> &procedure : program.procedures()) {
+			mProcedures[procedure->name()] = procedure.get();
+		}
+
+		// Link each procedure to the procedures it calls
+		for(std::unique_ptr<IR::Procedure> &procedure : program.procedures()) {
+			std::set<IR::Procedure*> &callees = mCallees[procedure.get()];
+			for(const IR::Entry *entry : procedure->entries()) {
+				if(entry->type == IR::Entry::Type::Call) {
+					IR::Procedure *callee = this->procedure(((const IR::EntryCall*)entry)->target);
+					if(callee) {
+						callees.insert(callee);
+					}
+				}
+			}
+		}
+
+		// A procedure is recursive if it can be reached from any of its callees
+		for(std::unique_ptr<IR::Procedure> &procedure : program.procedures()) {
+			std::set<IR::Procedure*> seen;
+			std::vector<IR::Procedure*> stack(mCallees[procedure.get()].begin(), mCallees[procedure.get()].end());
+			while(!stack.empty()) {
+				IR::Procedure *callee = stack.back();
+				stack.pop_back();
+				if(callee == procedure.get()) {
+					mRecursive.insert(callee);
+					break;
+				}
+
+				if(seen.insert(callee).second) {
+					stack.insert(stack.end(), mCallees[callee].begin(), mCallees[callee].end());
+				}
+			}
+		}
+
+		std::set<IR::Procedure*> seen;
+		for(std::unique_ptr<IR::Procedure> &procedure : program.procedures()) {
+			sortRecurse(procedure.get(), seen);
+		}
+	}
+
+	/*!
+	 * \brief Add a procedure to the bottom-up order, after all of its callees
+	 * \param procedure Procedure to add
+	 * \param seen Procedures already visited
+	 */
+	void CallGraph::sortRecurse(IR::Procedure *procedure, std::set<IR::Procedure*> &seen)
+	{
+		if(!seen.insert(procedure).second) {
+			return;
+		}
+
+		for(IR::Procedure *callee : mCallees[procedure]) {
+			sortRecurse(callee, seen);
+		}
+
+		mBottomUp.push_back(procedure);
+	}
+
+	/*!
+	 * \brief Look up a procedure by name
+	 * \param name Procedure name
+	 * \return Procedure, or 0 if it is not part of the program
+	 */
+	IR::Procedure *CallGraph::procedure(const std::string &name) const
+	{
+		auto it = mProcedures.find(name);
+		if(it == mProcedures.end()) {
+			return 0;
+		}
+
+		return it->second;
+	}
+
+	/*!
+	 * \brief Procedures called directly by a procedure
+	 * \param procedure Calling procedure
+	 * \return Set of callees
+	 */
+	const std::set<IR::Procedure*> &CallGraph::callees(IR::Procedure *procedure) const
+	{
+		auto it = mCallees.find(procedure);
+		if(it == mCallees.end()) {
+			return emptyProcedureSet;
+		}
+
+		return it->second;
+	}
+
+	/*!
+	 * \brief Determine whether a procedure can call itself, directly or indirectly
+	 * \param procedure Procedure to check
+	 * \return True if procedure is recursive
+	 */
+	bool CallGraph::recursive(IR::Procedure *procedure) const
+	{
+		return mRecursive.find(procedure) != mRecursive.end();
+	}
+}
\ No newline at end of file
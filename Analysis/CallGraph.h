@@ -0,0 +1,37 @@
+#ifndef ANALYSIS_CALL_GRAPH_H
+#define ANALYSIS_CALL_GRAPH_H
+
+#include "IR/Program.h"
+#include "IR/Procedure.h"
+
+#include <map>
+#include <set>
+#include <vector>
+#include <string>
+
+namespace Analysis {
+	/*!
+	 * \brief Call graph of a program
+	 *
+	 * Records which procedures in a program call which others directly.  Calls to procedures
+	 * outside of the program, and indirect calls, have no edges in the graph.
+	 */
+	class CallGraph {
+	public:
+		CallGraph(IR::Program &program);
+
+		IR::Procedure *procedure(const std::string &name) const;
+		const std::set<IR::Procedure*> &callees(IR::Procedure *procedure) const;
+		bool recursive(IR::Procedure *procedure) const;
+		const std::vector<IR::Procedure*> &bottomUp() const { return mBottomUp; } //!< Procedures ordered so that callees precede their callers, where possible
+
+	private:
+		void sortRecurse(IR::Procedure *procedure, std::set<IR::Procedure*> &seen);
+
+		std::map<std::string, IR::Procedure*> mProcedures; //!< Procedures by name
+		std::map<IR::Procedure*, std::set<IR::Procedure*>> mCallees; //!< Procedures called directly by each procedure
+		std::set<IR::Procedure*> mRecursive; //!< Procedures which can call themselves, directly or indirectly
+		std::vector<IR::Procedure*> mBottomUp; //!< Procedures in bottom-up order
+	};
+}
+#endif
\ No newline at end of file
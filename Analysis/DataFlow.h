@@ -9,6 +9,7 @@
 
 #include <map>
 #include <set>
+#include <vector>
 
 namespace Analysis {
 	/*!
@@ -20,7 +21,8 @@ namespace Analysis {
 	 *
 	 * A data flow analysis works with Ts, which is a generic term for some type of data
 	 * that can be associated with an IR entry.  The output of the analysis is the list of
-	 * Ts associated with each entry in the procedure.
+	 * Ts associated with each entry in the procedure.  All per-entry sets are stored in
+	 * vectors indexed by the entry's id.
 	 *
 	 * The components of a data flow analysis are:
 	 *
@@ -58,16 +60,16 @@ namespace Analysis {
 		/*!
 		 * \brief Analyze a control flow graph
 		 * \param graph Graph to analyze
-		 * \param gen Gen sets
-		 * \param kill Kill sets
+		 * \param gen Gen sets, indexed by entry id
+		 * \param kill Kill sets, indexed by entry id
 		 * \param all All Ts that can occur in the output sets
 		 * \param meetType Operation to use when meeting edges
 		 * \param direction Direction of data flow
-		 * \return Set of Ts attached to each entry of the graph
+		 * \return Set of Ts attached to each entry of the graph, indexed by entry id
 		 */
-		std::map<const IR::Entry*, std::set<T>> analyze(const FlowGraph &graph, std::map<const IR::Entry*, std::set<T>> &gen, std::map<const IR::Entry*, std::set<T>> &kill, std::set<T> &all, Meet meetType, Direction direction)
+		std::vector<std::set<T>> analyze(const FlowGraph &graph, std::vector<std::set<T>> &gen, std::vector<std::set<T>> &kill, std::set<T> &all, Meet meetType, Direction direction)
 		{
-			std::map<const IR::Entry*, std::set<T>> map;
+			std::vector<std::set<T>> map(gen.size());
 			std::map<const FlowGraph::Block*, std::set<T>> genBlock;
 			std::map<const FlowGraph::Block*, std::set<T>> killBlock;
 
@@ -78,15 +80,15 @@ namespace Analysis {
 				switch(direction) {
 					case Direction::Forward:
 						for(const IR::Entry *entry : block->entries) {
-							g = transfer(g, gen[entry], kill[entry]);
-							k = transfer(k, kill[entry], gen[entry]);
+							g = transfer(g, gen[entry->id], kill[entry->id]);
+							k = transfer(k, kill[entry->id], gen[entry->id]);
 						}
 						break;
 
 					case Direction::Backward:
 						for(const IR::Entry *entry : block->entries.reversed()) {
-							g = transfer(g, gen[entry], kill[entry]);
-							k = transfer(k, kill[entry], gen[entry]);
+							g = transfer(g, gen[entry->id], kill[entry->id]);
+							k = transfer(k, kill[entry->id], gen[entry->id]);
 						}
 						break;
 				}
@@ -189,15 +191,15 @@ namespace Analysis {
 				switch(direction) {
 					case Direction::Forward:
 						for(const IR::Entry *entry : block->entries) {
-							map[entry] = set;
-							set = transfer(set, gen[entry], kill[entry]);
+							map[entry->id] = set;
+							set = transfer(set, gen[entry->id], kill[entry->id]);
 						}
 						break;
 
 					case Direction::Backward:
 						for(const IR::Entry *entry : block->entries.reversed()) {
-							map[entry] = set;
-							set = transfer(set, gen[entry], kill[entry]);
+							map[entry->id] = set;
+							set = transfer(set, gen[entry->id], kill[entry->id]);
 						}
 						break;
 				}
@@ -12,10 +12,14 @@ namespace Analysis {
 	DominanceFrontiers::DominanceFrontiers(const DominatorTree &tree)
 	{
 		for(const FlowGraph::Block *block : tree.blocks()) {
-			if(block->pred.size() < 2)
+			if(block->pred.size() < 2 || !tree.idom(block))
 				continue;
 
 			for(const FlowGraph::Block *runner : block->pred) {
+				// Unreachable predecessors have no place in the dominator tree
+				if(!tree.idom(runner))
+					continue;
+
 				while(runner != tree.idom(block)) {
 					mFrontiers[runner].insert(block);
 					runner = tree.idom(runner);
@@ -16,13 +16,20 @@ namespace Analysis {
 		BlockSort sort(flowGraph);
 		mBlocks = sort.sorted();
 
-		mIDoms[mBlocks[0]] = mBlocks[0];
+		// Unreachable blocks sort ahead of the start block, so the start block must be
+		// identified explicitly.  Unreachable blocks are left without a dominator
+		const FlowGraph::Block *start = flowGraph.start();
+		mIDoms[start] = start;
 
 		bool changed;
 		do {
 			changed = false;
-			for(unsigned int i=1; i<mBlocks.size(); i++) {
+			for(unsigned int i=0; i<mBlocks.size(); i++) {
 				const FlowGraph::Block *block = mBlocks[i];
+				if(block == start) {
+					continue;
+				}
+
 				const FlowGraph::Block *newDom = 0;
 				for(const FlowGraph::Block *pred : block->pred) {
 					if(mIDoms[pred] == 0) {
@@ -131,4 +131,54 @@ namespace Analysis {
 			linkBlock(block, newEntry);
 		}
 	}
+
+	/*!
+	 * \brief Check whether an edge is critical
+	 *
+	 * A critical edge leads from a block with several successors to a block with several
+	 * predecessors.  Code cannot be placed on such an edge without affecting other paths,
+	 * unless the edge is first split.
+	 * \param pred Source block of edge
+	 * \param succ Destination block of edge
+	 * \return True if the edge is critical
+	 */
+	bool FlowGraph::isCriticalEdge(const Block *pred, const Block *succ)
+	{
+		return pred->succ.size() > 1 && succ->pred.size() > 1;
+	}
+
+	/*!
+	 * \brief Split a flow graph edge by placing a new block on it
+	 *
+	 * The new block is placed directly after the conditional jump which ends the source
+	 * block, and jumps to the destination block.  This modifies the procedure, so the flow
+	 * graph must be rebuilt afterwards.  Since the new block follows the conditional jump,
+	 * the source block's entry list no longer ends with it, so callers splitting several
+	 * edges out of one block must find its conditional jump before splitting any of them.
+	 * \param procedure Procedure containing the blocks
+	 * \param cJump Conditional jump which ends the source block of the edge
+	 * \param succ Destination block of edge
+	 * \return Jump which ends the new block.  Entries inserted before it are executed only
+	 *         along the split edge
+	 */
+	IR::Entry *FlowGraph::splitEdge(IR::Procedure &procedure, IR::EntryCJump *cJump, const Block *succ)
+	{
+		IR::EntryLabel *target = (IR::EntryLabel*)procedure.entries().entry(succ->entries.front());
+
+		const IR::Entry *position = cJump->next;
+		IR::EntryLabel *label = procedure.newLabel();
+		IR::EntryJump *jump = procedure.newEntry<IR::EntryJump>(target);
+		procedure.entries().insert(position, label);
+		procedure.entries().insert(position, jump);
+
+		// Redirect the conditional jump through the new block
+		if(cJump->trueTarget == target) {
+			cJump->trueTarget = label;
+		}
+		if(cJump->falseTarget == target) {
+			cJump->falseTarget = label;
+		}
+
+		return jump;
+	}
 }
\ No newline at end of file
@@ -37,6 +37,9 @@ namespace Analysis {
 
 		void replace(const IR::Entry *oldEntry, const IR::Entry *newEntry);
 
+		static bool isCriticalEdge(const Block *pred, const Block *succ);
+		static IR::Entry *splitEdge(IR::Procedure &procedure, IR::EntryCJump *cJump, const Block *succ);
+
 		Block *start() const { return mStart; } //!< Start block
 		Block *end() const { return mEnd; } //!< End block
 
@@ -0,0 +1,83 @@
+#include "Analysis/InductionVariables.h"
+
+namespace Analysis {
+	/*!
+	 * \brief Constructor
+	 * \param loop Loop to analyze
+	 */
+	InductionVariables::InductionVariables(const Loops::Loop &loop)
+	{
+		// Collect every assignment made inside the loop
+		std::map<const IR::Symbol*, std::vector<const IR::Entry*>> defs;
+		for(const FlowGraph::Block *block : loop.blocks) {
+			for(const IR::Entry *entry : block->entries) {
+				for(const IR::Symbol *symbol : entry->defOperands()) {
+					defs[symbol].push_back(entry);
+				}
+			}
+		}
+
+		// A basic induction variable is incremented or decremented by a constant
+		for(auto &def : defs) {
+			if(def.second.size() != 1) {
+				continue;
+			}
+
+			const IR::EntryThreeAddr *threeAddr = (const IR::EntryThreeAddr*)def.second.front();
+			if((threeAddr->type == IR::Entry::Type::Add || threeAddr->type == IR::Entry::Type::Subtract) && threeAddr->rhs1 == def.first && !threeAddr->rhs2) {
+				BasicVariable &basic = mBasicVariables[def.first];
+				basic.symbol = def.first;
+				basic.increment = threeAddr;
+				basic.step = (threeAddr->type == IR::Entry::Type::Add) ? threeAddr->imm : -threeAddr->imm;
+			}
+		}
+
+		// A derived induction variable is a linear function of a basic induction variable
+		for(auto &def : defs) {
+			if(def.second.size() != 1 || mBasicVariables.find(def.first) != mBasicVariables.end()) {
+				continue;
+			}
+
+			// Only read the entry's operands once its type shows it to be a three-address entry
+			const IR::EntryThreeAddr *threeAddr = (const IR::EntryThreeAddr*)def.second.front();
+			DerivedVariable derived;
+			switch(threeAddr->type) {
+				case IR::Entry::Type::Move:
+					derived.scale = 1;
+					derived.offset = 0;
+					break;
+
+				case IR::Entry::Type::Add:
+					derived.scale = 1;
+					derived.offset = threeAddr->imm;
+					break;
+
+				case IR::Entry::Type::Subtract:
+					derived.scale = 1;
+					derived.offset = -threeAddr->imm;
+					break;
+
+				case IR::Entry::Type::Mult:
+					derived.scale = threeAddr->imm;
+					derived.offset = 0;
+					break;
+
+				default:
+					continue;
+			}
+
+			if(threeAddr->rhs2 || !threeAddr->rhs1) {
+				continue;
+			}
+
+			auto itBasic = mBasicVariables.find(threeAddr->rhs1);
+			if(itBasic == mBasicVariables.end()) {
+				continue;
+			}
+
+			derived.entry = threeAddr;
+			derived.basic = &itBasic->second;
+			mDerivedVariables.push_back(derived);
+		}
+	}
+}
\ No newline at end of file
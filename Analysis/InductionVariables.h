@@ -0,0 +1,52 @@
+#ifndef ANALYSIS_INDUCTION_VARIABLES_H
+#define ANALYSIS_INDUCTION_VARIABLES_H
+
+#include "Analysis/Loops.h"
+
+#include "IR/Entry.h"
+#include "IR/Symbol.h"
+
+#include <map>
+#include <vector>
+
+namespace Analysis {
+	/*!
+	 * \brief Find the induction variables of a loop
+	 *
+	 * A basic induction variable is one whose only assignment inside the loop adds a constant
+	 * to itself.  A derived induction variable is one whose only assignment inside the loop is
+	 * a linear function (scale * basic + offset) of a basic induction variable, and so also
+	 * changes by a constant amount on each iteration.
+	 */
+	class InductionVariables {
+	public:
+		/*!
+		 * \brief A basic induction variable
+		 */
+		struct BasicVariable {
+			const IR::Symbol *symbol; //!< Induction variable
+			const IR::Entry *increment; //!< The variable's only assignment in the loop
+			int step; //!< Amount added to the variable by the increment
+		};
+
+		/*!
+		 * \brief A derived induction variable
+		 */
+		struct DerivedVariable {
+			const IR::Entry *entry; //!< The variable's only assignment in the loop
+			const BasicVariable *basic; //!< Basic variable it is derived from
+			int scale; //!< Multiplier applied to the basic variable
+			int offset; //!< Constant added after scaling
+		};
+
+		InductionVariables(const Loops::Loop &loop);
+
+		const std::map<const IR::Symbol*, BasicVariable> &basicVariables() const { return mBasicVariables; } //!< Basic induction variables, by symbol
+		const std::vector<DerivedVariable> &derivedVariables() const { return mDerivedVariables; } //!< Derived induction variables
+
+	private:
+		std::map<const IR::Symbol*, BasicVariable> mBasicVariables; //!< Basic induction variables
+		std::vector<DerivedVariable> mDerivedVariables; //!< Derived induction variables
+	};
+}
+#endif
\ No newline at end of file
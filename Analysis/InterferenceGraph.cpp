@@ -7,17 +7,22 @@
 
 namespace Analysis {
 
-std::set<const IR::Symbol*> emptySymbolSet; //!< Empty set, to use when a symbol lookup fails
-
 /*!
  * \brief Constructor
  * \param procedure Procedure to analyze
  */
 InterferenceGraph::InterferenceGraph(const IR::Procedure &procedure, const LiveVariables &liveVariables)
 {
+	size_t numSymbols = procedure.numSymbolIds();
+	mMatrix.resize(numSymbols * (numSymbols + 1) / 2);
+	mAdjacency.resize(numSymbols);
+	mDegrees.resize(numSymbols);
+	mRemoved.resize(numSymbols);
+	mAliases.resize(numSymbols);
+
 	// Collect the set of all symbols in the procedure
-	for(const std::unique_ptr<IR::Symbol> &symbol : procedure.symbols()) {
-		addSymbol(symbol.get());
+	for(const IR::Symbol *symbol : procedure.symbols()) {
+		mSymbols.push_back(symbol);
 	}
 
 	// Walk through the procedure.  For each entry, add graph edges between all variables live at that point
@@ -34,19 +39,37 @@ InterferenceGraph::InterferenceGraph(const IR::Procedure &procedure, const LiveV
 				addEdge(symbol1, symbol2);
 			}
 		}
+
+		// A definition overwrites its register even if the value is never used, so it must
+		// not share a register with anything live past the entry
+		for(const IR::Symbol *def : entry->defOperands()) {
+			for(const IR::Symbol *symbol : symbols) {
+				addEdge(def, symbol);
+			}
+		}
+
+		// Record register-to-register moves, which are candidates for coalescing
+		if(entry->type == IR::Entry::Type::Move) {
+			const IR::EntryThreeAddr *threeAddr = (const IR::EntryThreeAddr*)entry;
+			if(threeAddr->rhs1 && threeAddr->rhs1 != threeAddr->lhs) {
+				mMoves.push_back(Move(threeAddr->lhs, threeAddr->rhs1));
+			}
+		}
 	}
 }
 
 /*!
- * \brief Add a symbol to the graph
- * \param symbol Symbol to add
+ * \brief Compute the position of an edge in the triangular bit matrix
+ * \param id1 First symbol id
+ * \param id2 Second symbol id
+ * \return Bit index
  */
-void InterferenceGraph::addSymbol(const IR::Symbol *symbol)
+size_t InterferenceGraph::matrixIndex(int id1, int id2) const
 {
-	if(mGraph.find(symbol) == mGraph.end()) {
-		mGraph[symbol] = emptySymbolSet;
-		mSymbols.insert(symbol);
-	}
+	size_t low = (id1 < id2) ? id1 : id2;
+	size_t high = (id1 < id2) ? id2 : id1;
+
+	return high * (high + 1) / 2 + low;
 }
 
 /*!
@@ -56,63 +79,134 @@ void InterferenceGraph::addSymbol(const IR::Symbol *symbol)
  */
 void InterferenceGraph::addEdge(const IR::Symbol *symbol1, const IR::Symbol *symbol2)
 {
-	if(symbol1 != symbol2) {
-		// Add symbol1 -> symbol2
-		auto it = mGraph.find(symbol1);
-		if(it != mGraph.end()) {
-			it->second.insert(symbol2);
-		}
+	if(symbol1 == symbol2) {
+		return;
+	}
 
-		// Add symbol2 -> symbol1
-		it = mGraph.find(symbol2);
-		if(it != mGraph.end()) {
-			it->second.insert(symbol1);
-		}
+	size_t index = matrixIndex(symbol1->id, symbol2->id);
+	if(mMatrix[index]) {
+		return;
+	}
+
+	mMatrix[index] = true;
+	mAdjacency[symbol1->id].push_back(symbol2);
+	mAdjacency[symbol2->id].push_back(symbol1);
+
+	if(!mRemoved[symbol2->id]) {
+		mDegrees[symbol1->id]++;
+	}
+
+	if(!mRemoved[symbol1->id]) {
+		mDegrees[symbol2->id]++;
 	}
 }
 
 /*!
- * \brief Remove a symbol from the graph
+ * \brief Remove a symbol from the graph, decrementing the degree of each of its neighbors.
+ *        The symbol's edges remain available through interferences().
  * \param symbol Symbol to remove
  */
 void InterferenceGraph::removeSymbol(const IR::Symbol *symbol)
 {
-	// Remove the symbol from the graph and symbol list
-	mGraph.erase(mGraph.find(symbol));
-	mSymbols.erase(mSymbols.find(symbol));
-
-	// Loop through the rest of the symbol sets, removing the symbol from any which contain it
-	for(auto &edge : mGraph) {
-		std::set<const IR::Symbol*> &set = edge.second;
-		if(set.find(symbol) != set.end()) {
-			set.erase(set.find(symbol));
+	if(mRemoved[symbol->id]) {
+		return;
+	}
+
+	mRemoved[symbol->id] = true;
+	for(const IR::Symbol *neighbor : mAdjacency[symbol->id]) {
+		mDegrees[neighbor->id]--;
+	}
+}
+
+/*!
+ * \brief Merge a symbol into another one.  The symbol is removed from the graph, and all
+ *        of its remaining edges are transferred to the target.
+ * \param symbol Symbol to merge
+ * \param into Symbol to merge into
+ */
+void InterferenceGraph::coalesce(const IR::Symbol *symbol, const IR::Symbol *into)
+{
+	for(const IR::Symbol *neighbor : mAdjacency[symbol->id]) {
+		if(!mRemoved[neighbor->id]) {
+			addEdge(into, neighbor);
 		}
 	}
+
+	removeSymbol(symbol);
+	mAliases[symbol->id] = into;
+}
+
+/*!
+ * \brief Check whether two symbols interfere
+ * \param symbol1 First symbol
+ * \param symbol2 Second symbol
+ * \return True if an edge exists between the symbols
+ */
+bool InterferenceGraph::interferes(const IR::Symbol *symbol1, const IR::Symbol *symbol2) const
+{
+	return symbol1 != symbol2 && mMatrix[matrixIndex(symbol1->id, symbol2->id)];
 }
 
 /*!
- * \brief Return the set of symbols which interfere with a given symbol
+ * \brief Return the set of symbols which interfere with a given symbol, including removed ones
  * \param symbol Symbol to examine
- * \return Set of interfering symbols
+ * \return Interfering symbols
  */
-const std::set<const IR::Symbol*> &InterferenceGraph::interferences(const IR::Symbol *symbol)
+const std::vector<const IR::Symbol*> &InterferenceGraph::interferences(const IR::Symbol *symbol) const
 {
-	auto it = mGraph.find(symbol);
+	return mAdjacency[symbol->id];
+}
 
-	if(it != mGraph.end()) {
-		return it->second;
-	} else {
-		return emptySymbolSet;
-	}
+/*!
+ * \brief Return the number of neighbors of a symbol which have not been removed
+ * \param symbol Symbol to examine
+ * \return Degree
+ */
+int InterferenceGraph::degree(const IR::Symbol *symbol) const
+{
+	return mDegrees[symbol->id];
 }
 
 /*!
- * \brief Return the set of symbols in use in the graph
+ * \brief Check whether a symbol has been removed from the graph
+ * \param symbol Symbol to examine
+ * \return True if removed
+ */
+bool InterferenceGraph::removed(const IR::Symbol *symbol) const
+{
+	return mRemoved[symbol->id];
+}
+
+/*!
+ * \brief Return the set of symbols in the graph
  * \return Symbols
  */
-const std::set<const IR::Symbol*> &InterferenceGraph::symbols()
+const std::vector<const IR::Symbol*> &InterferenceGraph::symbols() const
 {
 	return mSymbols;
 }
 
+/*!
+ * \brief Return the list of moves between symbols in the procedure
+ * \return Moves
+ */
+const std::vector<InterferenceGraph::Move> &InterferenceGraph::moves() const
+{
+	return mMoves;
+}
+
+/*!
+ * \brief Find the symbol which currently represents a symbol, following any coalescing
+ * \param symbol Symbol to look up
+ * \return Representative symbol
+ */
+const IR::Symbol *InterferenceGraph::alias(const IR::Symbol *symbol) const
+{
+	while(mAliases[symbol->id]) {
+		symbol = mAliases[symbol->id];
+	}
+
+	return symbol;
+}
+
 }
\ No newline at end of file
@@ -6,7 +6,8 @@
 
 #include "Analysis/LiveVariables.h"
 
-#include <map>
+#include <vector>
+#include <utility>
 
 namespace Analysis {
 /*!
@@ -16,21 +17,46 @@ namespace Analysis {
  * are ever live at the same time in a procedure.  An edge between two symbols
  * means they are simultaneously live at some point in the procedure, the absence
  * of an edge means they are not
+ *
+ * Symbols are indexed by their id.  Edge membership is kept in a triangular bit
+ * matrix, and each symbol additionally has an adjacency list for iterating over
+ * its neighbors.  Removing a symbol leaves its edges in place, but decrements the
+ * degree of each of its remaining neighbors, so that the graph can be simplified
+ * during register allocation without being copied.
+ *
+ * The graph also records the pairs of symbols which are related by a move, so that
+ * the register allocator can coalesce them into a single node.  A coalesced symbol
+ * is removed from the graph, its edges are transferred to the node it was merged
+ * into, and it is thereafter represented by that node's alias.
  */
 class InterferenceGraph {
 public:
 	InterferenceGraph(const IR::Procedure &procedure, const LiveVariables &liveVariables);
 
-	void addSymbol(const IR::Symbol *symbol);
 	void addEdge(const IR::Symbol *symbol1, const IR::Symbol *symbol2);
 	void removeSymbol(const IR::Symbol *symbol);
+	void coalesce(const IR::Symbol *symbol, const IR::Symbol *into);
 
-	const std::set<const IR::Symbol*> &interferences(const IR::Symbol *symbol);
-	const std::set<const IR::Symbol*> &symbols();
+	bool interferes(const IR::Symbol *symbol1, const IR::Symbol *symbol2) const;
+	const std::vector<const IR::Symbol*> &interferences(const IR::Symbol *symbol) const;
+	int degree(const IR::Symbol *symbol) const;
+	bool removed(const IR::Symbol *symbol) const;
+	const std::vector<const IR::Symbol*> &symbols() const;
+
+	typedef std::pair<const IR::Symbol*, const IR::Symbol*> Move; //!< Destination and source of a move
+	const std::vector<Move> &moves() const;
+	const IR::Symbol *alias(const IR::Symbol *symbol) const;
 
 private:
-	std::map<const IR::Symbol*, std::set<const IR::Symbol*>> mGraph; //!< Map of graph edges
-	std::set<const IR::Symbol*> mSymbols; //!< Set of symbols in the graph
+	size_t matrixIndex(int id1, int id2) const;
+
+	std::vector<const IR::Symbol*> mSymbols; //!< Symbols in the graph
+	std::vector<bool> mMatrix; //!< Triangular edge bit matrix, indexed by symbol id pair
+	std::vector<std::vector<const IR::Symbol*>> mAdjacency; //!< Neighbors of each symbol, indexed by symbol id
+	std::vector<int> mDegrees; //!< Number of neighbors not yet removed, indexed by symbol id
+	std::vector<bool> mRemoved; //!< Whether each symbol has been removed, indexed by symbol id
+	std::vector<Move> mMoves; //!< Move-related symbol pairs
+	std::vector<const IR::Symbol*> mAliases; //!< Symbol each symbol was coalesced into, indexed by symbol id
 };
 
 }
@@ -23,26 +23,25 @@ namespace Analysis {
 
 		// Construct the set of all variables in the procedure
 		std::set<const IR::Symbol*> all;
-		for(const std::unique_ptr<IR::Symbol> &symbol : mProcedure.symbols()) {
-			all.insert(symbol.get());
+		for(const IR::Symbol *symbol : mProcedure.symbols()) {
+			all.insert(symbol);
 		}
 
 		// Construct gen/kill sets for data flow analysis.
-		std::map<const IR::Entry*, std::set<const IR::Symbol*>> gen;
-		std::map<const IR::Entry*, std::set<const IR::Symbol*>> kill;
+		std::vector<std::set<const IR::Symbol*>> gen(mProcedure.numEntryIds());
+		std::vector<std::set<const IR::Symbol*>> kill(mProcedure.numEntryIds());
 		for(const IR::Entry *entry : mProcedure.entries()) {
-			for(const IR::Symbol *symbol : all) {
-				std::set<const IR::Symbol*> &g = gen[entry];
-				if(entry->uses(symbol)) {
-					// An entry which uses a symbol adds that symbol to the set of live symbols
-					g.insert(symbol);
-				}
+			std::set<const IR::Symbol*> &g = gen[entry->id];
+			for(const IR::Symbol *symbol : entry->useOperands()) {
+				// An entry which uses a symbol adds that symbol to the set of live symbols
+				g.insert(symbol);
+			}
 
-				const IR::Symbol *assign = entry->assign();
-				if(assign && g.find(assign) == g.end()) {
+			for(const IR::Symbol *symbol : entry->defOperands()) {
+				if(g.find(symbol) == g.end()) {
 					// An entry which assigns to a symbol and does not use it kills that symbol
 					// from the live symbol set
-					kill[entry].insert(assign);
+					kill[entry->id].insert(symbol);
 				}
 			}
 		}
@@ -62,12 +61,11 @@ namespace Analysis {
 	 */
 	const std::set<const IR::Symbol*> &LiveVariables::variables(const IR::Entry *entry) const
 	{
-		auto it = mMap.find(entry);
-		if (it == mMap.end()) {
+		if (entry->id >= (int)mMap.size()) {
 			return emptySymbolSet;
 		}
 		else {
-			return it->second;
+			return mMap[entry->id];
 		}
 	}
 
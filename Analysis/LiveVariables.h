@@ -8,7 +8,7 @@
 #include "Analysis/FlowGraph.h"
 
 #include <set>
-#include <map>
+#include <vector>
 #include <iostream>
 
 namespace Analysis {
@@ -28,7 +28,7 @@ namespace Analysis {
 		void print(std::ostream &o) const;
 
 	private:
-		std::map<const IR::Entry*, std::set<const IR::Symbol*>> mMap; //!< Map of live ranges
+		std::vector<std::set<const IR::Symbol*>> mMap; //!< Live symbols, indexed by entry id
 		const IR::Procedure &mProcedure; //!< Procedure under analysis
 	};
 }
@@ -33,8 +33,8 @@ namespace Analysis {
 		}
 
 		// Construct gen and kill sets for data flow analysis
-		std::map<const IR::Entry*, std::set<const IR::Entry*>> gen;
-		std::map<const IR::Entry*, std::set<const IR::Entry*>> kill;
+		std::vector<std::set<const IR::Entry*>> gen(mProcedure.numEntryIds());
+		std::vector<std::set<const IR::Entry*>> kill(mProcedure.numEntryIds());
 		for(const IR::Entry *entry : mProcedure.entries()) {
 			if(!entry->assign()) {
 				continue;
@@ -42,13 +42,13 @@ namespace Analysis {
 
 			if(entry->assign()) {
 				// Assignment to a variable adds that variable to the set of reaching definitions
-				gen[entry].insert(entry);
+				gen[entry->id].insert(entry);
 			}
 
 			// An assignment also kills any other assignment to the same variable
 			for(const IR::Entry *def : allDefs) {
 				if(def->assign() == entry->assign() && def != entry) {
-					kill[entry].insert(def);
+					kill[entry->id].insert(def);
 				}
 			}
 		}
@@ -66,9 +66,8 @@ namespace Analysis {
 	 */
 	const std::set<const IR::Entry*> &ReachingDefs::defs(const IR::Entry *entry) const
 	{
-		auto it = mDefs.find(entry);
-		if(it != mDefs.end()) {
-			return it->second;
+		if(entry->id < (int)mDefs.size()) {
+			return mDefs[entry->id];
 		} else {
 			return emptyEntrySet;
 		}
@@ -102,12 +101,14 @@ namespace Analysis {
 	{
 		// Assign the reaching definitions from the old entry to the new one, and remove
 		// the old one from the set
-		mDefs[newEntry] = mDefs[oldEntry];
-		mDefs.erase(oldEntry);
+		if(newEntry->id >= (int)mDefs.size()) {
+			mDefs.resize(newEntry->id + 1);
+		}
+		mDefs[newEntry->id] = std::move(mDefs[oldEntry->id]);
+		mDefs[oldEntry->id].clear();
 
 		// Search through all reaching definitions, and replace the old entry with the new one
-		for(auto &def : mDefs) {
-			std::set<const IR::Entry*> &set = def.second;
+		for(std::set<const IR::Entry*> &set : mDefs) {
 			auto setIt = set.find(oldEntry);
 			if(setIt != set.end()) {
 				set.erase(setIt);
@@ -123,14 +124,15 @@ namespace Analysis {
 	void ReachingDefs::remove(const IR::Entry *entry)
 	{
 		// Remove all references to the given entry
-		for(auto &def : mDefs) {
-			std::set<const IR::Entry*> &set = def.second;
+		for(std::set<const IR::Entry*> &set : mDefs) {
 			auto setIt = set.find(entry);
 			if(setIt != set.end()) {
 				set.erase(setIt);
 			}
 		}
-		mDefs.erase(entry);
+		if(entry->id < (int)mDefs.size()) {
+			mDefs[entry->id].clear();
+		}
 	}
 
 	/*!
@@ -35,7 +35,7 @@ namespace Analysis {
 
 	private:
 		const FlowGraph &mFlowGraph; //<! Flow graph being analyzed
-		std::map<const IR::Entry*, std::set<const IR::Entry*>> mDefs; //!< List of definitions
+		std::vector<std::set<const IR::Entry*>> mDefs; //!< List of definitions, indexed by entry id
 		const IR::Procedure &mProcedure; //!< Procedure being analyzed
 	};
 }
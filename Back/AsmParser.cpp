@@ -50,7 +50,7 @@ std::unique_ptr<VM::Program> AsmParser::parseProgram()
 	while(matchLiteral("defproc") || matchLiteral("defdata")) {
 		consume();
 
-		std::string name = next().text;
+		std::string name(next().text);
 		expect(AsmTokenizer::TypeIdentifier);
 
 		program->symbols[name] = (int)program->instructions.size();
@@ -88,18 +88,18 @@ void AsmParser::parseProcedure(VM::Program &program)
 		} else if(matchLiteral("string")) {
 			// Parse a string constant
 			consume();
-			std::string value = next().text;
+			std::string_view value = next().text;
 			expect(AsmTokenizer::TypeString);
 			int newSize = offset + (int)value.size() + 1;
 			if(newSize % 4 > 0) {
 				newSize += 4 - (newSize % 4);
 			}
 			program.instructions.resize(newSize);
-			std::memcpy(&program.instructions[offset], value.c_str(), value.size());
+			std::memcpy(&program.instructions[offset], value.data(), value.size());
 			program.instructions[offset + value.size()] = '\0';
 		} else if(matchLiteral("addr")) {
 			consume();
-			std::string name = next().text;
+			std::string name(next().text);
 			expect(AsmTokenizer::TypeIdentifier);
 			program.instructions.resize(offset + 4);
 			int value = 0;
@@ -111,7 +111,7 @@ void AsmParser::parseProcedure(VM::Program &program)
 			program.relocations.push_back(relocation);
 		} else {
 			// Parse a literal
-			std::string text = next().text;
+			std::string text(next().text);
 			consume();
 			expectLiteral(":");
 			labels[text] = offset;
@@ -223,8 +223,7 @@ bool AsmParser::parseIndInstr(VM::Instruction &instr)
 				expectLiteral(",");
 				if(matchLiteral("#")) {
 					consume();
-					int imm = std::atoi(next().text.c_str());
-					expect(AsmTokenizer::TypeNumber);
+					int imm = parseImm();
 					expectLiteral("]");
 					instr = VM::Instruction::makeTwoAddr(op.value1, lhs, rhs1, imm);
 				} else {
@@ -233,8 +232,7 @@ bool AsmParser::parseIndInstr(VM::Instruction &instr)
 					if(matchLiteral(",")) {
 						consume();
 						expectLiteral("#");
-						imm = std::atoi(next().text.c_str());
-						expect(AsmTokenizer::TypeNumber);
+						imm = parseImm();
 					}
 					expectLiteral("]");
 					instr = VM::Instruction::makeThreeAddr(op.value2, lhs, rhs1, rhs2, imm);
@@ -271,8 +269,7 @@ bool AsmParser::parseImmInstr(VM::Instruction &instr)
 
 			if(matchLiteral("#")) {
 				consume();
-				int imm = std::atoi(next().text.c_str());
-				expect(AsmTokenizer::TypeNumber);
+				int imm = parseImm();
 				instr = VM::Instruction::makeTwoAddr(op.value1, lhs, rhs1, imm);
 			} else {
 				int rhs2 = parseReg();
@@ -294,8 +291,7 @@ bool AsmParser::parseImmInstr(VM::Instruction &instr)
 
 			if(matchLiteral("#")) {
 				consume();
-				int imm = std::atoi(next().text.c_str());
-				expect(AsmTokenizer::TypeNumber);
+				int imm = parseImm();
 				instr = VM::Instruction::makeOneAddr(op.value1, lhs, imm);
 			} else {
 				int rhs = parseReg();
@@ -366,7 +362,7 @@ bool AsmParser::parseLabelRef(VM::Instruction &instr, int offset, std::map<int,
 {
 	if(next().text == "jmp") {
 		consume();
-		std::string target = next().text;
+		std::string target(next().text);
 		expect(AsmTokenizer::TypeIdentifier);
 		instr = VM::Instruction::makeTwoAddr(VM::TwoAddrAddImm, VM::RegPC, VM::RegPC, 0);
 		labelRefs[offset] = target;
@@ -377,7 +373,7 @@ bool AsmParser::parseLabelRef(VM::Instruction &instr, int offset, std::map<int,
 		consume();
 		int pred = parseReg();
 		expectLiteral(",");
-		std::string target = next().text;
+		std::string target(next().text);
 		expect(AsmTokenizer::TypeIdentifier);
 		instr = VM::Instruction::makeThreeAddr(VM::ThreeAddrAddCond, VM::RegPC, pred, VM::RegPC, 0);
 		labelRefs[offset] = target;
@@ -388,7 +384,7 @@ bool AsmParser::parseLabelRef(VM::Instruction &instr, int offset, std::map<int,
 		consume();
 		int pred = parseReg();
 		expectLiteral(",");
-		std::string target = next().text;
+		std::string target(next().text);
 		expect(AsmTokenizer::TypeIdentifier);
 		instr = VM::Instruction::makeThreeAddr(VM::ThreeAddrAddNCond, VM::RegPC, pred, VM::RegPC, 0);
 		labelRefs[offset] = target;
@@ -408,7 +404,7 @@ bool AsmParser::parseExternalRef(VM::Instruction &instr, int offset, std::vector
 {
 	if(next().text == "call") {
 		consume();
-		std::string target = next().text;
+		std::string target(next().text);
 		expect(AsmTokenizer::TypeIdentifier);
 		instr = VM::Instruction::makeOneAddr(VM::OneAddrCall, VM::RegPC, 0);
 		VM::Program::Relocation relocation;
@@ -423,7 +419,7 @@ bool AsmParser::parseExternalRef(VM::Instruction &instr, int offset, std::vector
 		consume();
 		int lhs = parseReg();
 		expectLiteral(",");
-		std::string target = next().text;
+		std::string target(next().text);
 		expect(AsmTokenizer::TypeIdentifier);
 		instr = VM::Instruction::makeTwoAddr(VM::TwoAddrAddImm, lhs, VM::RegPC, 0);
 		VM::Program::Relocation relocation;
@@ -445,10 +441,10 @@ int AsmParser::parseReg()
 {
 	NameInt regs[] = { { "sp", 13 }, { "lr", 14 }, { "pc", 15 } };
 
-	const std::string &text = next().text;
+	std::string_view text = next().text;
 
 	if(text[0] == 'r') {
-		std::string num = text.substr(1);
+		std::string num(text.substr(1));
 		consume();
 		return std::atoi(num.c_str());
 	}
@@ -464,4 +460,22 @@ int AsmParser::parseReg()
 	return -1;
 }
 
+/*!
+ * \brief Parse an immediate value, following the '#' prefix
+ * \return Value
+ */
+int AsmParser::parseImm()
+{
+	bool negative = false;
+	if(matchLiteral("-")) {
+		consume();
+		negative = true;
+	}
+
+	int imm = std::atoi(std::string(next().text).c_str());
+	expect(AsmTokenizer::TypeNumber);
+
+	return negative ? -imm : imm;
+}
+
 }
\ No newline at end of file
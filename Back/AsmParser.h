@@ -35,6 +35,7 @@ private:
 	bool parseExternalRef(VM::Instruction &instr, int offset, std::vector<VM::Program::Relocation> &relocations);
 
 	int parseReg();
+	int parseImm();
 };
 }
 #endif
\ No newline at end of file
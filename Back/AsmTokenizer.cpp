@@ -1,13 +1,15 @@
 #include "Back/AsmTokenizer.h"
 
-#include <cctype>
 #include <sstream>
 
-static std::vector<char> whitespace = { ' ', '\t', '\r', '\n' };
+static constexpr Input::CharacterSet whitespace = { " \t\r\n" };
+static constexpr Input::CharacterSet identifierStart = { Input::CharacterSet::Letters, "_." };
+static constexpr Input::CharacterSet identifierCharacters = { Input::CharacterSet::Letters, Input::CharacterSet::Digits, "_.$" };
+static constexpr Input::CharacterSet digits = { Input::CharacterSet::Digits };
 
-static std::vector<std::string> literals = { "[", "]", ",", ":", "#", "{", "}", "-" };
+static constexpr Input::LiteralTable literals = { "[", "]", ",", ":", "#", "{", "}", "-" };
 
-static std::vector<std::string> keywords = { "jmp", "add", "sub", "mov", "mult", "div", "mod", "ldr", "str",
+static constexpr Input::LiteralTable keywords = { "jmp", "add", "sub", "mov", "mult", "div", "mod", "ldr", "str",
 							"new", "cmov", "cadd", "ncmov", "ncadd", "equ",
 							"neq", "lt", "lte", "gt", "gte", "or", "and", "call", "calli",
 							"ldm", "stm", "defproc", "defdata", "string", "lea", "ldb", "stb", "addr",
@@ -45,25 +47,12 @@ AsmTokenizer::Token AsmTokenizer::getNext()
 	}
 
 	// If no literals matched, see if an identifier can be constructed
-	if(std::isalpha(buffer()[0]) || buffer()[0] == '_' || buffer()[0] == '.') {
-		size_t len = 0;
-		while(std::isalnum(buffer()[len]) || buffer()[len] == '_' || buffer()[len] == '.' || buffer()[len] == '$') {
-			len++;
-			if(!fillBuffer(len + 1)) {
-				break;
-			}
-		}
-
-		TokenType type = TypeIdentifier;
-		std::string string = buffer().substr(0, len);
+	if(identifierStart.contains(buffer()[0])) {
+		size_t len = spanCharacters(identifierCharacters, 1);
+		std::string_view string = buffer().substr(0, len);
 
 		// Check if the string is a keyword
-		for(std::string &keyword : keywords) {
-			if(string == keyword) {
-				type = TypeLiteral;
-				break;
-			}
-		}
+		TokenType type = keywords.contains(string) ? TypeLiteral : TypeIdentifier;
 
 		// Construct a token out of the characters found
 		next = createToken(type, string);
@@ -72,14 +61,8 @@ AsmTokenizer::Token AsmTokenizer::getNext()
 	}
 
 	// If an identifier couldn't be found, check for a number
-	if(std::isdigit(buffer()[0])) {
-		size_t len = 0;
-		while(std::isdigit(buffer()[len])) {
-			len++;
-			if(!fillBuffer(len + 1)) {
-				break;
-			}
-		}
+	if(digits.contains(buffer()[0])) {
+		size_t len = spanCharacters(digits, 0);
 
 		// Construct a token out of the characters found
 		next = createToken(TypeNumber, buffer().substr(0, len));
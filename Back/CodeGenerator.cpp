@@ -9,6 +9,10 @@
 
 #include "Back/RegisterAllocator.h"
 
+#include "Analysis/FlowGraph.h"
+#include "Analysis/DominatorTree.h"
+#include "Analysis/Loops.h"
+
 #include "Util/Timer.h"
 #include "Util/Log.h"
 
@@ -21,209 +25,354 @@ namespace Back {
 	/*!
 	 * \brief Generate code for an IR program
 	 * \param irProgram IR program input
-	 * \return Final code for the program
+	 * \param code Machine code emitter to output to
+	 * \param allocatorMode Register allocation strategy
 	 */
-	void CodeGenerator::generate(IR::Program &irProgram, std::ostream &stream)
+	void CodeGenerator::generate(IR::Program &irProgram, MachineCode &code, RegisterAllocator::Mode allocatorMode)
 	{
 		// Iterate through the procedures, generating each in turn
 		for(std::unique_ptr<IR::Procedure> &irProcedure : irProgram.procedures()) {
 			// Generate code for the procedure
-			generateProcedure(*irProcedure, stream);
+			generateProcedure(*irProcedure, code, allocatorMode);
 		}
 
 		// Iterate through the data sections, generating each in turn
 		for(std::unique_ptr<IR::Data> &irData : irProgram.data()) {
 			// Generate code for the data
-			generateData(*irData, stream);
-			stream << std::endl;
+			generateData(*irData, code);
+		}
+	}
+
+	/*!
+	 * \brief Generate an arithmetic instruction, in register or immediate form
+	 * \param threeAddr Entry to generate code for
+	 * \param twoAddrType Two-address instruction type used for the immediate form
+	 * \param threeAddrType Three-address instruction type used for the register form
+	 * \param regMap Register assignments
+	 * \param code Machine code emitter to output to
+	 */
+	void CodeGenerator::generateArith(IR::EntryThreeAddr *threeAddr, int twoAddrType, int threeAddrType, RegisterMap &regMap, MachineCode &code)
+	{
+		if(threeAddr->rhs2) {
+			code.emit(VM::Instruction::makeThreeAddr(threeAddrType, regMap[threeAddr->lhs], regMap[threeAddr->rhs1], regMap[threeAddr->rhs2], 0));
+		} else {
+			code.emit(VM::Instruction::makeTwoAddr(twoAddrType, regMap[threeAddr->lhs], regMap[threeAddr->rhs1], threeAddr->imm));
+		}
+	}
+
+	/*!
+	 * \brief Generate a register to register move
+	 * \param lhs Destination register
+	 * \param rhs Source register
+	 * \param code Machine code emitter to output to
+	 */
+	void CodeGenerator::generateMove(int lhs, int rhs, MachineCode &code)
+	{
+		code.emit(VM::Instruction::makeTwoAddr(VM::TwoAddrAddImm, lhs, rhs, 0));
+	}
+
+	/*!
+	 * \brief Determine where to set up and tear down the stack frame of a procedure
+	 *
+	 * The frame consists of the saved registers and the spill area.  By default it is set up
+	 * in the prologue and torn down in the epilogue.  If every block which needs it is
+	 * dominated by a block other than the first one, and that block is outside of any loop,
+	 * the frame is instead set up at the start of that block and torn down on each edge
+	 * leaving the region it dominates, so that paths which never need the frame skip it
+	 * entirely.
+	 * \param procedure Procedure to examine
+	 * \param regMap Register assignments
+	 * \param savedRegs Mask of registers saved in the frame
+	 * \return Frame placement
+	 */
+	CodeGenerator::FramePlacement CodeGenerator::placeFrame(IR::Procedure &procedure, RegisterMap &regMap, unsigned long savedRegs)
+	{
+		FramePlacement placement;
+		const IR::Entry *prologue = nullptr;
+		const IR::Entry *epilogue = nullptr;
+		for(IR::Entry *entry : procedure.entries()) {
+			if(entry->type == IR::Entry::Type::Prologue) {
+				prologue = entry;
+			} else if(entry->type == IR::Entry::Type::Epilogue) {
+				epilogue = entry;
+			}
+		}
+
+		placement.setup = prologue;
+		placement.teardownBefore.insert(epilogue);
+
+		Analysis::FlowGraph flowGraph(procedure);
+		Analysis::DominatorTree doms(procedure, flowGraph);
+
+		// Find the nearest block which dominates all reachable blocks that need the frame
+		const Analysis::FlowGraph::Block *setupBlock = nullptr;
+		for(const Analysis::FlowGraph::Block *block : doms.blocks()) {
+			// Code in unreachable blocks is never executed, and so never needs the frame
+			if(!doms.idom(block)) {
+				continue;
+			}
+
+			bool needsFrame = false;
+			for(const IR::Entry *entry : block->entries) {
+				switch(entry->type) {
+					case IR::Entry::Type::Call:
+					case IR::Entry::Type::CallIndirect:
+					case IR::Entry::Type::LoadStack:
+					case IR::Entry::Type::StoreStack:
+						needsFrame = true;
+						break;
+
+					default:
+						for(const IR::Symbol *symbol : entry->useOperands()) {
+							needsFrame = needsFrame || (savedRegs & (1 << regMap[symbol]));
+						}
+						for(const IR::Symbol *symbol : entry->defOperands()) {
+							needsFrame = needsFrame || (savedRegs & (1 << regMap[symbol]));
+						}
+						break;
+				}
+			}
+
+			if(!needsFrame) {
+				continue;
+			}
+
+			if(!setupBlock) {
+				setupBlock = block;
+				continue;
+			}
+
+			while(setupBlock != block && !doms.dominates(block, setupBlock)) {
+				setupBlock = doms.idom(setupBlock);
+			}
+		}
+
+		// The frame must be set up at most once on any path, so it cannot be placed inside a loop
+		Analysis::Loops loops(procedure, flowGraph);
+		bool inLoop = true;
+		while(setupBlock && setupBlock != flowGraph.start() && inLoop) {
+			inLoop = false;
+			for(std::unique_ptr<Analysis::Loops::Loop> &loop : loops.loops()) {
+				if(loop->blocks.find(setupBlock) != loop->blocks.end()) {
+					inLoop = true;
+					setupBlock = doms.idom(setupBlock);
+					break;
+				}
+			}
+		}
+
+		if(!setupBlock || setupBlock == flowGraph.start()) {
+			return placement;
+		}
+
+		// Tear down the frame on every edge leaving the dominated region.  Since the setup block
+		// is not in a loop, control cannot re-enter the region without passing through it again
+		FramePlacement shrinkWrapped;
+		shrinkWrapped.setup = setupBlock->entries.front();
+		for(const Analysis::FlowGraph::Block *block : doms.blocks()) {
+			if(block != setupBlock && !doms.dominates(block, setupBlock)) {
+				continue;
+			}
+
+			if(block == flowGraph.end()) {
+				shrinkWrapped.teardownBefore.insert(epilogue);
+				continue;
+			}
+
+			for(const Analysis::FlowGraph::Block *succ : block->succ) {
+				if(succ == setupBlock || doms.dominates(succ, setupBlock)) {
+					continue;
+				}
+
+				// A conditional exit would require a new block on the edge, so fall back to
+				// the default placement
+				const IR::Entry *back = block->entries.back();
+				if(back->type == IR::Entry::Type::CJump) {
+					return placement;
+				} else if(back->type == IR::Entry::Type::Jump) {
+					shrinkWrapped.teardownBefore.insert(back);
+				} else {
+					shrinkWrapped.teardownAfter.insert(back);
+				}
+			}
 		}
 
+		return shrinkWrapped;
+	}
+
+	/*!
+	 * \brief Generate code to set up a stack frame
+	 * \param savedRegs Mask of registers to save
+	 * \param frameSize Number of spill slots
+	 * \param code Machine code emitter to output to
+	 */
+	void CodeGenerator::generateFrameSetup(unsigned long savedRegs, int frameSize, MachineCode &code)
+	{
+		// Save all required registers for this function
+		if(savedRegs != 0) {
+			code.emit(VM::Instruction::makeMultReg(VM::MultRegStore, VM::RegSP, savedRegs));
+		}
+
+		// Make space on the stack frame for any necessary spilled values
+		if(frameSize > 0) {
+			code.emit(VM::Instruction::makeTwoAddr(VM::TwoAddrAddImm, VM::RegSP, VM::RegSP, -frameSize * 4));
+		}
+	}
+
+	/*!
+	 * \brief Generate code to tear down a stack frame
+	 * \param savedRegs Mask of registers to restore
+	 * \param frameSize Number of spill slots
+	 * \param code Machine code emitter to output to
+	 */
+	void CodeGenerator::generateFrameTeardown(unsigned long savedRegs, int frameSize, MachineCode &code)
+	{
+		// Advance the stack pointer past the spilled value range
+		if(frameSize > 0) {
+			code.emit(VM::Instruction::makeTwoAddr(VM::TwoAddrAddImm, VM::RegSP, VM::RegSP, frameSize * 4));
+		}
 
+		// Reload all required registers
+		if(savedRegs != 0) {
+			code.emit(VM::Instruction::makeMultReg(VM::MultRegLoad, VM::RegSP, savedRegs));
+		}
 	}
 
 	/*!
 	 * \brief Generate code for an IR procedure
 	 * \param procedure Procedure to generate code for
-	 * \param stream Stream to output assembly to
+	 * \param code Machine code emitter to output to
+	 * \param allocatorMode Register allocation strategy
 	 */
-	void CodeGenerator::generateProcedure(IR::Procedure &procedure, std::ostream &stream)
+	void CodeGenerator::generateProcedure(IR::Procedure &procedure, MachineCode &code, RegisterAllocator::Mode allocatorMode)
 	{
-		std::map<const IR::Symbol*, int> regMap;
+		RegisterMap regMap;
 		std::map<std::string, std::string> strings;
-		std::string savedRegs;
+		unsigned long savedRegs = 0;
 
 		// Allocate registers for the procedure
 		Util::Timer timer;
 		timer.start();
-		RegisterAllocator allocator;
+		RegisterAllocator allocator(allocatorMode);
 		regMap = allocator.allocate(procedure);
 
 		Util::log("opt.time") << "Register allocation (" << procedure.name() << "): " << timer.stop() << "ms" << std::endl;
 
 		// Determine the set of registers that need to be saved/restored in the prologue/epilogue
-		std::stringstream s;
-		bool needComma = false;
-		s << "{";
 		for(auto &reg : regMap) {
 			if(reg.second > 3) {
-				if(needComma) {
-					s << ", ";
-				}
-				s << "r" << reg.second;
-				needComma = true;
+				savedRegs |= (1 << reg.second);
 			}
 		}
 
 		// If any calls are made in the procedure, LR must be saved as well
 		for(IR::Entry *entry : procedure.entries()) {
 			if(entry->type == IR::Entry::Type::Call || entry->type == IR::Entry::Type::CallIndirect) {
-				if(needComma) {
-					s << ", ";
-				}
-				s << "lr";
+				savedRegs |= (1 << VM::RegLR);
 				break;
 			}
 		}
-		s << "}";
-		savedRegs = s.str();
 
-		stream << "defproc " << procedure.name() << std::endl;
+		// Determine the size of the spill area, and where the frame should be set up
+		int frameSize = 0;
+		for(IR::Entry *entry : procedure.entries()) {
+			if(entry->type == IR::Entry::Type::Prologue) {
+				frameSize = ((IR::EntryThreeAddr*)entry)->imm;
+			}
+		}
+		FramePlacement placement = placeFrame(procedure, regMap, savedRegs);
+
+		code.beginProcedure(procedure.name());
 
 		// Iterate through each entry, and emit the appropriate code depending on its type
 		for(IR::Entry *entry : procedure.entries()) {
+			if(placement.teardownBefore.find(entry) != placement.teardownBefore.end()) {
+				generateFrameTeardown(savedRegs, frameSize, code);
+			}
+
 			switch(entry->type) {
 				case IR::Entry::Type::Move:
 					{
 						IR::EntryThreeAddr *threeAddr = (IR::EntryThreeAddr*)entry;
-						stream << "    mov r" << regMap[threeAddr->lhs] << ", ";
+
+						// A move between symbols which share a register needs no code
+						if(threeAddr->rhs1 && regMap[threeAddr->lhs] == regMap[threeAddr->rhs1]) {
+							break;
+						}
+
 						if(threeAddr->rhs1) {
-							stream << "r" << regMap[threeAddr->rhs1];
+							generateMove(regMap[threeAddr->lhs], regMap[threeAddr->rhs1], code);
 						} else {
-							stream << "#" << threeAddr->imm;
+							code.emit(VM::Instruction::makeOneAddr(VM::OneAddrLoadImm, regMap[threeAddr->lhs], threeAddr->imm));
 						}
-						stream << std::endl;
 						break;
 					}
 
 				case IR::Entry::Type::Add:
+					generateArith((IR::EntryThreeAddr*)entry, VM::TwoAddrAddImm, VM::ThreeAddrAdd, regMap, code);
+					break;
+
+				case IR::Entry::Type::Subtract:
 					{
+						// There is no immediate form of subtraction, so add the negated constant instead
 						IR::EntryThreeAddr *threeAddr = (IR::EntryThreeAddr*)entry;
-						stream << "    add r" << regMap[threeAddr->lhs] << ", r" << regMap[threeAddr->rhs1] << ", ";
 						if(threeAddr->rhs2) {
-							stream << "r" << regMap[threeAddr->rhs2];
+							code.emit(VM::Instruction::makeThreeAddr(VM::ThreeAddrSub, regMap[threeAddr->lhs], regMap[threeAddr->rhs1], regMap[threeAddr->rhs2], 0));
 						} else {
-							stream << "#" << threeAddr->imm;
+							code.emit(VM::Instruction::makeTwoAddr(VM::TwoAddrAddImm, regMap[threeAddr->lhs], regMap[threeAddr->rhs1], -threeAddr->imm));
 						}
-						stream << std::endl;
 						break;
 					}
 
 				case IR::Entry::Type::Mult:
-					{
-						IR::EntryThreeAddr *threeAddr = (IR::EntryThreeAddr*)entry;
-						stream << "    mult r" << regMap[threeAddr->lhs] << ", r" << regMap[threeAddr->rhs1] << ", ";
-						if(threeAddr->rhs2) {
-							stream << "r" << regMap[threeAddr->rhs2];
-						} else {
-							stream << "#" << threeAddr->imm;
-						}
-						stream << std::endl;
-						break;
-					}
+					generateArith((IR::EntryThreeAddr*)entry, VM::TwoAddrMultImm, VM::ThreeAddrMult, regMap, code);
+					break;
 
 				case IR::Entry::Type::Divide:
-					{
-						IR::EntryThreeAddr *threeAddr = (IR::EntryThreeAddr*)entry;
-						stream << "    div r" << regMap[threeAddr->lhs] << ", r" << regMap[threeAddr->rhs1] << ", ";
-						if(threeAddr->rhs2) {
-							stream << "r" << regMap[threeAddr->rhs2];
-						} else {
-							stream << "#" << threeAddr->imm;
-						}
-						stream << std::endl;
-						break;
-					}
+					generateArith((IR::EntryThreeAddr*)entry, VM::TwoAddrDivImm, VM::ThreeAddrDiv, regMap, code);
+					break;
 
 				case IR::Entry::Type::Modulo:
-					{
-						IR::EntryThreeAddr *threeAddr = (IR::EntryThreeAddr*)entry;
-						stream << "    mod r" << regMap[threeAddr->lhs] << ", r" << regMap[threeAddr->rhs1] << ", ";
-						if(threeAddr->rhs2) {
-							stream << "r" << regMap[threeAddr->rhs2];
-						} else {
-							stream << "#" << threeAddr->imm;
-						}
-						stream << std::endl;
-						break;
-					}
+					generateArith((IR::EntryThreeAddr*)entry, VM::TwoAddrModImm, VM::ThreeAddrMod, regMap, code);
+					break;
 
 				case IR::Entry::Type::Equal:
-					{
-						IR::EntryThreeAddr *threeAddr = (IR::EntryThreeAddr*)entry;
-						stream << "    equ r" << regMap[threeAddr->lhs] << ", r" << regMap[threeAddr->rhs1] << ", r" << regMap[threeAddr->rhs2] << std::endl;
-						break;
-					}
-
 				case IR::Entry::Type::Nequal:
-					{
-						IR::EntryThreeAddr *threeAddr = (IR::EntryThreeAddr*)entry;
-						stream << "    neq r" << regMap[threeAddr->lhs] << ", r" << regMap[threeAddr->rhs1] << ", r" << regMap[threeAddr->rhs2] << std::endl;
-						break;
-					}
-
 				case IR::Entry::Type::LessThan:
-					{
-						IR::EntryThreeAddr *threeAddr = (IR::EntryThreeAddr*)entry;
-						stream << "    lt r" << regMap[threeAddr->lhs] << ", r" << regMap[threeAddr->rhs1] << ", r" << regMap[threeAddr->rhs2] << std::endl;
-						break;
-					}
-
 				case IR::Entry::Type::LessThanE:
-					{
-						IR::EntryThreeAddr *threeAddr = (IR::EntryThreeAddr*)entry;
-						stream << "    lte r" << regMap[threeAddr->lhs] << ", r" << regMap[threeAddr->rhs1] << ", r" << regMap[threeAddr->rhs2] << std::endl;
-						break;
-					}
-
 				case IR::Entry::Type::GreaterThan:
-					{
-						IR::EntryThreeAddr *threeAddr = (IR::EntryThreeAddr*)entry;
-						stream << "    gt r" << regMap[threeAddr->lhs] << ", r" << regMap[threeAddr->rhs1] << ", r" << regMap[threeAddr->rhs2] << std::endl;
-						break;
-					}
-
 				case IR::Entry::Type::GreaterThanE:
-					{
-						IR::EntryThreeAddr *threeAddr = (IR::EntryThreeAddr*)entry;
-						stream << "    gte r" << regMap[threeAddr->lhs] << ", r" << regMap[threeAddr->rhs1] << ", r" << regMap[threeAddr->rhs2] << std::endl;
-						break;
-					}
-
 				case IR::Entry::Type::Or:
-					{
-						IR::EntryThreeAddr *threeAddr = (IR::EntryThreeAddr*)entry;
-						stream << "    or r" << regMap[threeAddr->lhs] << ", r" << regMap[threeAddr->rhs1] << ", r" << regMap[threeAddr->rhs2] << std::endl;
-						break;
-					}
-
 				case IR::Entry::Type::And:
 					{
 						IR::EntryThreeAddr *threeAddr = (IR::EntryThreeAddr*)entry;
-						stream << "    and r" << regMap[threeAddr->lhs] << ", r" << regMap[threeAddr->rhs1] << ", r" << regMap[threeAddr->rhs2] << std::endl;
+						int type = 0;
+						switch(entry->type) {
+							case IR::Entry::Type::Equal: type = VM::ThreeAddrEqual; break;
+							case IR::Entry::Type::Nequal: type = VM::ThreeAddrNEqual; break;
+							case IR::Entry::Type::LessThan: type = VM::ThreeAddrLessThan; break;
+							case IR::Entry::Type::LessThanE: type = VM::ThreeAddrLessThanE; break;
+							case IR::Entry::Type::GreaterThan: type = VM::ThreeAddrGreaterThan; break;
+							case IR::Entry::Type::GreaterThanE: type = VM::ThreeAddrGreaterThanE; break;
+							case IR::Entry::Type::Or: type = VM::ThreeAddrOr; break;
+							case IR::Entry::Type::And: type = VM::ThreeAddrAnd; break;
+							default: break;
+						}
+						code.emit(VM::Instruction::makeThreeAddr(type, regMap[threeAddr->lhs], regMap[threeAddr->rhs1], regMap[threeAddr->rhs2], 0));
 						break;
 					}
 
 				case IR::Entry::Type::Label:
 					{
 						IR::EntryLabel *label = (IR::EntryLabel*)entry;
-						stream << "  " << label->name << ":" << std::endl;
+						code.label(label->name);
 						break;
 					}
 
 				case IR::Entry::Type::Jump:
 					{
 						IR::EntryJump *jump = (IR::EntryJump*)entry;
-						stream << "    jmp " << jump->target->name << std::endl;
+						code.emitJump(jump->target->name);
 						break;
 					}
 
@@ -231,12 +380,12 @@ namespace Back {
 					{
 						IR::EntryCJump *cjump = (IR::EntryCJump*)entry;
 						if(cjump->next == cjump->trueTarget) {
-							stream << "    ncjmp r" << regMap[cjump->pred] << ", " << cjump->falseTarget->name << std::endl;
+							code.emitCJump(regMap[cjump->pred], cjump->falseTarget->name, true);
 						} else if(cjump->next == cjump->falseTarget) {
-							stream << "    cjmp r" << regMap[cjump->pred] << ", " << cjump->trueTarget->name << std::endl;
+							code.emitCJump(regMap[cjump->pred], cjump->trueTarget->name, false);
 						} else {
-							stream << "    cjmp r" << regMap[cjump->pred] << ", " << cjump->trueTarget->name << std::endl;
-							stream << "    jmp " << cjump->falseTarget->name << std::endl;
+							code.emitCJump(regMap[cjump->pred], cjump->trueTarget->name, false);
+							code.emitJump(cjump->falseTarget->name);
 						}
 						break;
 					}
@@ -244,14 +393,14 @@ namespace Back {
 				case IR::Entry::Type::Call:
 					{
 						IR::EntryCall *call = (IR::EntryCall*)entry;
-						stream << "    call " << call->target << std::endl;
+						code.emitCall(call->target);
 						break;
 					}
 
 				case IR::Entry::Type::CallIndirect:
 					{
 						IR::EntryThreeAddr *threeAddr = (IR::EntryThreeAddr*)entry;
-						stream << "    calli r" << regMap[threeAddr->rhs1] << std::endl;
+						code.emit(VM::Instruction::makeOneAddr(VM::OneAddrCall, regMap[threeAddr->rhs1], 0));
 						break;
 					}
 
@@ -259,7 +408,7 @@ namespace Back {
 					{
 						IR::EntryThreeAddr *threeAddr = (IR::EntryThreeAddr*)entry;
 						if(regMap[threeAddr->lhs] != 0) {
-							stream << "    mov r" << regMap[threeAddr->lhs] << ", r0" << std::endl;
+							generateMove(regMap[threeAddr->lhs], 0, code);
 						}
 						break;
 					}
@@ -268,7 +417,7 @@ namespace Back {
 					{
 						IR::EntryThreeAddr *threeAddr = (IR::EntryThreeAddr*)entry;
 						if(threeAddr->rhs1 && regMap[threeAddr->rhs1] != 0) {
-							stream << "    mov r0, r" << regMap[threeAddr->rhs1] << std::endl;
+							generateMove(0, regMap[threeAddr->rhs1], code);
 						}
 						break;
 					}
@@ -277,7 +426,7 @@ namespace Back {
 					{
 						IR::EntryThreeAddr *threeAddr = (IR::EntryThreeAddr*)entry;
 						if(regMap[threeAddr->lhs] != threeAddr->imm) {
-							stream << "    mov r" << regMap[threeAddr->lhs] << ", r" << threeAddr->imm << std::endl;
+							generateMove(regMap[threeAddr->lhs], threeAddr->imm, code);
 						}
 						break;
 					}
@@ -286,7 +435,7 @@ namespace Back {
 					{
 						IR::EntryThreeAddr *threeAddr = (IR::EntryThreeAddr*)entry;
 						if(regMap[threeAddr->rhs1] != threeAddr->imm) {
-							stream << "    mov r" << threeAddr->imm << ", r" << regMap[threeAddr->rhs1] << std::endl;
+							generateMove(threeAddr->imm, regMap[threeAddr->rhs1], code);
 						}
 						break;
 					}
@@ -294,100 +443,45 @@ namespace Back {
 				case IR::Entry::Type::LoadStack:
 					{
 						IR::EntryThreeAddr *threeAddr = (IR::EntryThreeAddr*)entry;
-						stream << "    ldr r" << regMap[threeAddr->lhs] << ", [sp, #" << threeAddr->imm << "]" << std::endl;
+						code.emit(VM::Instruction::makeTwoAddr(VM::TwoAddrLoad, regMap[threeAddr->lhs], VM::RegSP, threeAddr->imm * 4));
 						break;
 					}
 
 				case IR::Entry::Type::StoreStack:
 					{
 						IR::EntryThreeAddr *threeAddr = (IR::EntryThreeAddr*)entry;
-						stream << "    str r" << regMap[threeAddr->rhs1] << ", [sp, #" << threeAddr->imm << "]" << std::endl;
-						break;
-					}
-
-				case IR::Entry::Type::Prologue:
-					{
-						IR::EntryThreeAddr *threeAddr = (IR::EntryThreeAddr*)entry;
-						// Save all required registers for this function
-						if(savedRegs != "{}") {
-							stream << "    stm sp, " << savedRegs << std::endl;
-						}
-
-						// Make space on the stack frame for any necessary spilled values
-						if(threeAddr->imm > 0) {
-							stream << "    sub sp, sp, #" << threeAddr->imm << std::endl;
-						}
+						code.emit(VM::Instruction::makeTwoAddr(VM::TwoAddrStore, regMap[threeAddr->rhs1], VM::RegSP, threeAddr->imm * 4));
 						break;
 					}
 
 				case IR::Entry::Type::Epilogue:
 					{
-						IR::EntryThreeAddr *threeAddr = (IR::EntryThreeAddr*)entry;
-
-						// Advance the stack pointer past the spilled value range
-						if(threeAddr->imm > 0) {
-							stream << "    add sp, sp, #" << threeAddr->imm << std::endl;
-						}
-
-						// Reload all required registers
-						if(savedRegs != "{}") {
-							stream << "    ldm sp, " << savedRegs << std::endl;
-						}
-
 						// Jump back to the return location
-						stream << "    mov pc, lr" << std::endl;
+						generateMove(VM::RegPC, VM::RegLR, code);
 						break;
 					}
 
 				case IR::Entry::Type::New:
 					{
 						IR::EntryThreeAddr *threeAddr = (IR::EntryThreeAddr*)entry;
-						stream << "    new r" << regMap[threeAddr->lhs] << ", r" << regMap[threeAddr->rhs1] << std::endl;
+						code.emit(VM::Instruction::makeTwoAddr(VM::TwoAddrNew, regMap[threeAddr->lhs], regMap[threeAddr->rhs1], 0));
 						break;
 					}
 
 				case IR::Entry::Type::LoadMem:
-					{
-						IR::EntryThreeAddr *threeAddr = (IR::EntryThreeAddr*)entry;
-						std::string opcode;
-						if(threeAddr->lhs->size == 1) {
-							opcode = "ldb";
-						} else {
-							opcode = "ldr";
-						}
-
-						stream << "    " << opcode << " r" << regMap[threeAddr->lhs] << ", [r" << regMap[threeAddr->rhs1];
-						if(threeAddr->rhs2) {
-							stream << ", r" << regMap[threeAddr->rhs2];
-						}
-
-						if(threeAddr->imm != 0) {
-							stream << ", #" << threeAddr->imm;
-						}
-
-						stream << "]" << std::endl;
-						break;
-					}
-
 				case IR::Entry::Type::StoreMem:
 					{
 						IR::EntryThreeAddr *threeAddr = (IR::EntryThreeAddr*)entry;
-						std::string opcode;
-						if(threeAddr->lhs->size == 1) {
-							opcode = "stb";
-						} else {
-							opcode = "str";
-						}
-						stream << "    " << opcode << " r" << regMap[threeAddr->lhs] << ", [r" << regMap[threeAddr->rhs1];
+						bool load = (entry->type == IR::Entry::Type::LoadMem);
+						bool byte = (threeAddr->lhs->size == 1);
+						int reg = regMap[threeAddr->lhs];
 						if(threeAddr->rhs2) {
-							stream << ", r" << regMap[threeAddr->rhs2];
-						}
-
-						if(threeAddr->imm != 0) {
-							stream << ", #" << threeAddr->imm;
+							int type = load ? (byte ? VM::ThreeAddrLoadByte : VM::ThreeAddrLoad) : (byte ? VM::ThreeAddrStoreByte : VM::ThreeAddrStore);
+							code.emit(VM::Instruction::makeThreeAddr(type, reg, regMap[threeAddr->rhs1], regMap[threeAddr->rhs2], threeAddr->imm));
+						} else {
+							int type = load ? (byte ? VM::TwoAddrLoadByte : VM::TwoAddrLoad) : (byte ? VM::TwoAddrStoreByte : VM::TwoAddrStore);
+							code.emit(VM::Instruction::makeTwoAddr(type, reg, regMap[threeAddr->rhs1], threeAddr->imm));
 						}
-
-						stream << "]" << std::endl;
 						break;
 					}
 
@@ -397,38 +491,44 @@ namespace Back {
 						std::stringstream s;
 						s << "str" << strings.size();
 						strings[s.str()] = string->string;
-						stream << "    lea r" << regMap[string->lhs] << ", " << procedure.name() << "$$" << s.str() << std::endl;
+						code.emitLoadAddress(regMap[string->lhs], procedure.name() + "$$" + s.str());
 						break;
 					}
 
 				case IR::Entry::Type::LoadAddress:
 					{
 						IR::EntryString *string = (IR::EntryString*)entry;
-						stream << "    lea r" << regMap[string->lhs] << ", " << string->string << std::endl;
+						code.emitLoadAddress(regMap[string->lhs], string->string);
 						break;
 					}
 			}
+
+			if(entry == placement.setup) {
+				generateFrameSetup(savedRegs, frameSize, code);
+			}
+
+			if(placement.teardownAfter.find(entry) != placement.teardownAfter.end()) {
+				generateFrameTeardown(savedRegs, frameSize, code);
+			}
 		}
-		stream << std::endl;
 
 		// Write out string constants
 		for(auto &string : strings) {
 			const std::string &name = string.first;
 			const std::string &value = string.second;
-			stream << "defdata " << procedure.name() << "$$" << name << std::endl;
-			stream << "    string \"" << value << "\"" << std::endl;
-			stream << std::endl;
+			code.beginData(procedure.name() + "$$" + name);
+			code.emitString(value);
 		}
 	}
 
 	/*!
 	 * \brief Generate code for an IR data section
 	 * \param data Data to generate code for
-	 * \param stream Stream to output assembly to
+	 * \param code Machine code emitter to output to
 	 */
-	void CodeGenerator::generateData(IR::Data &data, std::ostream &stream)
+	void CodeGenerator::generateData(IR::Data &data, MachineCode &code)
 	{
-		stream << "defdata " << data.name() << std::endl;
+		code.beginData(data.name());
 
 		// Iterate through each entry, and emit the appropriate code depending on its type
 		for(IR::Entry *entry : data.entries()) {
@@ -436,7 +536,7 @@ namespace Back {
 				case IR::Entry::Type::FunctionAddr:
 					{
 						IR::EntryCall *call = (IR::EntryCall*)entry;
-						stream << "    addr " << call->target << std::endl;
+						code.emitAddress(call->target);
 						break;
 					}
 			}
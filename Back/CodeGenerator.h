@@ -3,8 +3,13 @@
 
 #include "IR/Procedure.h"
 #include "IR/Program.h"
+#include "IR/Entry.h"
 
-#include <iostream>
+#include "Back/RegisterAllocator.h"
+#include "Back/MachineCode.h"
+
+#include <map>
+#include <set>
 
 /*!
  * \brief Back-end functions for the compiler
@@ -17,11 +22,27 @@ namespace Back {
 	 */
 	class CodeGenerator {
 	public:
-		static void generate(IR::Program &irProgram, std::ostream &stream);
+		static void generate(IR::Program &irProgram, MachineCode &code, RegisterAllocator::Mode allocatorMode = RegisterAllocator::Mode::Auto);
 
 	private:
-		static void generateProcedure(IR::Procedure &procedure, std::ostream &stream);
-		static void generateData(IR::Data &data, std::ostream &stream);
+		typedef std::map<const IR::Symbol*, int> RegisterMap;
+
+		/*!
+		 * \brief Locations at which the stack frame is set up and torn down
+		 */
+		struct FramePlacement {
+			const IR::Entry *setup; //!< Entry after which the frame is set up
+			std::set<const IR::Entry*> teardownBefore; //!< Entries before which the frame is torn down
+			std::set<const IR::Entry*> teardownAfter; //!< Entries after which the frame is torn down
+		};
+
+		static void generateProcedure(IR::Procedure &procedure, MachineCode &code, RegisterAllocator::Mode allocatorMode);
+		static void generateData(IR::Data &data, MachineCode &code);
+		static void generateArith(IR::EntryThreeAddr *threeAddr, int twoAddrType, int threeAddrType, RegisterMap &regMap, MachineCode &code);
+		static void generateMove(int lhs, int rhs, MachineCode &code);
+		static FramePlacement placeFrame(IR::Procedure &procedure, RegisterMap &regMap, unsigned long savedRegs);
+		static void generateFrameSetup(unsigned long savedRegs, int frameSize, MachineCode &code);
+		static void generateFrameTeardown(unsigned long savedRegs, int frameSize, MachineCode &code);
 	};
 }
 #endif
\ No newline at end of file
@@ -0,0 +1,234 @@
+#include "Back/MachineCode.h"
+
+#include <cstring>
+
+namespace Back {
+	/*!
+	 * \brief Constructor
+	 * \param listing Stream to write an assembly listing to, or null for no listing
+	 */
+	MachineCode::MachineCode(std::ostream *listing)
+		: mListing(listing)
+	{
+		mProgram = std::make_unique<VM::Program>();
+	}
+
+	/*!
+	 * \brief Begin a new procedure
+	 * \param name Procedure name
+	 */
+	void MachineCode::beginProcedure(const std::string &name)
+	{
+		beginSection("defproc", name);
+	}
+
+	/*!
+	 * \brief Begin a new data section
+	 * \param name Data name
+	 */
+	void MachineCode::beginData(const std::string &name)
+	{
+		beginSection("defdata", name);
+	}
+
+	/*!
+	 * \brief Define a label at the current location in the section
+	 * \param name Label name
+	 */
+	void MachineCode::label(const std::string &name)
+	{
+		mLabels[name] = (int)mProgram->instructions.size();
+
+		if(mListing) {
+			*mListing << "  " << name << ":" << std::endl;
+		}
+	}
+
+	/*!
+	 * \brief Emit an instruction which requires no fixups
+	 * \param instr Instruction
+	 */
+	void MachineCode::emit(const VM::Instruction &instr)
+	{
+		append(instr);
+
+		if(mListing) {
+			*mListing << "    " << instr << std::endl;
+		}
+	}
+
+	/*!
+	 * \brief Emit an unconditional jump to a label in the current section
+	 * \param target Label name
+	 */
+	void MachineCode::emitJump(const std::string &target)
+	{
+		int offset = append(VM::Instruction::makeTwoAddr(VM::TwoAddrAddImm, VM::RegPC, VM::RegPC, 0));
+		mLabelRefs.push_back(std::make_pair(offset, target));
+
+		if(mListing) {
+			*mListing << "    jmp " << target << std::endl;
+		}
+	}
+
+	/*!
+	 * \brief Emit a conditional jump to a label in the current section
+	 * \param pred Predicate register
+	 * \param target Label name
+	 * \param negated True if the jump should be taken when the predicate is zero
+	 */
+	void MachineCode::emitCJump(int pred, const std::string &target, bool negated)
+	{
+		int type = negated ? VM::ThreeAddrAddNCond : VM::ThreeAddrAddCond;
+		int offset = append(VM::Instruction::makeThreeAddr(type, VM::RegPC, pred, VM::RegPC, 0));
+		mLabelRefs.push_back(std::make_pair(offset, target));
+
+		if(mListing) {
+			*mListing << "    " << (negated ? "ncjmp " : "cjmp ") << VM::Instruction::regName(pred) << ", " << target << std::endl;
+		}
+	}
+
+	/*!
+	 * \brief Emit a call to a procedure
+	 * \param target Procedure name
+	 */
+	void MachineCode::emitCall(const std::string &target)
+	{
+		int offset = append(VM::Instruction::makeOneAddr(VM::OneAddrCall, VM::RegPC, 0));
+		addRelocation(offset, VM::Program::Relocation::Type::Call, target);
+
+		if(mListing) {
+			*mListing << "    call " << target << std::endl;
+		}
+	}
+
+	/*!
+	 * \brief Emit a load of a symbol's address into a register
+	 * \param reg Destination register
+	 * \param target Symbol name
+	 */
+	void MachineCode::emitLoadAddress(int reg, const std::string &target)
+	{
+		int offset = append(VM::Instruction::makeTwoAddr(VM::TwoAddrAddImm, reg, VM::RegPC, 0));
+		addRelocation(offset, VM::Program::Relocation::Type::AddPCRel, target);
+
+		if(mListing) {
+			*mListing << "    lea " << VM::Instruction::regName(reg) << ", " << target << std::endl;
+		}
+	}
+
+	/*!
+	 * \brief Emit a null-terminated string constant, padded to instruction alignment
+	 * \param value String value
+	 */
+	void MachineCode::emitString(const std::string &value)
+	{
+		std::vector<unsigned char> &instructions = mProgram->instructions;
+		int offset = (int)instructions.size();
+		int newSize = offset + (int)value.size() + 1;
+		if(newSize % 4 > 0) {
+			newSize += 4 - (newSize % 4);
+		}
+		instructions.resize(newSize, 0);
+		std::memcpy(&instructions[offset], value.c_str(), value.size());
+
+		if(mListing) {
+			*mListing << "    string \"" << value << "\"" << std::endl;
+		}
+	}
+
+	/*!
+	 * \brief Emit the absolute address of a symbol
+	 * \param target Symbol name
+	 */
+	void MachineCode::emitAddress(const std::string &target)
+	{
+		std::vector<unsigned char> &instructions = mProgram->instructions;
+		int offset = (int)instructions.size();
+		instructions.resize(offset + 4, 0);
+		addRelocation(offset, VM::Program::Relocation::Type::Absolute, target);
+
+		if(mListing) {
+			*mListing << "    addr " << target << std::endl;
+		}
+	}
+
+	/*!
+	 * \brief Complete emission
+	 * \return Emitted program
+	 */
+	std::unique_ptr<VM::Program> MachineCode::finish()
+	{
+		endSection();
+
+		return std::move(mProgram);
+	}
+
+	/*!
+	 * \brief Begin a new section, completing the previous one
+	 * \param directive Assembly directive to list for the section
+	 * \param name Section name
+	 */
+	void MachineCode::beginSection(const std::string &directive, const std::string &name)
+	{
+		endSection();
+		mProgram->symbols[name] = (int)mProgram->instructions.size();
+
+		if(mListing) {
+			*mListing << directive << " " << name << std::endl;
+		}
+	}
+
+	/*!
+	 * \brief Patch all label references in the current section
+	 */
+	void MachineCode::endSection()
+	{
+		for(auto &labelRef : mLabelRefs) {
+			int offset = labelRef.first;
+			int targetOffset = mLabels[labelRef.second];
+
+			VM::Instruction instr;
+			std::memcpy(&instr, &mProgram->instructions[offset], 4);
+			if(instr.type == VM::InstrTwoAddr) {
+				instr.two.imm = targetOffset - offset;
+			} else {
+				instr.three.imm = targetOffset - offset;
+			}
+			std::memcpy(&mProgram->instructions[offset], &instr, 4);
+		}
+
+		mLabelRefs.clear();
+		mLabels.clear();
+	}
+
+	/*!
+	 * \brief Append an encoded instruction to the program
+	 * \param instr Instruction
+	 * \return Offset of the instruction
+	 */
+	int MachineCode::append(const VM::Instruction &instr)
+	{
+		std::vector<unsigned char> &instructions = mProgram->instructions;
+		int offset = (int)instructions.size();
+		instructions.resize(offset + 4);
+		std::memcpy(&instructions[offset], &instr, 4);
+
+		return offset;
+	}
+
+	/*!
+	 * \brief Record a relocation against an external symbol
+	 * \param offset Offset of the relocated location
+	 * \param type Relocation type
+	 * \param symbol Symbol name
+	 */
+	void MachineCode::addRelocation(int offset, VM::Program::Relocation::Type type, const std::string &symbol)
+	{
+		VM::Program::Relocation relocation;
+		relocation.offset = offset;
+		relocation.type = type;
+		relocation.symbol = symbol;
+		mProgram->relocations.push_back(relocation);
+	}
+}
\ No newline at end of file
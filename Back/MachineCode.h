@@ -0,0 +1,52 @@
+#ifndef BACK_MACHINE_CODE_H
+#define BACK_MACHINE_CODE_H
+
+#include "VM/Program.h"
+#include "VM/Instruction.h"
+
+#include <iostream>
+#include <string>
+#include <map>
+#include <vector>
+#include <memory>
+
+namespace Back {
+	/*!
+	 * \brief Emitter which encodes machine instructions directly into a VM program
+	 *
+	 * Label references within a section are patched when the section ends, and references
+	 * to other symbols are recorded as relocations, exactly as the assembler would do when
+	 * parsing the equivalent text.  If a listing stream is supplied, the equivalent assembly
+	 * text is also written to it as code is emitted.
+	 */
+	class MachineCode {
+	public:
+		MachineCode(std::ostream *listing = nullptr);
+
+		void beginProcedure(const std::string &name);
+		void beginData(const std::string &name);
+		void label(const std::string &name);
+
+		void emit(const VM::Instruction &instr);
+		void emitJump(const std::string &target);
+		void emitCJump(int pred, const std::string &target, bool negated);
+		void emitCall(const std::string &target);
+		void emitLoadAddress(int reg, const std::string &target);
+		void emitString(const std::string &value);
+		void emitAddress(const std::string &target);
+
+		std::unique_ptr<VM::Program> finish();
+
+	private:
+		void beginSection(const std::string &directive, const std::string &name);
+		void endSection();
+		int append(const VM::Instruction &instr);
+		void addRelocation(int offset, VM::Program::Relocation::Type type, const std::string &symbol);
+
+		std::unique_ptr<VM::Program> mProgram; //!< Program being emitted
+		std::ostream *mListing; //!< Assembly listing stream, or null if not listing
+		std::map<std::string, int> mLabels; //!< Label offsets in the current section
+		std::vector<std::pair<int, std::string>> mLabelRefs; //!< Instructions in the current section which reference a label
+	};
+}
+#endif
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include "Analysis/InterferenceGraph.h"
 #include "Analysis/LiveVariables.h"
 #include "Analysis/Loops.h"
+#include "Analysis/DominatorTree.h"
 #include "Analysis/UseDefs.h"
 #include "Analysis/Constants.h"
 
@@ -17,6 +18,9 @@
 
 #include <vector>
 #include <sstream>
+#include <algorithm>
+#include <memory>
+#include <limits>
 
 namespace Back {
 
@@ -31,6 +35,7 @@ static const int CallerSavedRegisters = 4;
 std::map<const IR::Symbol*, int> getSpillCosts(const IR::Procedure &procedure, const Analysis::FlowGraph &flowGraph)
 {
 	std::map<const IR::Symbol*, int> costs;
+	std::set<const IR::Symbol*> reloaded;
 
 	// Perform flow graph and loop analysis on the procedure
 	Analysis::Loops loops(procedure, flowGraph);
@@ -48,21 +53,28 @@ std::map<const IR::Symbol*, int> getSpillCosts(const IR::Procedure &procedure, c
 
 		// Iterate through the block's entries
 		for(const IR::Entry *entry : block->entries) {
-			// Iterate through the symbols in the procedure
-			for(const std::unique_ptr<IR::Symbol> &symbol : procedure.symbols()) {
-				// Any assignment to the variable adds to its cost
-				if(entry->assign() == symbol.get()) {
-					costs[symbol.get()] += cost;
-				}
+			// Any assignment to a variable adds to its cost
+			for(const IR::Symbol *symbol : entry->defOperands()) {
+				costs[symbol] += cost;
+			}
 
-				// Any use of the variable also adds to its cost
-				if(entry->uses(symbol.get())) {
-					costs[symbol.get()] += cost;
-				}
+			// Any use of a variable also adds to its cost
+			for(const IR::Symbol *symbol : entry->useOperands()) {
+				costs[symbol] += cost;
+			}
+
+			// A variable which was reloaded from the stack already has as short a live range as
+			// spilling can give it, so spilling it again would not reduce register pressure
+			if(entry->type == IR::Entry::Type::LoadStack) {
+				reloaded.insert(entry->assign());
 			}
 		}
 	}
 
+	for(const IR::Symbol *symbol : reloaded) {
+		costs[symbol] = std::numeric_limits<int>::max();
+	}
+
 	return costs;
 }
 
@@ -193,65 +205,430 @@ std::map<const IR::Symbol*, int> getPreferredRegisters(IR::Procedure &procedure)
 	return preferredRegisters;
 }
 
+/*!
+ * \brief Split the live ranges of arguments which are preserved across procedure calls
+ *
+ * An argument which is live across a call must be kept in a callee-saved register from the
+ * start of the procedure, which forces a register save even on paths which never make a
+ * call.  If all such calls are dominated by a block outside of any loop, the argument is
+ * instead kept in a new temporary until that block, and copied into its original symbol
+ * there, so that saves can be placed on only the paths that need them.
+ * \param procedure Procedure to modify
+ * \param analysis Analysis of procedure
+ * \return Copies inserted into the procedure
+ */
+std::set<const IR::Entry*> splitArgumentLiveRanges(IR::Procedure &procedure, Analysis::Analysis &analysis)
+{
+	std::set<const IR::Entry*> copies;
+	const Analysis::FlowGraph &flowGraph = analysis.flowGraph();
+	Analysis::LiveVariables liveVariables(procedure, flowGraph);
+	Analysis::DominatorTree doms(procedure, flowGraph);
+	Analysis::Loops loops(procedure, flowGraph);
+
+	std::map<const IR::Entry*, const Analysis::FlowGraph::Block*> entryBlocks;
+	for(const std::unique_ptr<Analysis::FlowGraph::Block> &block : flowGraph.blocks()) {
+		for(const IR::Entry *entry : block->entries) {
+			entryBlocks[entry] = block.get();
+		}
+	}
+
+	auto inLoop = [&](const Analysis::FlowGraph::Block *block) {
+		for(std::unique_ptr<Analysis::Loops::Loop> &loop : loops.loops()) {
+			if(loop->blocks.find(block) != loop->blocks.end()) {
+				return true;
+			}
+		}
+		return false;
+	};
+
+	for(const IR::Entry *entry : flowGraph.start()->entries) {
+		if(entry->type != IR::Entry::Type::LoadArg) {
+			continue;
+		}
+
+		IR::EntryThreeAddr *loadArg = (IR::EntryThreeAddr*)entry;
+		const IR::Symbol *symbol = loadArg->lhs;
+
+		// Only arguments which are never reassigned can be split
+		int numDefs = 0;
+		for(const IR::Entry *other : procedure.entries()) {
+			if(other->assign() == symbol) {
+				numDefs++;
+			}
+		}
+		if(numDefs != 1) {
+			continue;
+		}
+
+		// Find the nearest block outside of a loop which dominates every call across which the argument is live
+		const Analysis::FlowGraph::Block *split = nullptr;
+		for(const IR::Entry *other : procedure.entries()) {
+			if(other->type != IR::Entry::Type::Call && other->type != IR::Entry::Type::CallIndirect) {
+				continue;
+			}
+
+			const std::set<const IR::Symbol*> &variables = liveVariables.variables(other);
+			if(variables.find(symbol) == variables.end()) {
+				continue;
+			}
+
+			// Calls in unreachable code are never made
+			const Analysis::FlowGraph::Block *block = entryBlocks[other];
+			if(!doms.idom(block)) {
+				continue;
+			}
+
+			if(!split) {
+				split = block;
+				continue;
+			}
+
+			while(split != block && !doms.dominates(block, split)) {
+				split = doms.idom(split);
+			}
+		}
+
+		while(split && split != flowGraph.start() && inLoop(split)) {
+			split = doms.idom(split);
+		}
+
+		if(!split || split == flowGraph.start()) {
+			continue;
+		}
+
+		// Uses outside of the split block's dominance region read the temporary instead.  This
+		// is only possible if none of them can be reached from the split block
+		std::set<const Analysis::FlowGraph::Block*> reachable;
+		std::vector<const Analysis::FlowGraph::Block*> stack;
+		stack.push_back(split);
+		while(!stack.empty()) {
+			const Analysis::FlowGraph::Block *block = stack.back();
+			stack.pop_back();
+			if(reachable.insert(block).second) {
+				stack.insert(stack.end(), block->succ.begin(), block->succ.end());
+			}
+		}
+
+		std::vector<IR::Entry*> outsideUses;
+		bool valid = true;
+		for(IR::Entry *other : procedure.entries()) {
+			if(!other->uses(symbol)) {
+				continue;
+			}
+
+			const Analysis::FlowGraph::Block *block = entryBlocks[other];
+			if(block == split || doms.dominates(block, split)) {
+				continue;
+			}
+
+			if(reachable.find(block) != reachable.end()) {
+				valid = false;
+				break;
+			}
+			outsideUses.push_back(other);
+		}
+
+		if(!valid) {
+			continue;
+		}
+
+		IR::Symbol *temp = procedure.newTemp(symbol->size);
+		loadArg->replaceAssign(symbol, temp);
+		for(IR::Entry *use : outsideUses) {
+			use->replaceUse(symbol, temp);
+		}
+
+		IR::EntrySubList::const_iterator position = split->entries.begin();
+		position++;
+		IR::Entry *copy = procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::Move, symbol, temp);
+		procedure.entries().insert(*position, copy);
+		copies.insert(copy);
+	}
+
+	if(!copies.empty()) {
+		analysis.invalidate();
+	}
+
+	return copies;
+}
+
+/*!
+ * \brief Check whether two symbols can be coalesced without making the graph harder to color
+ *
+ * The Briggs test succeeds if the merged node would have fewer than MaxRegisters neighbors
+ * of significant degree.  The George test succeeds if every neighbor of the source either
+ * already interferes with the destination or has insignificant degree.  Either is sufficient
+ * to guarantee that coalescing cannot turn a colorable graph into an uncolorable one.
+ * \param graph Interference graph
+ * \param dest Symbol to merge into
+ * \param source Symbol to merge
+ * \param precolored Symbols which have a fixed register
+ * \return True if the symbols can be safely coalesced
+ */
+bool canCoalesce(const Analysis::InterferenceGraph &graph, const IR::Symbol *dest, const IR::Symbol *source, const std::map<const IR::Symbol*, int> &precolored)
+{
+	auto significant = [&](const IR::Symbol *symbol, int degree) {
+		return degree >= MaxRegisters || precolored.find(symbol) != precolored.end();
+	};
+
+	// George test
+	bool george = true;
+	for(const IR::Symbol *neighbor : graph.interferences(source)) {
+		if(!graph.removed(neighbor) && !graph.interferes(neighbor, dest) && significant(neighbor, graph.degree(neighbor))) {
+			george = false;
+			break;
+		}
+	}
+
+	if(george) {
+		return true;
+	}
+
+	// Briggs test.  A neighbor shared by both symbols loses one edge when they are merged
+	int count = 0;
+	for(const IR::Symbol *neighbor : graph.interferences(dest)) {
+		if(!graph.removed(neighbor)) {
+			int degree = graph.degree(neighbor) - (graph.interferes(neighbor, source) ? 1 : 0);
+			if(significant(neighbor, degree)) {
+				count++;
+			}
+		}
+	}
+
+	for(const IR::Symbol *neighbor : graph.interferences(source)) {
+		if(!graph.removed(neighbor) && !graph.interferes(neighbor, dest) && significant(neighbor, graph.degree(neighbor))) {
+			count++;
+		}
+	}
+
+	return count < MaxRegisters;
+}
+
+/*!
+ * \brief Conservatively coalesce the source and destination of moves in the procedure
+ * \param graph Interference graph to modify
+ * \param precolored Symbols which have a fixed register, and so are never coalesced
+ */
+void coalesceMoves(Analysis::InterferenceGraph &graph, const std::map<const IR::Symbol*, int> &precolored)
+{
+	for(const Analysis::InterferenceGraph::Move &move : graph.moves()) {
+		const IR::Symbol *dest = graph.alias(move.first);
+		const IR::Symbol *source = graph.alias(move.second);
+
+		if(dest == source || precolored.find(dest) != precolored.end() || precolored.find(source) != precolored.end()) {
+			continue;
+		}
+
+		if(!graph.interferes(dest, source) && canCoalesce(graph, dest, source, precolored)) {
+			graph.coalesce(source, dest);
+		}
+	}
+}
+
+/*!
+ * \brief Loop structure of a procedure, used to decide where spill code should be placed
+ */
+struct SpillPlacement {
+	/*!
+	 * \brief Information about a single loop
+	 */
+	struct LoopInfo {
+		int pressure; //!< Largest number of variables simultaneously live in the loop
+		bool hasCall; //!< True if the loop contains a procedure call
+		IR::Entry *reloadPoint; //!< Entry before which reloads hoisted out of the loop are placed, or 0 if none
+	};
+
+	SpillPlacement(IR::Procedure &procedure, Analysis::Analysis &analysis, const Analysis::LiveVariables &liveVariables);
+
+	Analysis::Loops loops; //!< Loops in the procedure
+	std::vector<Analysis::Loops::Loop*> entryLoops; //!< Innermost loop containing each entry, indexed by entry id
+	std::map<const Analysis::Loops::Loop*, LoopInfo> loopInfo; //!< Information about each loop
+};
+
+/*!
+ * \brief Constructor
+ * \param procedure Procedure to analyze
+ * \param analysis Analysis of procedure
+ * \param liveVariables Live variables in procedure
+ */
+SpillPlacement::SpillPlacement(IR::Procedure &procedure, Analysis::Analysis &analysis, const Analysis::LiveVariables &liveVariables)
+	: loops(procedure, analysis.flowGraph()), entryLoops(procedure.numEntryIds(), nullptr)
+{
+	for(std::unique_ptr<Analysis::Loops::Loop> &loop : loops.loops()) {
+		LoopInfo info = { 0, false, nullptr };
+
+		for(const Analysis::FlowGraph::Block *block : loop->blocks) {
+			for(const IR::Entry *entry : block->entries) {
+				// Nested loops are subsets of their parents, so the smallest loop containing
+				// an entry is the innermost one
+				Analysis::Loops::Loop *&innermost = entryLoops[entry->id];
+				if(!innermost || innermost->blocks.size() > loop->blocks.size()) {
+					innermost = loop.get();
+				}
+
+				int pressure = (int)liveVariables.variables(entry).size();
+				if(pressure > info.pressure) {
+					info.pressure = pressure;
+				}
+
+				if(entry->type == IR::Entry::Type::Call || entry->type == IR::Entry::Type::CallIndirect) {
+					info.hasCall = true;
+				}
+			}
+		}
+
+		// Code placed before the loop must go ahead of the preheader's jump into the loop, if it
+		// has one, or otherwise immediately before the header, which the preheader falls into
+		if(loop->preheader) {
+			const IR::Entry *back = loop->preheader->entries.back();
+			if(back->type == IR::Entry::Type::Jump) {
+				info.reloadPoint = procedure.entries().entry(back);
+			} else {
+				info.reloadPoint = procedure.entries().entry(loop->header->entries.front());
+			}
+		}
+
+		loopInfo[loop.get()] = info;
+	}
+}
+
 /*!
  * \brief Spill a variable in a procedure to the stack
+ *
+ * The variable is stored to its stack slot after each definition, and reloaded before its
+ * uses.  A reload is placed before the outermost enclosing loop which does not define the
+ * variable and which has room for it in a register, so that the variable's live range is
+ * split at the loop boundary instead of reloading on every iteration.  Otherwise it is
+ * placed directly before the use, and reused by later uses until the end of the block, the
+ * next procedure call, or the point at which register pressure drops.
  * \param procedure Procedure to modify
  * \param symbol Symbol to spill
  * \param liveVariables Live variables in procedure
- * \param useDefs Use-def chains in procedure
+ * \param analysis Analysis of procedure
+ * \param placement Loop structure of procedure, or 0 to reload before each use
  */
-void spillVariable(IR::Procedure &procedure, const IR::Symbol *symbol, Analysis::LiveVariables &liveVariables, Analysis::Analysis &analysis)
+void spillVariable(IR::Procedure &procedure, const IR::Symbol *symbol, Analysis::LiveVariables &liveVariables, Analysis::Analysis &analysis, SpillPlacement *placement)
 {
 	int idx = 0;
 	bool live = false;
+	IR::Entry *liveDef = nullptr;
 	std::set<const IR::Symbol*> liveSet;
 	std::set<const IR::Entry*> neededDefs;
+	std::set<const IR::Entry*> usedDefs;
 	std::set<IR::Entry*> spillLoads;
+	std::set<const Analysis::Loops::Loop*> reloadedLoops;
 
 	const Analysis::UseDefs &useDefs = analysis.useDefs();
 	const Analysis::Constants &constants = analysis.constants();
 
+	// The new stack slot goes at the end of the current stack frame
+	for(IR::Entry *entry : procedure.entries()) {
+		if(entry->type == IR::Entry::Type::Prologue) {
+			idx = ((IR::EntryThreeAddr*)entry)->imm;
+			break;
+		}
+	}
+
+	// Determine the loops which contain a definition of the symbol
+	std::set<const Analysis::Loops::Loop*> defLoops;
+	if(placement) {
+		for(IR::Entry *entry : procedure.entries()) {
+			if(entry->assign() == symbol && entry->id < (int)placement->entryLoops.size()) {
+				for(Analysis::Loops::Loop *loop = placement->entryLoops[entry->id]; loop && loop != placement->loops.rootLoop(); loop = loop->parent) {
+					defLoops.insert(loop);
+				}
+			}
+		}
+	}
+
+	// Find the outermost loop around an entry that the symbol can be reloaded ahead of
+	auto findReloadLoop = [&](const IR::Entry *entry) {
+		const Analysis::Loops::Loop *reloadLoop = nullptr;
+		if(!placement || entry->id >= (int)placement->entryLoops.size()) {
+			return reloadLoop;
+		}
+
+		for(Analysis::Loops::Loop *loop = placement->entryLoops[entry->id]; loop && loop != placement->loops.rootLoop(); loop = loop->parent) {
+			const SpillPlacement::LoopInfo &info = placement->loopInfo[loop];
+			int available = info.hasCall ? MaxRegisters - CallerSavedRegisters : MaxRegisters;
+			if(defLoops.find(loop) != defLoops.end() || info.pressure >= available) {
+				break;
+			}
+
+			if(info.reloadPoint) {
+				reloadLoop = loop;
+			}
+		}
+
+		return reloadLoop;
+	};
+
 	// Iterate through the entries in the procedure
 	for(IR::Entry *entry : procedure.entries()) {
+		// If the entry uses the symbol while it is still live, then the definition which made it
+		// live must be kept
+		if(entry->uses(symbol) && live) {
+			usedDefs.insert(liveDef);
+		}
+
 		// If the entry uses the symbol and the symbol was not already live, the symbol must be
 		// loaded from the stack
 		if(entry->uses(symbol) && !live) {
 			bool isConstant;
 			int value = constants.getIntValue(entry, symbol, isConstant);
+			const Analysis::Loops::Loop *reloadLoop = isConstant ? nullptr : findReloadLoop(entry);
+
+			if(reloadLoop) {
+				// Reload the symbol once, ahead of the loop
+				if(reloadedLoops.insert(reloadLoop).second) {
+					IR::Entry *def = procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::LoadStack, symbol, nullptr, nullptr, idx);
+					procedure.entries().insert(placement->loopInfo[reloadLoop].reloadPoint, def);
+					spillLoads.insert(def);
+				}
 
-			IR::Entry *def;
-			if(isConstant) {
-				// If the entry was constant, then just rematerialize the constant
-				def = new IR::EntryThreeAddr(IR::Entry::Type::Move, symbol, 0, 0, value);
-			} else {
-				// Otherwise, load it from its stack location
-				def = new IR::EntryThreeAddr(IR::Entry::Type::LoadStack, symbol, 0, 0, idx);
 				const std::set<const IR::Entry*> &defs = useDefs.defines(entry, symbol);
 				neededDefs.insert(defs.begin(), defs.end());
-			}
+			} else {
+				IR::Entry *def;
+				if(isConstant) {
+					// If the entry was constant, then just rematerialize the constant
+					def = procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::Move, symbol, nullptr, nullptr, value);
+				} else {
+					// Otherwise, load it from its stack location
+					def = procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::LoadStack, symbol, nullptr, nullptr, idx);
+					const std::set<const IR::Entry*> &defs = useDefs.defines(entry, symbol);
+					neededDefs.insert(defs.begin(), defs.end());
+				}
 
-			// Insert the new instruction
-			procedure.entries().insert(entry, def);
-			spillLoads.insert(def);
+				// Insert the new instruction
+				procedure.entries().insert(entry, def);
+				spillLoads.insert(def);
 
-			// The variable is now live
-			live = true;
-			liveSet = liveVariables.variables(entry);
+				// The variable is now live
+				live = true;
+				liveDef = def;
+				liveSet = liveVariables.variables(entry);
+			}
 		}
 
 		// An assignment to the variable also makes it live
 		if(entry->assign() == symbol) {
 			live = true;
+			liveDef = entry;
 			liveSet = liveVariables.variables(entry);
 		}
 
 		if(entry->type == IR::Entry::Type::Label) {
 			// Liveness ceases when the current block ends
 			live = false;
+		} else if(entry->type == IR::Entry::Type::Call || entry->type == IR::Entry::Type::CallIndirect) {
+			// Liveness also ceases at a procedure call, so that the variable is split around the
+			// call instead of being forced into a callee-saved register
+			live = false;
 		} else if(live) {
-			// Liveness of the symbol must also cease if any variable goes dead.  If it did not
-			// cease at that point, then spilling the variable would not be effective in reducing
-			// register pressure
+			// Liveness of the symbol must also cease if any variable goes dead or becomes live.
+			// If it did not cease at that point, then spilling the variable would not be effective
+			// in reducing register pressure
 			const std::set<const IR::Symbol*> &currentVariables = liveVariables.variables(entry);
 			for(const IR::Symbol *s : liveSet) {
 				if(currentVariables.find(s) == currentVariables.end()) {
@@ -259,6 +636,9 @@ void spillVariable(IR::Procedure &procedure, const IR::Symbol *symbol, Analysis:
 					break;
 				}
 			}
+			if(currentVariables.size() != liveSet.size()) {
+				live = false;
+			}
 			liveSet = currentVariables;
 		}
 	}
@@ -272,9 +652,9 @@ void spillVariable(IR::Procedure &procedure, const IR::Symbol *symbol, Analysis:
 			if(neededDefs.find(entry) != neededDefs.end()) {
 				// The definition is used.  It therefore has to be saved to the stack
 				entryIt++;
-				procedure.entries().insert(entryIt, new IR::EntryThreeAddr(IR::Entry::Type::StoreStack, 0, symbol, 0, idx));
+				procedure.entries().insert(entryIt, procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::StoreStack, nullptr, symbol, nullptr, idx));
 				entryIt--;
-			} else if(spillLoads.find(entry) == spillLoads.end()) {
+			} else if(spillLoads.find(entry) == spillLoads.end() && usedDefs.find(entry) == usedDefs.end()) {
 				// All uses of this definition were rematerialized, so the definition is no
 				// longer necessary at all
 				entryIt--;
@@ -289,13 +669,70 @@ void spillVariable(IR::Procedure &procedure, const IR::Symbol *symbol, Analysis:
 		for(IR::Entry *entry : procedure.entries()) {
 			if(entry->type == IR::Entry::Type::Prologue || entry->type == IR::Entry::Type::Epilogue) {
 				IR::EntryThreeAddr *threeAddr = (IR::EntryThreeAddr*)entry;
-				idx = threeAddr->imm;
-				threeAddr->imm++;
+				threeAddr->imm = idx + 1;
 			}
 		}
 	}
 }
 
+/*!
+ * \brief Spill a set of variables in a procedure to the stack
+ * \param procedure Procedure to modify
+ * \param symbols Symbols to spill
+ * \param liveVariables Live variables in procedure
+ * \param analysis Analysis of procedure
+ * \param splitLiveRanges True if reloads may be hoisted out of loops
+ */
+void spillVariables(IR::Procedure &procedure, const std::vector<const IR::Symbol*> &symbols, Analysis::LiveVariables &liveVariables, Analysis::Analysis &analysis, bool splitLiveRanges)
+{
+	// Complete the analysis of the procedure before spill code begins to modify it
+	analysis.constants();
+	std::unique_ptr<SpillPlacement> placement;
+	if(splitLiveRanges) {
+		placement = std::make_unique<SpillPlacement>(procedure, analysis, liveVariables);
+	}
+
+	for(const IR::Symbol *symbol : symbols) {
+		spillVariable(procedure, symbol, liveVariables, analysis, placement.get());
+	}
+}
+
+/*!
+ * \brief Live interval of a symbol over the linearized procedure
+ */
+struct LiveInterval {
+	const IR::Symbol *symbol; //!< Symbol
+	int start; //!< Position of the first entry at which the symbol is referenced or live
+	int end; //!< Position of the last entry at which the symbol is referenced or live
+	unsigned int forbidden; //!< Mask of registers which the symbol may not occupy
+	int reg; //!< Register assigned to the symbol
+};
+
+/*!
+ * \brief Forbid a set of symbols from occupying a set of registers
+ * \param intervals Live intervals, indexed by symbol id
+ * \param symbols Symbols to modify
+ * \param mask Mask of registers to forbid
+ * \param exclude Symbol to exclude from the above symbol set, for convenience
+ */
+void forbidRegisters(std::vector<LiveInterval> &intervals, const std::set<const IR::Symbol*> &symbols, unsigned int mask, const IR::Symbol *exclude)
+{
+	for(const IR::Symbol *symbol : symbols) {
+		if(symbol != exclude) {
+			intervals[symbol->id].forbidden |= mask;
+		}
+	}
+}
+
+/*!
+ * \brief Constructor
+ * \param mode Allocation strategy
+ */
+RegisterAllocator::RegisterAllocator(Mode mode)
+	: mMode(mode)
+{
+}
+
 /*!
  * \brief Allocate registers for a procedure
  * \param procedure Procedure to analyze
@@ -305,117 +742,198 @@ std::map<const IR::Symbol*, int> RegisterAllocator::allocate(IR::Procedure &proc
 {
 	std::map<const IR::Symbol*, int> registers;
 	bool success;
+	int round = 0;
 
 	Analysis::Analysis analysis(procedure);
 
+	// Choose an allocation strategy for this procedure
+	Mode mode = mMode;
+	if(mode == Mode::Auto) {
+		int size = 0;
+		for(IR::EntryList::iterator it = procedure.entries().begin(); it != procedure.entries().end(); it++) {
+			size++;
+		}
+
+		mode = (size > LinearScanThreshold) ? Mode::LinearScan : Mode::Coloring;
+	}
+
+	mSplitCopies = splitArgumentLiveRanges(procedure, analysis);
+
 	do {
 		Transform::LiveRangeRenaming::instance()->transform(procedure, analysis);
 
-		// Attempt an allocation
-		registers = tryAllocate(procedure, success, analysis);
+		// Attempt an allocation.  Live ranges are only split during the first round, so that
+		// any later rounds are guaranteed to make progress by spilling everywhere
+		bool splitLiveRanges = (round == 0);
+		if(mode == Mode::LinearScan) {
+			registers = tryAllocateLinearScan(procedure, success, analysis, splitLiveRanges);
+		} else {
+			registers = tryAllocate(procedure, success, analysis, splitLiveRanges);
+		}
+		round++;
 
 		if(!success) {
+			// Spilling inserted new entries, so any cached analysis is now out of date
+			analysis.invalidate();
+
 			Util::log("ir") << "*** IR (after spilling) ***" << std::endl;
 			procedure.print(Util::log("ir"));
 			Util::log("ir") << std::endl;
 		}
 	} while(!success);
 
+	// Count the moves whose source and destination ended up in the same register, since
+	// no code will be generated for them
+	int eliminatedMoves = 0;
+	for(IR::Entry *entry : procedure.entries()) {
+		IR::EntryThreeAddr *threeAddr = (IR::EntryThreeAddr*)entry;
+		if(entry->type == IR::Entry::Type::Move && threeAddr->rhs1 && registers[threeAddr->lhs] == registers[threeAddr->rhs1]) {
+			eliminatedMoves++;
+		}
+	}
+	Util::log("opt") << "Register allocation (" << procedure.name() << "): " << eliminatedMoves << " moves eliminated" << std::endl;
+
 	return registers;
 }
 
 /*!
  * \brief Attempt to allocate registers for a procedure
+ *
+ * Symbols which may need to be spilled are colored optimistically, and only those which
+ * end up without a register are spilled.  The entire set is spilled at once, after which
+ * allocation must be attempted again.
  * \param procedure Procedure to analyze
  * \param success [out] True if allocation was successful
+ * \param analysis Analysis of procedure
+ * \param splitLiveRanges True if spilled live ranges may be split around loops
  * \return Map from symbol to register number
  */
-std::map<const IR::Symbol*, int> RegisterAllocator::tryAllocate(IR::Procedure &procedure, bool &success, Analysis::Analysis &analysis)
+std::map<const IR::Symbol*, int> RegisterAllocator::tryAllocate(IR::Procedure &procedure, bool &success, Analysis::Analysis &analysis, bool splitLiveRanges)
 {
 	std::map<const IR::Symbol*, int> registers;
 
-	// Construct an interference graph, live variable list, and use-def chains for the procedure
+	// Construct a live variable list and use-def chains for the procedure
 	Analysis::LiveVariables liveVariables(procedure, analysis.flowGraph());
-	Analysis::InterferenceGraph graph(procedure, liveVariables);
 	const Analysis::UseDefs &useDefs = analysis.useDefs();
 
-	// Construct artificial graph nodes for each register which is not preserved across procedure calls
+	// Construct artificial symbols for each register which is not preserved across procedure calls.
+	// These are precolored, and are never simplified out of the graph
 	std::vector<const IR::Symbol*> callerSavedRegisters;
 	for(int i=0; i<CallerSavedRegisters; i++) {
 		std::stringstream s;
 		s << "arg" << i;
-		std::unique_ptr<IR::Symbol> symbol = std::make_unique<IR::Symbol>(s.str(), 4, nullptr);
-		registers[symbol.get()] = i;
-		callerSavedRegisters.push_back(symbol.get());
-		procedure.addSymbol(std::move(symbol));
+		IR::Symbol *symbol = procedure.newSymbol(s.str(), 4, nullptr);
+		registers[symbol] = i;
+		callerSavedRegisters.push_back(symbol);
+		procedure.addSymbol(symbol);
 	}
 
-	// Add graph edges for all variables live across procedure calls
+	// Construct an interference graph, and add graph edges for all variables live across procedure calls
+	Analysis::InterferenceGraph graph(procedure, liveVariables);
 	addProcedureCallInterferences(graph, callerSavedRegisters, procedure, liveVariables);
 
+	// Keep split argument live ranges apart, so that coalescing does not undo the split
+	for(IR::Entry *entry : procedure.entries()) {
+		if(mSplitCopies.find(entry) != mSplitCopies.end()) {
+			IR::EntryThreeAddr *copy = (IR::EntryThreeAddr*)entry;
+			graph.addEdge(copy->lhs, copy->rhs1);
+		}
+	}
+
+	// Merge move-related symbols wherever it is safe to do so
+	coalesceMoves(graph, registers);
+
 	// Estimate spill costs for each symbol in the procedure
 	std::map<const IR::Symbol*, int> spillCosts = getSpillCosts(procedure, analysis.flowGraph());
 
-	// Build a copy of the graph, so that it can be simplified
+	// Sort the symbols into those which can be trivially simplified, and those which may need to be spilled
+	std::vector<const IR::Symbol*> simplifyWorklist;
+	std::vector<const IR::Symbol*> spillWorklist;
+	std::vector<bool> inSpillWorklist(procedure.numSymbolIds(), false);
+	for(const IR::Symbol *symbol : graph.symbols()) {
+		if(registers.find(symbol) != registers.end() || graph.removed(symbol)) {
+			continue;
+		}
+
+		if(graph.degree(symbol) < MaxRegisters) {
+			simplifyWorklist.push_back(symbol);
+		} else {
+			spillWorklist.push_back(symbol);
+			inSpillWorklist[symbol->id] = true;
+		}
+	}
+
 	std::vector<const IR::Symbol*> stack;
-	Analysis::InterferenceGraph simplifiedGraph(graph);
-	bool spilled = false;
 
 	// Operate on the graph until all nodes have been removed
-	while(simplifiedGraph.symbols().size() > 0) {
-		bool removed = false;
-		const IR::Symbol *spillCandidate = 0;
-
-		// Iterate through the list of symbols in the procedure
-		for(const IR::Symbol *symbol : simplifiedGraph.symbols()) {
-			// If the symbol has a lower spill cost than the previous spill candidate, save
-			// it off as the new spill candidate
-			if(!spillCandidate || spillCosts[symbol] < spillCosts[spillCandidate]) {
-				spillCandidate = symbol;
-			}
-
-			// Check the set of interferences for this symbol
-			const std::set<const IR::Symbol*> &set = simplifiedGraph.interferences(symbol);
-			if(set.size() < MaxRegisters) {
-				// If the symbol has less than MaxRegister interferences, then it can be safely
-				// removed from the graph, since there will always be a register available to
-				// assign to it
-				simplifiedGraph.removeSymbol(symbol);
-				stack.push_back(symbol);
-				removed = true;
-				break;
+	while(!simplifyWorklist.empty() || !spillWorklist.empty()) {
+		const IR::Symbol *symbol;
+
+		if(!simplifyWorklist.empty()) {
+			// If the symbol has less than MaxRegister interferences, then it can be safely
+			// removed from the graph, since there will always be a register available to
+			// assign to it
+			symbol = simplifyWorklist.back();
+			simplifyWorklist.pop_back();
+		} else {
+			// If no variable could be removed from the graph, then one may need to be spilled.
+			// Remove the variable with the lowest spill cost, in the hope that a register will
+			// still be available for it once its neighbors are colored.  Entries which have
+			// since moved to the simplify worklist are discarded first.
+			spillWorklist.erase(std::remove_if(spillWorklist.begin(), spillWorklist.end(), [&](const IR::Symbol *s) { return !inSpillWorklist[s->id]; }), spillWorklist.end());
+			if(spillWorklist.empty()) {
+				continue;
 			}
-		}
 
-		if(!removed) {
-			// If no variable could be removed from the graph, then one needs to be spilled.
-			// Spill the variable with the lowest spill cost that was determined above
-			spillVariable(procedure, spillCandidate, liveVariables, analysis);
-			simplifiedGraph.removeSymbol(spillCandidate);
-			stack.push_back(spillCandidate);
-			spilled = true;
+			std::vector<const IR::Symbol*>::iterator candidate = std::min_element(spillWorklist.begin(), spillWorklist.end(), [&](const IR::Symbol *a, const IR::Symbol *b) { return spillCosts[a] < spillCosts[b]; });
+			symbol = *candidate;
+			spillWorklist.erase(candidate);
+			inSpillWorklist[symbol->id] = false;
 		}
-	}
 
-	if(spilled) {
-		// If a variable was spilled, the entire allocation procedure must be attempted again
-		success = false;
-		return registers;
+		// Remove the symbol from the graph.  Any neighbor whose degree drops below MaxRegisters
+		// as a result can now be simplified
+		graph.removeSymbol(symbol);
+		stack.push_back(symbol);
+		for(const IR::Symbol *neighbor : graph.interferences(symbol)) {
+			if(inSpillWorklist[neighbor->id] && graph.degree(neighbor) < MaxRegisters) {
+				inSpillWorklist[neighbor->id] = false;
+				simplifyWorklist.push_back(neighbor);
+			}
+		}
 	}
 
 	// Determine which variables have a preferred register
 	std::map<const IR::Symbol*, int> preferredRegisters = getPreferredRegisters(procedure);
 
+	// A coalesced node prefers the register that its members prefer, provided they agree
+	for(const IR::Symbol *symbol : graph.symbols()) {
+		const IR::Symbol *alias = graph.alias(symbol);
+		auto preferredIt = preferredRegisters.find(symbol);
+		if(alias == symbol || preferredIt == preferredRegisters.end()) {
+			continue;
+		}
+
+		auto aliasIt = preferredRegisters.find(alias);
+		if(aliasIt == preferredRegisters.end()) {
+			preferredRegisters[alias] = preferredIt->second;
+		} else if(aliasIt->second != preferredIt->second) {
+			aliasIt->second = -1;
+		}
+	}
+
 	// Reconstruct the graph by playing the stack in reverse
+	std::set<const IR::Symbol*> spilledSymbols;
 	while(!stack.empty()) {
 		const IR::Symbol *symbol = stack.back();
 		stack.pop_back();
 
 		// Find the set of interfering symbols for this one
-		const std::set<const IR::Symbol*> &set = graph.interferences(symbol);
+		const std::vector<const IR::Symbol*> &set = graph.interferences(symbol);
 
 		// Find a register which is not used by any of the interfering symbols.  This is
-		// guaranteed to be possible by the way that the stack was constructed above.
+		// guaranteed to be possible unless the symbol was removed as a spill candidate.
+		bool colored = false;
 		for(int i=-1; i<MaxRegisters; i++) {
 			bool found = false;
 
@@ -442,9 +960,198 @@ std::map<const IR::Symbol*, int> RegisterAllocator::tryAllocate(IR::Procedure &p
 			if(!found) {
 				// An available register was found.  Assign the symbol to it.
 				registers[symbol] = reg;
+				colored = true;
+				break;
+			}
+		}
+
+		if(!colored) {
+			spilledSymbols.insert(symbol);
+		}
+	}
+
+	if(!spilledSymbols.empty()) {
+		// Spill each symbol which could not be colored, along with any symbols which were
+		// coalesced into it.  The entire allocation procedure must then be attempted again
+		std::vector<const IR::Symbol*> spills;
+		for(const IR::Symbol *symbol : graph.symbols()) {
+			if(spilledSymbols.find(graph.alias(symbol)) != spilledSymbols.end()) {
+				spills.push_back(symbol);
+			}
+		}
+
+		spillVariables(procedure, spills, liveVariables, analysis, splitLiveRanges);
+		success = false;
+		return registers;
+	}
+
+	// Coalesced symbols share the register of the node they were merged into
+	for(const IR::Symbol *symbol : graph.symbols()) {
+		const IR::Symbol *alias = graph.alias(symbol);
+		if(alias != symbol) {
+			registers[symbol] = registers[alias];
+		}
+	}
+
+	success = true;
+	return registers;
+}
+
+/*!
+ * \brief Attempt to allocate registers for a procedure using linear scan
+ *
+ * The procedure's entries are numbered in layout order, and each symbol is given a single
+ * interval spanning every position at which it is referenced or live.  Intervals are then
+ * visited in order of their start position, and each is given any register not held by an
+ * overlapping interval.  When no register is available, the interval which ends furthest
+ * away is spilled.  All spills found in one pass are performed together.
+ * \param procedure Procedure to analyze
+ * \param success [out] True if allocation was successful
+ * \param analysis Analysis of procedure
+ * \param splitLiveRanges True if spilled live ranges may be split around loops
+ * \return Map from symbol to register number
+ */
+std::map<const IR::Symbol*, int> RegisterAllocator::tryAllocateLinearScan(IR::Procedure &procedure, bool &success, Analysis::Analysis &analysis, bool splitLiveRanges)
+{
+	std::map<const IR::Symbol*, int> registers;
+
+	Analysis::LiveVariables liveVariables(procedure, analysis.flowGraph());
+
+	std::vector<LiveInterval> intervals(procedure.numSymbolIds(), LiveInterval{nullptr, -1, -1, 0, -1});
+	auto extend = [&](const IR::Symbol *symbol, int position) {
+		LiveInterval &interval = intervals[symbol->id];
+		if(interval.start == -1) {
+			interval.symbol = symbol;
+			interval.start = position;
+		}
+		interval.end = position;
+	};
+
+	const unsigned int callerSavedMask = (1u << CallerSavedRegisters) - 1;
+
+	// Walk the procedure in layout order, building the live intervals and recording which
+	// symbols may not occupy the registers clobbered by calls and argument passing
+	int position = 0;
+	for(IR::Entry *entry : procedure.entries()) {
+		IR::EntryThreeAddr *threeAddr = (IR::EntryThreeAddr*)entry;
+		const std::set<const IR::Symbol*> &variables = liveVariables.variables(entry);
+
+		for(const IR::Symbol *symbol : variables) {
+			extend(symbol, position);
+		}
+
+		for(const IR::Symbol *symbol : entry->useOperands()) {
+			extend(symbol, position);
+		}
+
+		for(const IR::Symbol *symbol : entry->defOperands()) {
+			extend(symbol, position);
+		}
+
+		switch(entry->type) {
+			case IR::Entry::Type::Call:
+				forbidRegisters(intervals, variables, callerSavedMask, nullptr);
+				break;
+
+			case IR::Entry::Type::LoadRet:
+				forbidRegisters(intervals, variables, 1u, threeAddr->lhs);
+				break;
+
+			case IR::Entry::Type::StoreRet:
+				forbidRegisters(intervals, variables, 1u, threeAddr->rhs1);
 				break;
+
+			case IR::Entry::Type::LoadArg:
+				forbidRegisters(intervals, variables, 1u << threeAddr->imm, threeAddr->lhs);
+				break;
+
+			case IR::Entry::Type::StoreArg:
+				forbidRegisters(intervals, variables, 1u << threeAddr->imm, threeAddr->rhs1);
+				break;
+
+			default:
+				break;
+		}
+
+		position++;
+	}
+
+	// Sort the intervals by start position
+	std::vector<LiveInterval*> sorted;
+	for(IR::Symbol *symbol : procedure.symbols()) {
+		if(intervals[symbol->id].start != -1) {
+			sorted.push_back(&intervals[symbol->id]);
+		}
+	}
+	std::stable_sort(sorted.begin(), sorted.end(), [](const LiveInterval *a, const LiveInterval *b) { return a->start < b->start; });
+
+	std::map<const IR::Symbol*, int> preferredRegisters = getPreferredRegisters(procedure);
+	std::vector<LiveInterval*> active;
+	std::vector<const IR::Symbol*> spills;
+	unsigned int freeRegisters = (1u << MaxRegisters) - 1;
+
+	for(LiveInterval *interval : sorted) {
+		// Expire any intervals which ended before this one begins, returning their registers
+		for(std::vector<LiveInterval*>::iterator it = active.begin(); it != active.end();) {
+			if((*it)->end < interval->start) {
+				freeRegisters |= 1u << (*it)->reg;
+				it = active.erase(it);
+			} else {
+				it++;
 			}
 		}
+
+		// Pick the preferred register if it is available, or else the lowest available one
+		unsigned int available = freeRegisters & ~interval->forbidden;
+		int reg = -1;
+		auto preferredIt = preferredRegisters.find(interval->symbol);
+		if(preferredIt != preferredRegisters.end() && preferredIt->second != -1 && (available & (1u << preferredIt->second))) {
+			reg = preferredIt->second;
+		} else {
+			for(int i=0; i<MaxRegisters; i++) {
+				if(available & (1u << i)) {
+					reg = i;
+					break;
+				}
+			}
+		}
+
+		if(reg == -1) {
+			// No register is available.  Spill whichever interval ends furthest away, out of
+			// this one and the active intervals holding a register that this one could use
+			LiveInterval *victim = interval;
+			for(LiveInterval *other : active) {
+				if(!(interval->forbidden & (1u << other->reg)) && other->end > victim->end) {
+					victim = other;
+				}
+			}
+
+			spills.push_back(victim->symbol);
+			if(victim == interval) {
+				continue;
+			}
+
+			// Take over the victim's register
+			reg = victim->reg;
+			active.erase(std::find(active.begin(), active.end(), victim));
+		} else {
+			freeRegisters &= ~(1u << reg);
+		}
+
+		interval->reg = reg;
+		active.push_back(interval);
+	}
+
+	if(spills.size() > 0) {
+		// Spill all of the chosen variables, after which allocation must be attempted again
+		spillVariables(procedure, spills, liveVariables, analysis, splitLiveRanges);
+
+		success = false;
+		return registers;
+	}
+
+	for(LiveInterval *interval : sorted) {
+		registers[interval->symbol] = interval->reg;
 	}
 
 	success = true;
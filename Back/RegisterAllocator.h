@@ -7,6 +7,7 @@
 #include "IR/Procedure.h"
 
 #include <map>
+#include <set>
 
 namespace Back {
 
@@ -15,17 +16,39 @@ namespace Back {
  *
  * The register allocator takes into account variables which are simultaneously live,
  * and ensures they are placed in different registers.  If there are more live variables
- * than available registers, it picks symbols to spill to the stack until an allocation
- * can be performed.  It also takes into account the registers which are not preserved
+ * than available registers, it picks a set of symbols to spill to the stack, and repeats
+ * until an allocation can be performed.  It also takes into account the registers which are not preserved
  * across procedure calls, and ensures that variables are not placed into them if their
  * value is necessary across a procedure call.
+ *
+ * Two allocation strategies are available.  Graph coloring produces the best allocation,
+ * but rebuilds an interference graph on every round and can be slow on large procedures.
+ * Linear scan assigns registers in a single pass over live intervals, trading some
+ * allocation quality for compile speed.
  */
 class RegisterAllocator {
 public:
+	/*!
+	 * \brief Allocation strategy
+	 */
+	enum class Mode {
+		Coloring, //!< Iterated graph coloring
+		LinearScan, //!< Linear scan over live intervals
+		Auto //!< Linear scan for procedures larger than LinearScanThreshold, coloring otherwise
+	};
+
+	static const int LinearScanThreshold = 1000; //!< Entry count above which Auto mode uses linear scan
+
+	RegisterAllocator(Mode mode = Mode::Auto);
+
 	std::map<const IR::Symbol*, int> allocate(IR::Procedure &procedure);
 
 private:
-	std::map<const IR::Symbol*, int> tryAllocate(IR::Procedure &procedure, bool &success, Analysis::Analysis &analysis);
+	std::map<const IR::Symbol*, int> tryAllocate(IR::Procedure &procedure, bool &success, Analysis::Analysis &analysis, bool splitLiveRanges);
+	std::map<const IR::Symbol*, int> tryAllocateLinearScan(IR::Procedure &procedure, bool &success, Analysis::Analysis &analysis, bool splitLiveRanges);
+
+	Mode mMode; //!< Allocation strategy
+	std::set<const IR::Entry*> mSplitCopies; //!< Copies inserted to split argument live ranges
 };
 
 }
@@ -0,0 +1,387 @@
+#include "Builder.h"
+#include "Linker.h"
+
+#include "VM/MappedFile.h"
+
+#include "Util/Log.h"
+#include "Util/Hash.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <optional>
+#include <sstream>
+#include <thread>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+/*!
+ * \brief Identify the running compiler by a hash of its executable.  This is included in every
+ * cache key, so that units cached by a differently-built compiler are never reused
+ * \param hash Set to the hash of the executable
+ * \return True if success, false if the executable could not be read
+ */
+static bool compilerIdentity(uint64_t &hash)
+{
+	static const std::optional<uint64_t> identity = []() -> std::optional<uint64_t> {
+#ifdef _WIN32
+		char path[MAX_PATH];
+		DWORD length = GetModuleFileNameA(0, path, MAX_PATH);
+		if(length == 0 || length == MAX_PATH) {
+			return std::nullopt;
+		}
+		VM::MappedFile executable(std::string(path, length));
+#else
+		VM::MappedFile executable("/proc/self/exe");
+#endif
+		if(!executable.valid()) {
+			return std::nullopt;
+		}
+
+		Util::Hash hash;
+		hash.add(executable.data().data(), executable.data().size());
+		return hash.value();
+	}();
+
+	if(!identity) {
+		return false;
+	}
+
+	hash = *identity;
+	return true;
+}
+
+/*!
+ * \brief Constructor
+ * \param numThreads Number of worker threads, or 0 to use one per hardware thread
+ */
+Builder::Builder(unsigned int numThreads)
+{
+	mNumThreads = numThreads;
+	if(mNumThreads == 0) {
+		mNumThreads = std::max(std::thread::hardware_concurrency(), 1u);
+	}
+
+	mNumCompiled = 0;
+	mError = false;
+}
+
+/*!
+ * \brief Report an error
+ * \param message Error message
+ */
+void Builder::setError(const std::string &message)
+{
+	// Keep the first error, since later ones may only be a consequence of it
+	if(!mError) {
+		mError = true;
+		mErrorMessage = message;
+	}
+}
+
+/*!
+ * \brief Add a source file to the build
+ * \param filename Source filename
+ * \param imports Modules imported by the file, each either the filename of another unit or a .orc file
+ * \param wholeProgram True if no other module will extend the classes visible to this one
+ */
+void Builder::addUnit(const std::string &filename, const std::vector<std::string> &imports, bool wholeProgram)
+{
+	std::unique_ptr<Unit> unit = std::make_unique<Unit>();
+	unit->filename = filename;
+	unit->library = false;
+	unit->imports = imports;
+	unit->wholeProgram = wholeProgram;
+	unit->numPending = 0;
+
+	mUnitNames[filename] = unit.get();
+	mUnits.push_back(std::move(unit));
+}
+
+/*!
+ * \brief Add an already-compiled module to the build.  Units may import it by filename, and it is
+ * linked into the result along with the compiled units
+ * \param filename Module filename
+ */
+void Builder::addLibrary(const std::string &filename)
+{
+	std::unique_ptr<Unit> unit = std::make_unique<Unit>();
+	unit->filename = filename;
+	unit->library = true;
+	unit->wholeProgram = false;
+	unit->numPending = 0;
+
+	mUnitNames[filename] = unit.get();
+	mUnits.push_back(std::move(unit));
+}
+
+/*!
+ * \brief Build the dependency graph between units, and load the export info of imported .orc files
+ * \return True if success
+ */
+bool Builder::resolveImports()
+{
+	for(std::unique_ptr<Unit> &unit : mUnits) {
+		if(unit->library) {
+			unit->program = std::make_unique<VM::Program>();
+			if(!unit->program->open(unit->filename)) {
+				std::stringstream s;
+				s << unit->filename << ": Could not read module" << std::endl;
+				setError(s.str());
+				return false;
+			}
+			continue;
+		}
+
+		for(const std::string &import : unit->imports) {
+			auto it = mUnitNames.find(import);
+			if(it != mUnitNames.end() && it->second->library) {
+				continue;
+			} else if(it != mUnitNames.end()) {
+				it->second->dependents.push_back(unit.get());
+				unit->numPending++;
+			} else if(mOrcImports.find(import) == mOrcImports.end()) {
+				mOrcImports[import] = Compiler::readExportInfo(import);
+			}
+		}
+	}
+
+	// Check that the graph can be ordered, by repeatedly removing units with no
+	// remaining dependencies
+	std::map<Unit*, unsigned int> numPending;
+	std::vector<Unit*> ready;
+	for(std::unique_ptr<Unit> &unit : mUnits) {
+		numPending[unit.get()] = unit->numPending;
+		if(unit->numPending == 0) {
+			ready.push_back(unit.get());
+		}
+	}
+
+	unsigned int numOrdered = 0;
+	while(!ready.empty()) {
+		Unit *unit = ready.back();
+		ready.pop_back();
+		numOrdered++;
+		for(Unit *dependent : unit->dependents) {
+			if(--numPending[dependent] == 0) {
+				ready.push_back(dependent);
+			}
+		}
+	}
+
+	if(numOrdered < mUnits.size()) {
+		for(std::unique_ptr<Unit> &unit : mUnits) {
+			if(numPending[unit.get()] > 0) {
+				std::stringstream s;
+				s << unit->filename << ": Import cycle" << std::endl;
+				setError(s.str());
+				break;
+			}
+		}
+		return false;
+	}
+
+	return true;
+}
+
+/*!
+ * \brief Compile a single unit against the export info of its imports
+ * \param unit Unit to compile
+ */
+void Builder::compileUnit(Unit &unit)
+{
+	std::vector<std::reference_wrapper<Front::ExportInfo>> importList;
+	for(const std::string &import : unit.imports) {
+		auto it = mUnitNames.find(import);
+		if(it != mUnitNames.end()) {
+			importList.push_back(*it->second->program->exportInfo);
+		} else {
+			importList.push_back(*mOrcImports[import]);
+		}
+	}
+
+	Util::LogCapture logCapture;
+	std::string errorMessage;
+	std::unique_ptr<VM::Program> program = compileProgram(unit, importList, errorMessage);
+	unit.log = logCapture.str();
+
+	std::lock_guard<std::mutex> lock(mMutex);
+	if(!program) {
+		std::stringstream s;
+		s << unit.filename << ": " << errorMessage;
+		setError(s.str());
+	} else {
+		unit.program = std::move(program);
+		for(Unit *dependent : unit.dependents) {
+			if(--dependent->numPending == 0) {
+				mReady.push_back(dependent);
+			}
+		}
+	}
+
+	mNumCompiled++;
+	mCondition.notify_all();
+}
+
+/*!
+ * \brief Produce the program for a unit, either by loading it from the cache or by compiling it
+ * \param unit Unit to compile
+ * \param importList Export info of the unit's imports
+ * \param errorMessage Set to the compiler's error message on failure
+ * \return Program, or 0 on error
+ */
+std::unique_ptr<VM::Program> Builder::compileProgram(Unit &unit, const std::vector<std::reference_wrapper<Front::ExportInfo>> &importList, std::string &errorMessage)
+{
+	std::string filename;
+	if(!mCacheDirectory.empty()) {
+		// A cached file which fails verification is simply rebuilt and replaced
+		filename = cacheFilename(unit, importList);
+		if(!filename.empty() && std::filesystem::exists(filename)) {
+			std::unique_ptr<VM::Program> program = std::make_unique<VM::Program>();
+			if(program->open(filename)) {
+				Util::log("asm") << "*** " << unit.filename << ": Loaded from cache (" << filename << ") ***" << std::endl;
+				return program;
+			}
+		}
+	}
+
+	Compiler compiler;
+	compiler.setOptions(mOptions);
+	std::unique_ptr<VM::Program> program = compiler.compile(unit.filename, importList, unit.wholeProgram);
+	if(!program) {
+		errorMessage = compiler.errorMessage();
+		return 0;
+	}
+
+	if(!filename.empty()) {
+		// Write the file under a temporary name and then rename it into place, so that the
+		// cache never contains a partially-written file.  Failure to update the cache is
+		// not an error, since it only costs a recompile later
+		std::error_code error;
+		std::filesystem::create_directories(mCacheDirectory, error);
+
+		std::stringstream s;
+		s << filename << ".tmp" << std::this_thread::get_id();
+		std::string tempFilename = s.str();
+		program->write(tempFilename);
+		std::filesystem::rename(tempFilename, filename, error);
+		if(error) {
+			std::filesystem::remove(tempFilename, error);
+		}
+	}
+
+	return program;
+}
+
+/*!
+ * \brief Determine the cache filename for a unit, based on everything which affects its compilation
+ * \param unit Unit to compile
+ * \param importList Export info of the unit's imports
+ * \return Cache filename, or empty if the unit's source or the compiler executable could not be read
+ */
+std::string Builder::cacheFilename(Unit &unit, const std::vector<std::reference_wrapper<Front::ExportInfo>> &importList)
+{
+	uint64_t identity;
+	if(!compilerIdentity(identity)) {
+		return "";
+	}
+
+	std::ifstream stream(unit.filename.c_str(), std::ios_base::in | std::ios_base::binary);
+	if(stream.fail()) {
+		return "";
+	}
+	std::string source((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+
+	Util::Hash hash;
+	hash.addValue(identity);
+	hash.addValue(unit.wholeProgram);
+	hash.addValue((uint64_t)mOptions.allocatorMode);
+	hash.addValue((uint64_t)mOptions.unrollFactor);
+	hash.add(source);
+	hash.addValue(importList.size());
+	for(Front::ExportInfo &exportInfo : importList) {
+		hash.add(exportInfo.data());
+		hash.add(exportInfo.strings());
+	}
+
+	std::stringstream s;
+	s << std::hex << std::setw(16) << std::setfill('0') << hash.value();
+	return (std::filesystem::path(mCacheDirectory) / (s.str() + ".orc")).string();
+}
+
+/*!
+ * \brief Worker thread body, compiling units as they become ready until the build ends
+ */
+void Builder::runWorker()
+{
+	while(true) {
+		Unit *unit;
+		{
+			std::unique_lock<std::mutex> lock(mMutex);
+			mCondition.wait(lock, [&] { return !mReady.empty() || mError || mNumCompiled == mUnits.size(); });
+			if(mError || mReady.empty()) {
+				return;
+			}
+
+			unit = mReady.front();
+			mReady.pop_front();
+		}
+
+		compileUnit(*unit);
+	}
+}
+
+/*!
+ * \brief Compile all units, and link them together in the order they were added
+ * \return Linked program, or 0 on error
+ */
+std::unique_ptr<VM::Program> Builder::build()
+{
+	if(!resolveImports()) {
+		return 0;
+	}
+
+	for(std::unique_ptr<Unit> &unit : mUnits) {
+		if(unit->library) {
+			mNumCompiled++;
+		} else if(unit->numPending == 0) {
+			mReady.push_back(unit.get());
+		}
+	}
+
+	std::vector<std::thread> workers;
+	unsigned int numWorkers = std::min(mNumThreads, (unsigned int)mUnits.size());
+	for(unsigned int i=0; i<numWorkers; i++) {
+		workers.emplace_back(&Builder::runWorker, this);
+	}
+
+	for(std::thread &worker : workers) {
+		worker.join();
+	}
+
+	// Write out each unit's log in order, so that output does not depend on scheduling
+	for(std::unique_ptr<Unit> &unit : mUnits) {
+		std::cout << unit->log;
+	}
+
+	if(mError) {
+		return 0;
+	}
+
+	std::vector<std::reference_wrapper<const VM::Program>> programList;
+	for(std::unique_ptr<Unit> &unit : mUnits) {
+		programList.push_back(*unit->program);
+	}
+
+	Linker linker;
+	std::unique_ptr<VM::Program> linked = linker.link(programList);
+	if(!linked) {
+		setError(linker.errorMessage());
+		return 0;
+	}
+
+	return linked;
+}
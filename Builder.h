@@ -0,0 +1,84 @@
+#ifndef BUILDER_H
+#define BUILDER_H
+
+#include "Compiler.h"
+
+#include "VM/Program.h"
+
+#include "Front/ExportInfo.h"
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/*!
+ * \brief Build driver which compiles a set of source files and links the results
+ *
+ * Each unit lists the modules it imports, which are either other units of the
+ * build or compiled .orc files.  The imports form a dependency graph, and units
+ * are compiled on a pool of worker threads as soon as the export info of every
+ * unit they import is available, so independent units compile concurrently.
+ *
+ * If a cache directory is set, each compiled unit is stored there as a .orc
+ * file, keyed by a hash of everything which can affect its compilation: its
+ * source text, the export info of its imports, the compiler options and the
+ * compiler executable itself.  A unit whose key is already present is loaded
+ * rather than recompiled, so none of the parse, IR or assembly logs are
+ * produced for it; the assembly log notes that it came from the cache instead.
+ */
+class Builder {
+public:
+	Builder(unsigned int numThreads = 0);
+
+	void addUnit(const std::string &filename, const std::vector<std::string> &imports, bool wholeProgram = false);
+	void addLibrary(const std::string &filename);
+	void setCacheDirectory(const std::string &directory) { mCacheDirectory = directory; } //!< Set directory for cached units, or empty to disable caching
+	void setOptions(const Compiler::Options &options) { mOptions = options; } //!< Set options used to compile every unit
+	std::unique_ptr<VM::Program> build();
+
+	bool error() { return mError; }
+	const std::string &errorMessage() { return mErrorMessage; }
+
+private:
+	/*!
+	 * \brief A source file to be compiled
+	 */
+	struct Unit {
+		std::string filename; //!< Source filename, or .orc filename for a library
+		bool library; //!< True if the unit is an already-compiled .orc file
+		std::vector<std::string> imports; //!< Names of imported units and .orc files
+		bool wholeProgram; //!< True if no other module will extend the unit's classes
+		std::vector<Unit*> dependents; //!< Units which import this unit
+		unsigned int numPending; //!< Number of dependencies not yet compiled
+		std::unique_ptr<VM::Program> program; //!< Compiled program
+		std::string log; //!< Log output produced while compiling
+	};
+
+	void setError(const std::string &message);
+	bool resolveImports();
+	void runWorker();
+	void compileUnit(Unit &unit);
+	std::unique_ptr<VM::Program> compileProgram(Unit &unit, const std::vector<std::reference_wrapper<Front::ExportInfo>> &importList, std::string &errorMessage);
+	std::string cacheFilename(Unit &unit, const std::vector<std::reference_wrapper<Front::ExportInfo>> &importList);
+
+	unsigned int mNumThreads; //!< Number of worker threads
+	std::string mCacheDirectory; //!< Directory holding cached units, or empty if caching is disabled
+	Compiler::Options mOptions; //!< Options used to compile every unit
+	std::vector<std::unique_ptr<Unit>> mUnits; //!< Units, in the order they are linked
+	std::map<std::string, Unit*> mUnitNames; //!< Units, keyed by source filename
+	std::map<std::string, std::unique_ptr<Front::ExportInfo>> mOrcImports; //!< Export info of each imported .orc file
+
+	std::mutex mMutex; //!< Guards the scheduling state below
+	std::condition_variable mCondition; //!< Signalled when a unit becomes ready or the build ends
+	std::deque<Unit*> mReady; //!< Units whose dependencies have all been compiled
+	unsigned int mNumCompiled; //!< Number of units compiled so far
+
+	bool mError;
+	std::string mErrorMessage;
+};
+
+#endif
@@ -6,16 +6,16 @@
 #include "Front/ProgramGenerator.h"
 #include "Front/IRGenerator.h"
 #include "Front/ExportInfo.h"
+#include "Front/ClassHierarchy.h"
 
 #include "Middle/Optimizer.h"
 #include "Middle/ErrorCheck.h"
 
 #include "Back/CodeGenerator.h"
+#include "Back/MachineCode.h"
 
 #include "Util/Log.h"
 
-#include "Assembler.h"
-
 #include <fstream>
 #include <sstream>
 
@@ -40,34 +40,58 @@ void Compiler::setError(const std::string &message)
 /*!
  * \brief Compile a program
  * \param filename Input filename
+ * \param importFilenames Modules to import
+ * \param wholeProgram True if no other module will extend the classes visible to this one
  * \return Compiled program
  */
-std::unique_ptr<VM::Program> Compiler::compile(const std::string &filename, const std::vector<std::string> &importFilenames)
+std::unique_ptr<VM::Program> Compiler::compile(const std::string &filename, const std::vector<std::string> &importFilenames, bool wholeProgram)
+{
+	std::vector<std::unique_ptr<Front::ExportInfo>> imports;
+	std::vector<std::reference_wrapper<Front::ExportInfo>> importList;
+	for(unsigned int i=0; i<importFilenames.size(); i++) {
+		std::unique_ptr<Front::ExportInfo> exportInfo = readExportInfo(importFilenames[i]);
+		importList.push_back(*exportInfo);
+		imports.push_back(std::move(exportInfo));
+	}
+
+	return compile(filename, importList, wholeProgram);
+}
+
+/*!
+ * \brief Read the export info from a compiled module
+ * \param filename Module filename
+ * \return Export info
+ */
+std::unique_ptr<Front::ExportInfo> Compiler::readExportInfo(const std::string &filename)
+{
+	VM::OrcFile importFile(filename);
+	const VM::OrcFile::Section *exportInfoSection = importFile.section("export_info");
+	const VM::OrcFile::Section *exportInfoStringsSection = importFile.section("export_info.strings");
+	return std::make_unique<Front::ExportInfo>(exportInfoSection->contents(), exportInfoStringsSection->contents());
+}
+
+/*!
+ * \brief Compile a program against export info which has already been loaded
+ * \param filename Input filename
+ * \param importList Export info of modules to import
+ * \param wholeProgram True if no other module will extend the classes visible to this one
+ * \return Compiled program
+ */
+std::unique_ptr<VM::Program> Compiler::compile(const std::string &filename, const std::vector<std::reference_wrapper<Front::ExportInfo>> &importList, bool wholeProgram)
 {
 	std::ifstream hllIn(filename.c_str());
 	Front::HllTokenizer tokenizer(hllIn);
 	Front::HllParser parser(tokenizer);
 
-	std::unique_ptr<Front::Node> node = parser.parse();
-	if(!node) {
+	std::unique_ptr<Front::SyntaxTree> tree = parser.parse();
+	if(!tree) {
 		std::stringstream s;
 		s << "line " << parser.errorLine() << " column " << parser.errorColumn() << ": " << parser.errorMessage() << std::endl;
 		setError(s.str());
 		return 0;
 	}
 
-	std::vector<std::unique_ptr<Front::ExportInfo>> imports;
-	std::vector<std::reference_wrapper<Front::ExportInfo>> importList;
-	for(unsigned int i=0; i<importFilenames.size(); i++) {
-		VM::OrcFile importFile(importFilenames[i]);
-		const VM::OrcFile::Section *exportInfoSection = importFile.section("export_info");
-		const VM::OrcFile::Section *exportInfoStringsSection = importFile.section("export_info.strings");
-		std::unique_ptr<Front::ExportInfo> exportInfo = std::make_unique<Front::ExportInfo>(exportInfoSection->data, exportInfoStringsSection->data);
-		importList.push_back(*exportInfo);
-		imports.push_back(std::move(exportInfo));
-	}
-
-	Front::EnvironmentGenerator environmentGenerator(*node, importList);
+	Front::EnvironmentGenerator environmentGenerator(tree->root(), importList);
 	if(environmentGenerator.errorMessage() != "") {
 		std::stringstream s;
 		s << environmentGenerator.errorLocation() << ": " << environmentGenerator.errorMessage() << std::endl;
@@ -75,7 +99,7 @@ std::unique_ptr<VM::Program> Compiler::compile(const std::string &filename, cons
 		return 0;
 	}
 
-	Front::ProgramGenerator programGenerator(*node, environmentGenerator.releaseTypes(), environmentGenerator.releaseScope());
+	Front::ProgramGenerator programGenerator(*tree, environmentGenerator.releaseTypes(), environmentGenerator.releaseScope());
 	std::unique_ptr<Front::Program> program = programGenerator.generate();
 	if(!program) {
 		std::stringstream s;
@@ -88,8 +112,15 @@ std::unique_ptr<VM::Program> Compiler::compile(const std::string &filename, cons
 	program->print(Util::log("parse"));
 	Util::log("parse") << std::endl;
 
+	// When the whole program is known, its class hierarchy (including classes imported
+	// from other modules) allows virtual calls to be made directly
+	std::unique_ptr<Front::ClassHierarchy> classHierarchy;
+	if(wholeProgram) {
+		classHierarchy = std::make_unique<Front::ClassHierarchy>(*program->types);
+	}
+
 	Front::IRGenerator generator;
-	std::unique_ptr<IR::Program> irProgram = generator.generate(*program);
+	std::unique_ptr<IR::Program> irProgram = generator.generate(*program, classHierarchy.get());
 	if(!irProgram) {
 		return 0;
 	}
@@ -106,25 +137,23 @@ std::unique_ptr<VM::Program> Compiler::compile(const std::string &filename, cons
 		return 0;
 	}
 
-	Middle::Optimizer::optimize(*irProgram);
+	Middle::Optimizer::optimize(*irProgram, mOptions.unrollFactor);
 
 	Util::log("ir") << "*** IR (after optimization) ***" << std::endl;
 	irProgram->print(Util::log("ir"));
 	Util::log("ir") << std::endl;
 
-	std::stringstream buffer;
-	Back::CodeGenerator::generate(*irProgram, buffer);
-
-	Util::log("asm") << "*** Assembly ***" << std::endl;
-	Util::log("asm") << buffer.str() << std::endl;
-
-	Assembler assembler;
-	std::unique_ptr<VM::Program> vmProgram = assembler.assemble(buffer);
-	if(assembler.error()) {
-		setError(assembler.errorMessage());
-		return 0;
+	// Emit machine code directly, listing the equivalent assembly only if it will be logged
+	std::ostream *listing = nullptr;
+	if(Util::logEnabled("asm")) {
+		Util::log("asm") << "*** Assembly ***" << std::endl;
+		listing = &Util::log("asm");
 	}
 
+	Back::MachineCode code(listing);
+	Back::CodeGenerator::generate(*irProgram, code, mOptions.allocatorMode);
+	std::unique_ptr<VM::Program> vmProgram = code.finish();
+
 	vmProgram->exportInfo = std::make_unique<Front::ExportInfo>(*program->types, *program->scope);
 
 	return vmProgram;
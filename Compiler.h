@@ -3,17 +3,40 @@
 
 #include "VM/Program.h"
 
+#include "Front/ExportInfo.h"
+
+#include "Transform/LoopUnrolling.h"
+
+#include "Back/RegisterAllocator.h"
+
 #include <string>
 #include <memory>
+#include <vector>
+#include <functional>
 
 /*!
  * \brief Top-level compiler class
  */
 class Compiler {
 public:
+	/*!
+	 * \brief Options which affect the code the compiler generates
+	 */
+	struct Options {
+		Back::RegisterAllocator::Mode allocatorMode; //!< Register allocation strategy
+		int unrollFactor; //!< Number of copies made when partially unrolling loops, or less than 2 to disable unrolling
+
+		Options() : allocatorMode(Back::RegisterAllocator::Mode::Auto), unrollFactor(Transform::LoopUnrolling::DefaultFactor) {}
+	};
+
 	Compiler();
 
-	std::unique_ptr<VM::Program> compile(const std::string &filename, const std::vector<std::string> &importFilenames);
+	void setOptions(const Options &options) { mOptions = options; } //!< Set code generation options
+
+	std::unique_ptr<VM::Program> compile(const std::string &filename, const std::vector<std::string> &importFilenames, bool wholeProgram = false);
+	std::unique_ptr<VM::Program> compile(const std::string &filename, const std::vector<std::reference_wrapper<Front::ExportInfo>> &importList, bool wholeProgram = false);
+
+	static std::unique_ptr<Front::ExportInfo> readExportInfo(const std::string &filename);
 
 	bool error() { return mError; }
 	const std::string &errorMessage() { return mErrorMessage; }
@@ -21,6 +44,7 @@ public:
 private:
 	void setError(const std::string &message);
 
+	Options mOptions; //!< Code generation options
 	bool mError;
 	std::string mErrorMessage;
 };
@@ -0,0 +1,71 @@
+#include "Front/ClassHierarchy.h"
+
+namespace Front {
+	/*!
+	 * \brief Constructor
+	 * \param types Type list containing every class in the program
+	 */
+	ClassHierarchy::ClassHierarchy(Types &types)
+	{
+		for(Type *type : types.types()) {
+			if(type->kind == Type::Kind::Class) {
+				TypeStruct *typeStruct = (TypeStruct*)type;
+				if(typeStruct->parent) {
+					mSubclasses[typeStruct->parent->name].push_back(typeStruct);
+				}
+			}
+		}
+	}
+
+	/*!
+	 * \brief Find the only procedure a virtual call can dispatch to
+	 * \param classType Static type of the object being called through
+	 * \param name Member name
+	 * \return Procedure name, or an empty string if the call can reach more than one implementation
+	 */
+	std::string ClassHierarchy::uniqueTarget(TypeStruct &classType, const std::string &name) const
+	{
+		if(overridden(classType, name)) {
+			return "";
+		}
+
+		// Locate the implementation inherited by the class, in the same way its vtable is built
+		for(TypeStruct *typeStruct = &classType; typeStruct; typeStruct = typeStruct->parent) {
+			for(TypeStruct::Member &member : typeStruct->members) {
+				if(member.name == name && (member.qualifiers & TypeStruct::Member::QualifierVirtual)) {
+					return typeStruct->name + "." + name;
+				}
+			}
+		}
+
+		return "";
+	}
+
+	/*!
+	 * \brief Check whether any subclass of a class overrides a member
+	 * \param classType Class to check
+	 * \param name Member name
+	 * \return True if the member is overridden
+	 */
+	bool ClassHierarchy::overridden(const TypeStruct &classType, const std::string &name) const
+	{
+		auto it = mSubclasses.find(classType.name);
+		if(it == mSubclasses.end()) {
+			return false;
+		}
+
+		for(TypeStruct *subclass : it->second) {
+			for(TypeStruct::Member &member : subclass->members) {
+				if(member.name == name) {
+					return true;
+				}
+			}
+
+			if(overridden(*subclass, name)) {
+				return true;
+			}
+		}
+
+		return false;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,33 @@
+#ifndef FRONT_CLASS_HIERARCHY_H
+#define FRONT_CLASS_HIERARCHY_H
+
+#include "Front/Types.h"
+#include "Front/Type.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Front {
+	/*!
+	 * \brief Class hierarchy analysis
+	 *
+	 * Records the subclasses of each class in a type list, so that virtual calls whose
+	 * target is never overridden can be resolved statically.  The result is only sound
+	 * if the type list contains every class in the program, including those imported
+	 * from other modules.
+	 */
+	class ClassHierarchy {
+	public:
+		ClassHierarchy(Types &types);
+
+		std::string uniqueTarget(TypeStruct &classType, const std::string &name) const;
+
+	private:
+		bool overridden(const TypeStruct &classType, const std::string &name) const;
+
+		std::map<std::string, std::vector<TypeStruct*>> mSubclasses; //!< Direct subclasses of each class, by name
+	};
+}
+
+#endif
\ No newline at end of file
@@ -49,7 +49,7 @@ EnvironmentGenerator::EnvironmentGenerator(Node &tree, const std::vector<std::re
 		mScope = std::make_unique<Scope>();
 
 		// Loop through the tree and pre-populate all declared type names
-		for(std::unique_ptr<Node> &node : tree.children) {
+		for(Node *node : tree.children) {
 			std::stringstream s;
 
 			switch(node->nodeType) {
@@ -65,23 +65,25 @@ EnvironmentGenerator::EnvironmentGenerator(Node &tree, const std::vector<std::re
 
 		// Read types from imported binary files
 		for(ExportInfo &info : imports) {
-			info.read(*mTypes, *mScope);
+			if(!info.read(*mTypes, *mScope)) {
+				throw EnvironmentError("import", "Corrupt export info in imported module");
+			}
 		}
 
 		// Complete each type, and construct scopes for class types
 		std::set<Type*> completeTypes;
-		for(std::shared_ptr<Type> &type : mTypes->types()) {
+		for(Type *type : mTypes->types()) {
 			completeType(type);
 			if(type->kind == Type::Kind::Class) {
-				std::shared_ptr<TypeStruct> typeStruct = std::static_pointer_cast<TypeStruct>(type);
+				TypeStruct *typeStruct = static_cast<TypeStruct*>(type);
 				constructScope(typeStruct, *mScope);
 			}
 		}
 
 		// Iterate through the tree, and construct symbols for each procedure
-		for(std::unique_ptr<Node> &node : tree.children) {
+		for(Node *node : tree.children) {
 			if(node->nodeType == Node::Type::ProcedureDef) {
-				std::unique_ptr<Symbol> symbol = std::make_unique<Symbol>(createType(*node, false), node->lexVal.s);
+				std::unique_ptr<Symbol> symbol = std::make_unique<Symbol>(createType(*node, false), std::string(node->lexVal.s));
 				mScope->addSymbol(std::move(symbol));
 			}
 		}
@@ -99,7 +101,7 @@ EnvironmentGenerator::EnvironmentGenerator(Node &tree, const std::vector<std::re
 void EnvironmentGenerator::addStruct(Node &node)
 {
 	// Create the type
-	std::shared_ptr<TypeStruct> type = std::make_shared<TypeStruct>(Type::Kind::Struct, node.lexVal.s);
+	TypeStruct *type = mTypes->create<TypeStruct>(Type::Kind::Struct, std::string(node.lexVal.s));
 	if(!mTypes->registerType(type)) {
 		std::stringstream s;
 		s << "Redefinition of structure " << type->name;
@@ -112,9 +114,9 @@ void EnvironmentGenerator::addStruct(Node &node)
 	type->constructor = 0;
 
 	// Iterate through the member nodes, and create type members for each
-	for(std::unique_ptr<Node> &memberNode : node.children[0]->children) {
-		std::shared_ptr<Type> memberType = createType(*memberNode->children[0], true);
-		type->addMember(memberType, memberNode->lexVal.s, false);
+	for(Node *memberNode : node.children[0]->children) {
+		Type *memberType = createType(*memberNode->children[0], true);
+		type->addMember(memberType, std::string(memberNode->lexVal.s), false);
 	}
 }
 
@@ -126,7 +128,7 @@ void EnvironmentGenerator::addStruct(Node &node)
 void EnvironmentGenerator::addClass(Node &node)
 {
 	// Create the type
-	std::shared_ptr<TypeStruct> type = std::make_shared<TypeStruct>(Type::Kind::Class, node.lexVal.s);
+	TypeStruct *type = mTypes->create<TypeStruct>(Type::Kind::Class, std::string(node.lexVal.s));
 	if(!mTypes->registerType(type)) {
 		std::stringstream s;
 		s << "Redefinition of class " << type->name;
@@ -139,29 +141,29 @@ void EnvironmentGenerator::addClass(Node &node)
 	if(node.children.size() == 2) {
 		std::stringstream s;
 		s << "Line " << node.line;
-		type->parent = std::static_pointer_cast<TypeStruct>(std::static_pointer_cast<Type>(std::make_shared<TypeDummy>(node.children[0]->lexVal.s, s.str())));
+		type->parent = static_cast<TypeStruct*>(static_cast<Type*>(mTypes->create<TypeDummy>(std::string(node.children[0]->lexVal.s), s.str())));
 	} else {
 		type->parent = 0;
 	}
 
 	// Iterate through the member nodes, and create type members for each
-	std::unique_ptr<Node> &members = node.children[node.children.size() - 1];
-	for(std::unique_ptr<Node> &child : members->children) {
+	Node *members = node.children[node.children.size() - 1];
+	for(Node *child : members->children) {
 		Node &qualifiersNode = *child->children[0];
 		Node &memberNode = *child->children[1];
 
 		switch(memberNode.nodeType) {
 			case Node::Type::VarDecl:
 			{
-				std::shared_ptr<Type> memberType = createType(*memberNode.children[0], true);
-				type->addMember(memberType, memberNode.lexVal.s, 0);
+				Type *memberType = createType(*memberNode.children[0], true);
+				type->addMember(memberType, std::string(memberNode.lexVal.s), 0);
 				break;
 			}
 
 			case Node::Type::ProcedureDef:
 			{
 				unsigned int qualifiers = 0;
-				for(std::unique_ptr<Node> &qualifierNode : qualifiersNode.children) {
+				for(Node *qualifierNode : qualifiersNode.children) {
 					switch(qualifierNode->nodeSubtype) {
 						case Node::Subtype::Virtual:
 							qualifiers |= TypeStruct::Member::QualifierVirtual;
@@ -181,8 +183,8 @@ void EnvironmentGenerator::addClass(Node &node)
 					throw EnvironmentError(memberNode, "Virtual function cannot be static");
 				}
 
-				std::shared_ptr<TypeProcedure> procedureType = std::static_pointer_cast<TypeProcedure>(createType(memberNode, true));
-				type->addMember(procedureType, memberNode.lexVal.s, qualifiers);
+				TypeProcedure *procedureType = static_cast<TypeProcedure*>(createType(memberNode, true));
+				type->addMember(procedureType, std::string(memberNode.lexVal.s), qualifiers);
 				if(memberNode.lexVal.s == type->name) {
 					type->constructor = procedureType;
 				}
@@ -199,35 +201,35 @@ void EnvironmentGenerator::addClass(Node &node)
  * \param dummy Whether to create a dummy type if not found
  * \return Type
  */
-std::shared_ptr<Type> EnvironmentGenerator::createType(Node &node, bool dummy)
+Type *EnvironmentGenerator::createType(Node &node, bool dummy)
 {
-	std::shared_ptr<Type> type;
+	Type *type;
 	switch(node.nodeType) {
 		case Node::Type::Array:
 			type = createType(*node.children[0], dummy);
-			if(Type::equals(*type, *Types::intrinsic(Types::Void))) {
+			if(type == Types::intrinsic(Types::Void)) {
 				throw EnvironmentError(node, "Cannot declare array of voids");
 			}
-			type = std::make_shared<TypeArray>(type);
+			type = mTypes->arrayType(type);
 			break;
 
 		case Node::Type::ProcedureDef:
 			{
 				// Iterate the tree's argument items
 				Node &argumentList = *node.children[1];
-				std::vector<std::shared_ptr<Type>> argumentTypes;
-				for(std::unique_ptr<Node> &argumentNode : argumentList.children) {
+				std::vector<Type*> argumentTypes;
+				for(Node *argumentNode : argumentList.children) {
 					// Construct the argument type, and add it to the list of types
-					std::shared_ptr<Type> argumentType = createType(*argumentNode->children[0], dummy);
-					if(Type::equals(*argumentType, *Types::intrinsic(Types::Void))) {
+					Type *argumentType = createType(*argumentNode->children[0], dummy);
+					if(argumentType == Types::intrinsic(Types::Void)) {
 						throw EnvironmentError(*argumentNode, "Cannot declare procedure argument of type void");
 					}
 					argumentTypes.push_back(argumentType);
 				}
 
 				// Construct the procedure type
-				std::shared_ptr<Type> returnType = node.children[0] ? createType(*node.children[0], dummy) : Types::intrinsic(Types::Void);
-				type = std::make_shared<TypeProcedure>(returnType, argumentTypes);
+				Type *returnType = node.children[0] ? createType(*node.children[0], dummy) : Types::intrinsic(Types::Void);
+				type = mTypes->procedureType(returnType, argumentTypes);
 				break;
 			}
 
@@ -237,7 +239,7 @@ std::shared_ptr<Type> EnvironmentGenerator::createType(Node &node, bool dummy)
 				if(dummy) {
 					std::stringstream s;
 					s << "Line " << node.line;
-					type = std::make_shared<TypeDummy>(node.lexVal.s, s.str());
+					type = mTypes->create<TypeDummy>(std::string(node.lexVal.s), s.str());
 				} else {
 					std::stringstream s;
 					s << "Type '" << node.lexVal.s << "' not found";
@@ -255,7 +257,7 @@ std::shared_ptr<Type> EnvironmentGenerator::createType(Node &node, bool dummy)
  * \param type Type to complete
  * \return Resulting type, possibly different than parameter if it is a dummy type
  */
-std::shared_ptr<Type> EnvironmentGenerator::completeType(std::shared_ptr<Type> type)
+Type *EnvironmentGenerator::completeType(Type *type)
 {
 	// Bail out early if the type is known to be complete
 	if(mCompleteTypes.find(type) != mCompleteTypes.end()) {
@@ -267,31 +269,38 @@ std::shared_ptr<Type> EnvironmentGenerator::completeType(std::shared_ptr<Type> t
 	switch(type->kind) {
 		case Type::Kind::Procedure:
 			{
-				// Complete the procedure's return and argument types
-				std::shared_ptr<TypeProcedure> typeProcedure = std::static_pointer_cast<TypeProcedure>(type);
+				// Complete the procedure's return and argument types.  Procedure types are shared
+				// through the type context, so construct the completed signature rather than
+				// modifying the existing one in place
+				TypeProcedure *typeProcedure = static_cast<TypeProcedure*>(type);
 
-				typeProcedure->returnType = completeType(typeProcedure->returnType);
+				Type *returnType = completeType(typeProcedure->returnType);
 
-				for(unsigned int i=0; i<typeProcedure->argumentTypes.size(); i++) {
-					typeProcedure->argumentTypes[i] = completeType(typeProcedure->argumentTypes[i]);
+				std::vector<Type*> argumentTypes;
+				for(Type *argumentType : typeProcedure->argumentTypes) {
+					argumentTypes.push_back(completeType(argumentType));
 				}
+
+				type = mTypes->procedureType(returnType, argumentTypes);
+				mCompleteTypes.insert(type);
 				break;
 			}
 
 		case Type::Kind::Array:
 			{
-				// Complete the array's base type
-				std::shared_ptr<TypeArray> typeArray = std::static_pointer_cast<TypeArray>(type);
-				typeArray->baseType = completeType(typeArray->baseType);
+				// Complete the array's base type, and look up the array type over the completed base
+				TypeArray *typeArray = static_cast<TypeArray*>(type);
+				type = mTypes->arrayType(completeType(typeArray->baseType));
+				mCompleteTypes.insert(type);
 				break;
 			}
 
 		case Type::Kind::Struct:
 		case Type::Kind::Class:
 			{
-				std::shared_ptr<TypeStruct> typeStruct = std::static_pointer_cast<TypeStruct>(type);
+				TypeStruct *typeStruct = static_cast<TypeStruct*>(type);
 				if(typeStruct->parent) {
-					for(std::shared_ptr<Type> &completionType : mCompletionStack) {
+					for(Type *completionType : mCompletionStack) {
 						if(completionType->name == typeStruct->parent->name) {
 							std::stringstream s;
 							s << "Class " << typeStruct->name;
@@ -302,7 +311,7 @@ std::shared_ptr<Type> EnvironmentGenerator::completeType(std::shared_ptr<Type> t
 					}
 
 					// Complete parent type
-					typeStruct->parent = std::static_pointer_cast<TypeStruct>(completeType(typeStruct->parent));
+					typeStruct->parent = static_cast<TypeStruct*>(completeType(typeStruct->parent));
 
 					// Now that parent is complete, populate sizes and offsets
 					typeStruct->vtableOffset = typeStruct->parent->vtableOffset;
@@ -343,7 +352,7 @@ std::shared_ptr<Type> EnvironmentGenerator::completeType(std::shared_ptr<Type> t
 
 				if(typeStruct->constructor) {
 					// Complete the constructor type
-					typeStruct->constructor = std::static_pointer_cast<TypeProcedure>(completeType(typeStruct->constructor));
+					typeStruct->constructor = static_cast<TypeProcedure*>(completeType(typeStruct->constructor));
 				}
 
 				// Mark this type as complete
@@ -354,10 +363,10 @@ std::shared_ptr<Type> EnvironmentGenerator::completeType(std::shared_ptr<Type> t
 
 		case Type::Kind::Dummy:
 			{
-				std::shared_ptr<TypeDummy> typeDummy = std::static_pointer_cast<TypeDummy>(type);
+				TypeDummy *typeDummy = static_cast<TypeDummy*>(type);
 
 				// Locate the actual (non-dummy) version of the type
-				std::shared_ptr<Type> realType = mTypes->findType(type->name);
+				Type *realType = mTypes->findType(type->name);
 				if(!realType) {
 					std::stringstream s;
 					s << "Type '" << type->name << "' not found.";
@@ -379,7 +388,7 @@ std::shared_ptr<Type> EnvironmentGenerator::completeType(std::shared_ptr<Type> t
  * \param typeStruct Class to construct scope for
  * \param globalScope Scope containing globals
  */
-void EnvironmentGenerator::constructScope(std::shared_ptr<TypeStruct> &typeStruct, Scope &globalScope)
+void EnvironmentGenerator::constructScope(TypeStruct *typeStruct, Scope &globalScope)
 {
 	if(typeStruct->parent) {
 		// Ensure the parent scope has been constructed
@@ -1,5 +1,7 @@
 #include "Front/ExportInfo.h"
 
+#include <cstring>
+
 namespace Front {
 
 enum class ExportType {
@@ -21,11 +23,11 @@ enum ExportMember {
 
 ExportInfo::ExportInfo(Types &types, Scope &scope)
 {
-	for(std::shared_ptr<Type> &type : types.types()) {
+	for(Type *type : types.types()) {
 		switch(type->kind) {
 			case Type::Kind::Struct:
 				{
-					std::shared_ptr<TypeStruct> typeStruct = std::static_pointer_cast<TypeStruct>(type);
+					TypeStruct *typeStruct = static_cast<TypeStruct*>(type);
 					mData.push_back((unsigned char)ExportItem::TypeDefinition);
 					mData.push_back((unsigned char)ExportDefinition::Struct);
 					mData.push_back(addString(type->name));
@@ -39,7 +41,7 @@ ExportInfo::ExportInfo(Types &types, Scope &scope)
 
 			case Type::Kind::Class:
 				{
-					std::shared_ptr<TypeStruct> typeStruct = std::static_pointer_cast<TypeStruct>(type);
+					TypeStruct *typeStruct = static_cast<TypeStruct*>(type);
 					mData.push_back((unsigned char)ExportItem::TypeDefinition);
 					mData.push_back((unsigned char)ExportDefinition::Class);
 					mData.push_back(addString(type->name));
@@ -73,12 +75,18 @@ ExportInfo::ExportInfo(Types &types, Scope &scope)
 	}
 }
 
-ExportInfo::ExportInfo(const std::vector<unsigned char> &data, const std::vector<unsigned char> &strings)
-: mData(data), mStrings(strings)
+ExportInfo::ExportInfo(std::span<const unsigned char> data, std::span<const unsigned char> strings)
+: mData(data.begin(), data.end()), mStrings(strings.begin(), strings.end())
 {
 }
 
-void ExportInfo::read(Types &types, Scope &scope)
+/*!
+ * \brief Read the exported types and symbols into a type list and scope
+ * \param types Types to add to
+ * \param scope Scope to add to
+ * \return True if success, false if the data contains an unknown tag
+ */
+bool ExportInfo::read(Types &types, Scope &scope)
 {
 	unsigned int offset = 0;
 	unsigned int stringBase = 0;
@@ -94,15 +102,15 @@ void ExportInfo::read(Types &types, Scope &scope)
 					std::string name = getString(mData[offset], stringBase);
 					offset++;
 
-					std::shared_ptr<Type> type;
+					Type *type = 0;
 					switch(exportDefinition) {
 						case ExportDefinition::Class:
 							{
-								std::shared_ptr<TypeStruct> typeStruct = std::make_shared<TypeStruct>(Type::Kind::Class, name);
+								TypeStruct *typeStruct = types.create<TypeStruct>(Type::Kind::Class, name);
 								if(mData[offset] == 0xff) {
 									typeStruct->parent = 0;
 								} else {
-									typeStruct->parent = std::static_pointer_cast<TypeStruct>(getType(getString(mData[offset], stringBase), types));
+									typeStruct->parent = static_cast<TypeStruct*>(getType(getString(mData[offset], stringBase), types));
 								}
 								typeStruct->constructor = 0;
 								offset++;
@@ -112,7 +120,10 @@ void ExportInfo::read(Types &types, Scope &scope)
 								for(int i=0; i<numMembers; i++) {
 									ExportMember exportMember = (ExportMember)mData[offset];
 									offset++;
-									std::shared_ptr<Type> memberType = readType(offset, types, stringBase);
+									Type *memberType = readType(offset, types, stringBase);
+									if(!memberType) {
+										return false;
+									}
 									std::string memberName = getString(mData[offset], stringBase);
 									offset++;
 									unsigned int qualifiers = 0;
@@ -128,36 +139,46 @@ void ExportInfo::read(Types &types, Scope &scope)
 									typeStruct->addMember(memberType, memberName, qualifiers);
 
 									if(memberName == typeStruct->name) {
-										typeStruct->constructor = std::static_pointer_cast<TypeProcedure>(memberType);
+										typeStruct->constructor = static_cast<TypeProcedure*>(memberType);
 									}
 								}
-								type = std::move(typeStruct);
+								type = typeStruct;
 								break;
 							}
 
 						case ExportDefinition::Struct:
 							{
-								std::shared_ptr<TypeStruct> typeStruct = std::make_shared<TypeStruct>(Type::Kind::Struct, name);
+								TypeStruct *typeStruct = types.create<TypeStruct>(Type::Kind::Struct, name);
 								typeStruct->constructor = 0;
 								int numMembers = mData[offset];
 								offset++;
 								for(int i=0; i<numMembers; i++) {
-									std::shared_ptr<Type> memberType = readType(offset, types, stringBase);
+									Type *memberType = readType(offset, types, stringBase);
+									if(!memberType) {
+										return false;
+									}
 									std::string memberName = getString(mData[offset], stringBase);
 									offset++;
 									typeStruct->addMember(memberType, memberName, false);
 								}
-								type = std::move(typeStruct);
+								type = typeStruct;
 								break;
 							}
 					}
+
+					if(!type) {
+						return false;
+					}
 					types.registerType(type);
 					break;
 				}
 
 			case ExportItem::Symbol:
 				{
-					std::shared_ptr<Type> type = readType(offset, types, stringBase);
+					Type *type = readType(offset, types, stringBase);
+					if(!type) {
+						return false;
+					}
 					std::string name = getString(mData[offset], stringBase);
 					offset++;
 					scope.addSymbol(std::make_unique<Symbol>(type, name));
@@ -170,8 +191,13 @@ void ExportInfo::read(Types &types, Scope &scope)
 					offset++;
 					break;
 				}
+
+			default:
+				return false;
 		}
 	}
+
+	return true;
 }
 
 std::vector<std::string> ExportInfo::typeNames()
@@ -259,12 +285,19 @@ std::string ExportInfo::getString(unsigned int offset, unsigned int stringBase)
 	return std::string((char*)&mStrings[stringBase + offset]);
 }
 
-std::shared_ptr<Type> ExportInfo::readType(unsigned int &offset, Types &types, unsigned int stringBase)
+/*!
+ * \brief Read a type
+ * \param offset Offset of type in data, advanced past it
+ * \param types Types to look up or create the type in
+ * \param stringBase Base of the current module's strings
+ * \return Type, or 0 if the data contains an unknown tag
+ */
+Type *ExportInfo::readType(unsigned int &offset, Types &types, unsigned int stringBase)
 {
 	ExportType exportType = (ExportType)mData[offset];
 	offset++;
 
-	std::shared_ptr<Type> type;
+	Type *type = 0;
 	switch(exportType) {
 		case ExportType::Simple:
 			{
@@ -276,21 +309,31 @@ std::shared_ptr<Type> ExportInfo::readType(unsigned int &offset, Types &types, u
 
 		case ExportType::Procedure:
 			{
-				std::shared_ptr<Type> returnType = readType(offset, types, stringBase);
+				Type *returnType = readType(offset, types, stringBase);
+				if(!returnType) {
+					return 0;
+				}
 				int numArguments = mData[offset];
 				offset++;
-				std::vector<std::shared_ptr<Type>> argumentTypes;
+				std::vector<Type*> argumentTypes;
 				for(int i=0; i<numArguments; i++) {
-					argumentTypes.push_back(readType(offset, types, stringBase));
+					Type *argumentType = readType(offset, types, stringBase);
+					if(!argumentType) {
+						return 0;
+					}
+					argumentTypes.push_back(argumentType);
 				}
-				type = std::make_shared<TypeProcedure>(returnType, argumentTypes);
+				type = types.procedureType(returnType, argumentTypes);
 				break;
 			}
 
 		case ExportType::Array:
 			{
-				std::shared_ptr<Type> baseType = readType(offset, types, stringBase);
-				type = std::make_shared<TypeArray>(baseType);
+				Type *baseType = readType(offset, types, stringBase);
+				if(!baseType) {
+					return 0;
+				}
+				type = types.arrayType(baseType);
 				break;
 			}
 	}
@@ -345,7 +388,7 @@ void ExportInfo::writeType(Type &type)
 				mData.push_back((unsigned char)ExportType::Procedure);
 				writeType(*typeProcedure.returnType);
 				mData.push_back((unsigned char)typeProcedure.argumentTypes.size());
-				for(std::shared_ptr<Type> &argumentType : typeProcedure.argumentTypes) {
+				for(Type *argumentType : typeProcedure.argumentTypes) {
 					writeType(*argumentType);
 				}
 				break;
@@ -361,11 +404,11 @@ void ExportInfo::writeType(Type &type)
 	}
 }
 
-std::shared_ptr<Type> ExportInfo::getType(const std::string &name, Types &types)
+Type *ExportInfo::getType(const std::string &name, Types &types)
 {
-	std::shared_ptr<Type> type = types.findType(name);
+	Type *type = types.findType(name);
 	if(!type) {
-		type = std::make_shared<TypeDummy>(name, "");
+		type = types.create<TypeDummy>(name, "");
 	}
 
 	return type;
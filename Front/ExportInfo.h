@@ -4,6 +4,7 @@
 #include "Front/Types.h"
 #include "Front/Scope.h"
 
+#include <span>
 #include <vector>
 #include <map>
 
@@ -12,9 +13,9 @@ namespace Front {
 class ExportInfo {
 public:
 	ExportInfo(Types &types, Scope &scope);
-	ExportInfo(const std::vector<unsigned char> &data, const std::vector<unsigned char> &strings);
+	ExportInfo(std::span<const unsigned char> data, std::span<const unsigned char> strings);
 
-	void read(Types &types, Scope &scope);
+	bool read(Types &types, Scope &scope);
 	std::vector<std::string> typeNames();
 
 	const std::vector<unsigned char> &data() { return mData; }
@@ -35,11 +36,11 @@ private:
 	std::string getString(unsigned int offset, unsigned int stringBase);
 	unsigned char addString(const std::string &str);
 
-	std::shared_ptr<Type> readType(unsigned int &offset, Types &types, unsigned int stringBase);
+	Type *readType(unsigned int &offset, Types &types, unsigned int stringBase);
 	void bypassType(unsigned int &offset);
 	void writeType(Type &type);
 
-	std::shared_ptr<Type> getType(const std::string &name, Types &types);
+	Type *getType(const std::string &name, Types &types);
 };
 
 }
@@ -24,45 +24,40 @@ HllParser::HllParser(HllTokenizer &tokenizer)
  * \param nodeSubtype Subtype for new node
  * \return Newly constructed node
  */
-std::unique_ptr<Node> HllParser::newNode(Node::Type nodeType, int line, Node::Subtype nodeSubtype)
+Node *HllParser::newNode(Node::Type nodeType, int line, Node::Subtype nodeSubtype)
 {
-	// Construct the new node
-	std::unique_ptr<Node> node = std::make_unique<Node>();
-	node->nodeType = nodeType;
-	node->nodeSubtype = nodeSubtype;
-	node->type = 0;
-	node->line = line;
-	node->symbol = 0;
-
-	return node;
+	return mTree->newNode(nodeType, line, nodeSubtype);
 }
 
 /*!
  * \brief Parse the input stream
  * \return Abstract syntax tree representing parse, or 0 if an error occurred
  */
-std::unique_ptr<Node> HllParser::parse()
+std::unique_ptr<SyntaxTree> HllParser::parse()
 {
 	try {
 		// Parse the stream
-		return parseProgram();
+		mTree = std::make_unique<SyntaxTree>();
+		mTree->setRoot(parseProgram());
+		return std::move(mTree);
 	} catch(Input::Parser::ParseException parseException) {
 		// Collect the error information from the exception
 		setError(parseException.message(), parseException.line(), parseException.column());
+		mTree.reset();
 		return 0;
 	}
 }
 
-std::unique_ptr<Node> HllParser::parseProgram()
+Node *HllParser::parseProgram()
 {
 	// <Program> := { [ <Procedure> | <Struct> ] }* END
-	std::unique_ptr<Node> list = newNode(Node::Type::List, next().line);
+	Node *list = newNode(Node::Type::List, next().line);
 	while(true) {
-		std::unique_ptr<Node> node;
-		if(node = parseProcedure()) {
-			list->children.push_back(std::move(node));
+		Node *node = 0;
+		if((node = parseProcedure())) {
+			mTree->addChild(*list, node);
 		} else if((node = parseStruct()) || (node = parseClass())) {
-			list->children.push_back(std::move(node));
+			mTree->addChild(*list, node);
 		} else {
 			break;
 		}
@@ -72,95 +67,95 @@ std::unique_ptr<Node> HllParser::parseProgram()
 	return list;
 }
 
-std::unique_ptr<Node> HllParser::parseProcedure()
+Node *HllParser::parseProcedure()
 {
 	// <Procedure> := <Type> IDENTIFIER '(' <ArgumentDeclarationList> ')' '{' <StatementList> '}'
-	std::unique_ptr<Node> returnType = parseType();
+	Node *returnType = parseType();
 	if(!returnType)	return 0;
 
-	std::unique_ptr<Node> node = newNode(Node::Type::ProcedureDef, returnType->line);
-	node->children.push_back(std::move(returnType));
-	node->lexVal.s = next().text;
+	Node *node = newNode(Node::Type::ProcedureDef, returnType->line);
+	mTree->addChild(*node, returnType);
+	node->lexVal.s = mTree->intern(next().text);
 	expect(HllTokenizer::TypeIdentifier);
 
 	expectLiteral("(");
-	node->children.push_back(parseArgumentList());
+	mTree->addChild(*node, parseArgumentList());
 	expectLiteral(")");
 
 	expectLiteral("{");
-	node->children.push_back(parseStatementList());
+	mTree->addChild(*node, parseStatementList());
 	expectLiteral("}");
 
 	return node;
 }
 
-std::unique_ptr<Node> HllParser::parseStruct()
+Node *HllParser::parseStruct()
 {
 	// <Struct> := 'struct' IDENTIFIER '{' { <VariableDeclaration> ';' }* '}'
 	if(!matchLiteral("struct")) {
 		return 0;
 	}
 
-	std::unique_ptr<Node> node = newNode(Node::Type::StructDef, next().line);
+	Node *node = newNode(Node::Type::StructDef, next().line);
 	consume();
 
-	node->lexVal.s = next().text;
+	node->lexVal.s = mTree->intern(next().text);
 	expect(HllTokenizer::TypeIdentifier);
 
 	expectLiteral("{");
-	std::unique_ptr<Node> membersNode = newNode(Node::Type::List, next().line);
-	std::unique_ptr<Node> member;
-	while(member = parseVariableDeclaration()) {
-		membersNode->children.push_back(std::move(member));
+	Node *membersNode = newNode(Node::Type::List, next().line);
+	Node *member = 0;
+	while((member = parseVariableDeclaration())) {
+		mTree->addChild(*membersNode, member);
 		expectLiteral(";");
 	}
-	node->children.push_back(std::move(membersNode));
+	mTree->addChild(*node, membersNode);
 	expectLiteral("}");
 
 	return node;
 }
 
-std::unique_ptr<Node> HllParser::parseClass()
+Node *HllParser::parseClass()
 {
 	// <Struct> := 'class' IDENTIFIER { ':' IDENTIFIER }? '{' <ClassMember>* '}'
 	if(!matchLiteral("class")) {
 		return 0;
 	}
 
-	std::unique_ptr<Node> node = newNode(Node::Type::ClassDef, next().line);
+	Node *node = newNode(Node::Type::ClassDef, next().line);
 	consume();
 
-	node->lexVal.s = next().text;
+	node->lexVal.s = mTree->intern(next().text);
 	expect(HllTokenizer::TypeIdentifier);
 
 	if(matchLiteral(":")) {
 		consume();
-		std::string parent = next().text;
+		std::string_view parent = next().text;
 		expect(HllTokenizer::TypeIdentifier);
-		std::unique_ptr<Node> parentNode = newNode(Node::Type::Id, next().line);
-		parentNode->lexVal.s = parent;
-		node->children.push_back(std::move(parentNode));
+		Node *parentNode = newNode(Node::Type::Id, next().line);
+		parentNode->lexVal.s = mTree->intern(parent);
+		mTree->addChild(*node, parentNode);
 	}
 
 	expectLiteral("{");
-	std::unique_ptr<Node> membersNode = newNode(Node::Type::List, next().line);
+	Node *membersNode = newNode(Node::Type::List, next().line);
 
-	std::unique_ptr<Node> member;
-	while(member = parseClassMember()) {
-		membersNode->children.push_back(std::move(member));
+	Node *member = 0;
+	while((member = parseClassMember())) {
+		mTree->addChild(*membersNode, member);
 	}
 
-	node->children.push_back(std::move(membersNode));
+	mTree->addChild(*node, membersNode);
 	expectLiteral("}");
 
 	return node;
 }
 
-std::unique_ptr<Node> HllParser::parseClassMember()
+Node *HllParser::parseClassMember()
 {
 	// <ClassMember> := { <Type> }? IDENTIFIER '(' <ArgumentDeclarationList> ')' '{' <StatementList> '}' | <Type> IDENTIFIER ';'
-	std::unique_ptr<Node> type;
-	std::vector<std::unique_ptr<Node>> qualifiers;
+	Node *type = 0;
+	std::vector<Node*> qualifiers;
 
 	if(match(HllTokenizer::TypeIdentifier) && matchLiteral("(", 1)) {
 		type = 0;
@@ -186,48 +181,50 @@ std::unique_ptr<Node> HllParser::parseClassMember()
 		}
 	}
 
-	std::string name = next().text;
+	std::string_view name = next().text;
 	expect(HllTokenizer::TypeIdentifier);
 
-	std::unique_ptr<Node> node = newNode(Node::Type::ClassMember, next().line);
-	std::unique_ptr<Node> qualifiersNode = newNode(Node::Type::List, next().line);
-	qualifiersNode->children = std::move(qualifiers);
-	node->children.push_back(std::move(qualifiersNode));
+	Node *node = newNode(Node::Type::ClassMember, next().line);
+	Node *qualifiersNode = newNode(Node::Type::List, next().line);
+	for(Node *qualifier : qualifiers) {
+		mTree->addChild(*qualifiersNode, qualifier);
+	}
+	mTree->addChild(*node, qualifiersNode);
 
-	std::unique_ptr<Node> memberNode;
+	Node *memberNode = 0;
 	if(matchLiteral("(")) {
 		consume();
 		memberNode = newNode(Node::Type::ProcedureDef, next().line);
-		memberNode->children.push_back(std::move(type));
-		memberNode->lexVal.s = name;
+		mTree->addChild(*memberNode, type);
+		memberNode->lexVal.s = mTree->intern(name);
 
-		memberNode->children.push_back(parseArgumentList());
+		mTree->addChild(*memberNode, parseArgumentList());
 		expectLiteral(")");
 
 		if(matchLiteral("{")) {
 			consume();
-			memberNode->children.push_back(parseStatementList());
+			mTree->addChild(*memberNode, parseStatementList());
 			expectLiteral("}");
 		} else {
 			expectLiteral(";");
 		}
 	} else {
-		if(qualifiersNode->children.size() > 0) {
+		if(node->children[0]->children.size() > 0) {
 			errorExpected("(");
 		}
 
 		memberNode = newNode(Node::Type::VarDecl, type->line);
-		memberNode->lexVal.s = name;
-		memberNode->children.push_back(std::move(type));
+		memberNode->lexVal.s = mTree->intern(name);
+		mTree->addChild(*memberNode, type);
 		expectLiteral(";");
 	}
 
-	node->children.push_back(std::move(memberNode));
+	mTree->addChild(*node, memberNode);
 
 	return node;
 }
 
-std::unique_ptr<Node> HllParser::parseVariableDeclaration()
+Node *HllParser::parseVariableDeclaration()
 {
 	// <VariableDeclaration> := <Type> IDENTIFIER
 	if(match(HllTokenizer::TypeIdentifier)) {
@@ -240,25 +237,25 @@ std::unique_ptr<Node> HllParser::parseVariableDeclaration()
 		}
 	}
 
-	std::unique_ptr<Node> type = parseType();
+	Node *type = parseType();
 	if(!type) return 0;
 
-	std::unique_ptr<Node> node = newNode(Node::Type::VarDecl, type->line);
-	node->lexVal.s = next().text;
+	Node *node = newNode(Node::Type::VarDecl, type->line);
+	node->lexVal.s = mTree->intern(next().text);
 	expect(HllTokenizer::TypeIdentifier);
 
-	node->children.push_back(std::move(type));
+	mTree->addChild(*node, type);
 
 	return node;
 }
 
-std::unique_ptr<Node> HllParser::parseArgumentList()
+Node *HllParser::parseArgumentList()
 {
 	// <ArgumentList> := { <VariableDeclaration> ',' }*
-	std::unique_ptr<Node> node = newNode(Node::Type::List, next().line);
-	std::unique_ptr<Node> argument;
-	while(argument = parseVariableDeclaration()) {
-		node->children.push_back(std::move(argument));
+	Node *node = newNode(Node::Type::List, next().line);
+	Node *argument = 0;
+	while((argument = parseVariableDeclaration())) {
+		mTree->addChild(*node, argument);
 		if(!matchLiteral(",")) {
 			break;
 		}
@@ -268,21 +265,21 @@ std::unique_ptr<Node> HllParser::parseArgumentList()
 	return node;
 }
 
-std::unique_ptr<Node> HllParser::parseType(bool required)
+Node *HllParser::parseType(bool required)
 {
 	// <Type> := IDENTIFIER { '[' ']' }*
-	std::unique_ptr<Node> node;
+	Node *node = 0;
 
 	if(match(HllTokenizer::TypeIdentifier)) {
 		node = newNode(Node::Type::Id, next().line);
-		node->lexVal.s = next().text;
+		node->lexVal.s = mTree->intern(next().text);
 		consume();
 
 		while(matchLiteral("[") && matchLiteral("]", 1)) {
 			consume(2);
-			std::unique_ptr<Node> arrayNode = newNode(Node::Type::Array, node->line);
-			arrayNode->children.push_back(std::move(node));
-			node = std::move(arrayNode);
+			Node *arrayNode = newNode(Node::Type::Array, node->line);
+			mTree->addChild(*arrayNode, node);
+			node = arrayNode;
 		}
 		return node;
 	}
@@ -295,36 +292,36 @@ std::unique_ptr<Node> HllParser::parseType(bool required)
 	return 0;
 }
 
-std::unique_ptr<Node> HllParser::parseStatementList()
+Node *HllParser::parseStatementList()
 {
 	// <StatementList> := { <Statement> }*
-	std::unique_ptr<Node> node = newNode(Node::Type::List, next().line);
+	Node *node = newNode(Node::Type::List, next().line);
 
-	std::unique_ptr<Node> statement;
-	while(statement = parseStatement()) {
-		node->children.push_back(std::move(statement));
+	Node *statement = 0;
+	while((statement = parseStatement())) {
+		mTree->addChild(*node, statement);
 	}
 
 	return node;
 }
 
-std::unique_ptr<Node> HllParser::parseStatement(bool required)
+Node *HllParser::parseStatement(bool required)
 {
-	std::unique_ptr<Node> node;
+	Node *node = 0;
 
-	if(node = parseVariableDeclaration()) {
+	if((node = parseVariableDeclaration())) {
 		// <Statement> := <VariableDeclaration> { = <Expression> ';' }?
 		if(matchLiteral("=")) {
 			consume();
-			std::unique_ptr<Node> assign = newNode(Node::Type::Assign, node->line);
-			assign->children.push_back(std::move(node));
-			assign->children.push_back(parseExpression(true));
-			node = std::move(assign);
+			Node *assign = newNode(Node::Type::Assign, node->line);
+			mTree->addChild(*assign, node);
+			mTree->addChild(*assign, parseExpression(true));
+			node = assign;
 		}
 		expectLiteral(";");
 
 		return node;
-	} else if(node = parseExpression()) {
+	} else if((node = parseExpression())) {
 		// <Statement> := <Expression> ';'
 		expectLiteral(";");
 
@@ -334,7 +331,7 @@ std::unique_ptr<Node> HllParser::parseStatement(bool required)
 		node = newNode(Node::Type::Return, next().line);
 		consume();
 
-		node->children.push_back(parseExpression(true));
+		mTree->addChild(*node, parseExpression(true));
 		expectLiteral(";");
 
 		return node;
@@ -344,13 +341,13 @@ std::unique_ptr<Node> HllParser::parseStatement(bool required)
 		consume();
 
 		expectLiteral("(");
-		node->children.push_back(parseExpression(true));
+		mTree->addChild(*node, parseExpression(true));
 		expectLiteral(")");
 
-		node->children.push_back(parseClause(true));
+		mTree->addChild(*node, parseClause(true));
 		if(matchLiteral("else")) {
 			consume();
-			node->children.push_back(parseClause(true));
+			mTree->addChild(*node, parseClause(true));
 		}
 
 		return node;
@@ -360,10 +357,10 @@ std::unique_ptr<Node> HllParser::parseStatement(bool required)
 		consume();
 
 		expectLiteral("(");
-		node->children.push_back(parseExpression(true));
+		mTree->addChild(*node, parseExpression(true));
 		expectLiteral(")");
 
-		node->children.push_back(parseClause(true));
+		mTree->addChild(*node, parseClause(true));
 
 		return node;
 	} else if(matchLiteral("for")) {
@@ -372,24 +369,24 @@ std::unique_ptr<Node> HllParser::parseStatement(bool required)
 		consume();
 
 		expectLiteral("(");
-		std::unique_ptr<Node> varDecl = parseVariableDeclaration();
+		Node *varDecl = parseVariableDeclaration();
 		if(varDecl) {
-			std::unique_ptr<Node> assign = newNode(Node::Type::Assign, varDecl->line);
-			assign->children.push_back(std::move(varDecl));
+			Node *assign = newNode(Node::Type::Assign, varDecl->line);
+			mTree->addChild(*assign, varDecl);
 
 			expectLiteral("=");
-			assign->children.push_back(parseExpression(true));
-			node->children.push_back(std::move(assign));
+			mTree->addChild(*assign, parseExpression(true));
+			mTree->addChild(*node, assign);
 		} else {
-			node->children.push_back(parseExpression(true));
+			mTree->addChild(*node, parseExpression(true));
 		}
 		expectLiteral(";");
-		node->children.push_back(parseExpression(true));
+		mTree->addChild(*node, parseExpression(true));
 		expectLiteral(";");
-		node->children.push_back(parseExpression(true));
+		mTree->addChild(*node, parseExpression(true));
 		expectLiteral(")");
 
-		node->children.push_back(parseClause(true));
+		mTree->addChild(*node, parseClause(true));
 
 		return node;
 	} else if(matchLiteral("break")) {
@@ -416,13 +413,13 @@ std::unique_ptr<Node> HllParser::parseStatement(bool required)
 	return 0;
 }
 
-std::unique_ptr<Node> HllParser::parseClause(bool required)
+Node *HllParser::parseClause(bool required)
 {
 	if(matchLiteral("{")) {
 		// <Clause> := '{' <StatementList> '}'
 		consume();
 
-		std::unique_ptr<Node> node = parseStatementList();
+		Node *node = parseStatementList();
 		expectLiteral("}");
 
 		return node;
@@ -432,10 +429,10 @@ std::unique_ptr<Node> HllParser::parseClause(bool required)
 	}
 }
 
-std::unique_ptr<Node> HllParser::parseExpression(bool required)
+Node *HllParser::parseExpression(bool required)
 {
 	// <Expression> := <OrExpression> { '=' <OrExpression> }*
-	std::unique_ptr<Node> node = parseOrExpression(required);
+	Node *node = parseOrExpression(required);
 	if(!node) {
 		return 0;
 	}
@@ -443,19 +440,19 @@ std::unique_ptr<Node> HllParser::parseExpression(bool required)
 	if(matchLiteral("=")) {
 		consume();
 
-		std::unique_ptr<Node> assignNode = newNode(Node::Type::Assign, node->line);
-		assignNode->children.push_back(std::move(node));
-		assignNode->children.push_back(parseExpression(true));
-		node = std::move(assignNode);
+		Node *assignNode = newNode(Node::Type::Assign, node->line);
+		mTree->addChild(*assignNode, node);
+		mTree->addChild(*assignNode, parseExpression(true));
+		node = assignNode;
 	}
 
 	return node;
 }
 
-std::unique_ptr<Node> HllParser::parseOrExpression(bool required)
+Node *HllParser::parseOrExpression(bool required)
 {
 	// <OrExpression> := <AndExpression> { '||' <AndExpression> }*
-	std::unique_ptr<Node> node = parseAndExpression(required);
+	Node *node = parseAndExpression(required);
 	if(!node) {
 		return 0;
 	}
@@ -464,10 +461,10 @@ std::unique_ptr<Node> HllParser::parseOrExpression(bool required)
 		if(matchLiteral("||")) {
 			consume();
 
-			std::unique_ptr<Node> orNode = newNode(Node::Type::Compare, node->line, Node::Subtype::Or);
-			orNode->children.push_back(std::move(node));
-			orNode->children.push_back(parseAndExpression(true));
-			node = std::move(orNode);
+			Node *orNode = newNode(Node::Type::Compare, node->line, Node::Subtype::Or);
+			mTree->addChild(*orNode, node);
+			mTree->addChild(*orNode, parseAndExpression(true));
+			node = orNode;
 			continue;
 		}
 		break;
@@ -476,10 +473,10 @@ std::unique_ptr<Node> HllParser::parseOrExpression(bool required)
 	return node;
 }
 
-std::unique_ptr<Node> HllParser::parseAndExpression(bool required)
+Node *HllParser::parseAndExpression(bool required)
 {
 	// <AndExpression> := <CompareExpression> { '&&' <CompareExpression> }*
-	std::unique_ptr<Node> node = parseCompareExpression(required);
+	Node *node = parseCompareExpression(required);
 	if(!node) {
 		return 0;
 	}
@@ -488,10 +485,10 @@ std::unique_ptr<Node> HllParser::parseAndExpression(bool required)
 		if(matchLiteral("&&")) {
 			consume();
 
-			std::unique_ptr<Node> andNode = newNode(Node::Type::Compare, node->line, Node::Subtype::And);
-			andNode->children.push_back(std::move(node));
-			andNode->children.push_back(parseCompareExpression(true));
-			node = std::move(andNode);
+			Node *andNode = newNode(Node::Type::Compare, node->line, Node::Subtype::And);
+			mTree->addChild(*andNode, node);
+			mTree->addChild(*andNode, parseCompareExpression(true));
+			node = andNode;
 			continue;
 		}
 		break;
@@ -500,17 +497,17 @@ std::unique_ptr<Node> HllParser::parseAndExpression(bool required)
 	return node;
 }
 
-std::unique_ptr<Node> HllParser::parseCompareExpression(bool required)
+Node *HllParser::parseCompareExpression(bool required)
 {
 	// <CompareExpression> := <AddExpression> { [ '==' | '!=' | '<' | '<=' | '>' | '>=' ] <AddExpression> }*
-	std::unique_ptr<Node> node = parseAddExpression(required);
+	Node *node = parseAddExpression(required);
 	if(!node) {
 		return 0;
 	}
 
 	while(true) {
 		if(matchLiteral("==") || matchLiteral("!=") || matchLiteral("<") || matchLiteral(">") || matchLiteral("<=") || matchLiteral(">=")) {
-			Node::Subtype subtype;
+			Node::Subtype subtype = Node::Subtype::None;
 			if(matchLiteral("==")) subtype = Node::Subtype::Equal;
 			else if(matchLiteral("!=")) subtype = Node::Subtype::Nequal;
 			else if(matchLiteral("<")) subtype = Node::Subtype::LessThan;
@@ -519,10 +516,10 @@ std::unique_ptr<Node> HllParser::parseCompareExpression(bool required)
 			else if(matchLiteral(">=")) subtype = Node::Subtype::GreaterThanEqual;
 			consume();
 
-			std::unique_ptr<Node> compareNode = newNode(Node::Type::Compare, node->line, subtype);
-			compareNode->children.push_back(std::move(node));
-			compareNode->children.push_back(parseAddExpression(true));
-			node = std::move(compareNode);
+			Node *compareNode = newNode(Node::Type::Compare, node->line, subtype);
+			mTree->addChild(*compareNode, node);
+			mTree->addChild(*compareNode, parseAddExpression(true));
+			node = compareNode;
 			continue;
 		}
 		break;
@@ -531,25 +528,25 @@ std::unique_ptr<Node> HllParser::parseCompareExpression(bool required)
 	return node;
 }
 
-std::unique_ptr<Node> HllParser::parseAddExpression(bool required)
+Node *HllParser::parseAddExpression(bool required)
 {
 	// <AddExpression> := <MultiplyExpression> { [ '+' | '-' ] <MultiplyExpression> }*
-	std::unique_ptr<Node> node = parseMultiplyExpression(required);
+	Node *node = parseMultiplyExpression(required);
 	if(!node) {
 		return 0;
 	}
 
 	while(true) {
 		if(matchLiteral("+") || matchLiteral("-")) {
-			Node::Subtype subtype;
+			Node::Subtype subtype = Node::Subtype::None;
 			if(matchLiteral("+")) subtype = Node::Subtype::Add;
 			else if(matchLiteral("-")) subtype = Node::Subtype::Subtract;
 			consume();
 
-			std::unique_ptr<Node> addNode = newNode(Node::Type::Arith, node->line, subtype);
-			addNode->children.push_back(std::move(node));
-			addNode->children.push_back(parseMultiplyExpression(true));
-			node = std::move(addNode);
+			Node *addNode = newNode(Node::Type::Arith, node->line, subtype);
+			mTree->addChild(*addNode, node);
+			mTree->addChild(*addNode, parseMultiplyExpression(true));
+			node = addNode;
 			continue;
 		}
 		break;
@@ -558,26 +555,26 @@ std::unique_ptr<Node> HllParser::parseAddExpression(bool required)
 	return node;
 }
 
-std::unique_ptr<Node> HllParser::parseMultiplyExpression(bool required)
+Node *HllParser::parseMultiplyExpression(bool required)
 {
 	// <MultiplyExpression> := <SuffixExpression> { '*' <SuffixExpression> }*
-	std::unique_ptr<Node> node = parseSuffixExpression(required);
+	Node *node = parseSuffixExpression(required);
 	if(!node) {
 		return 0;
 	}
 
 	while(true) {
 		if(matchLiteral("*") || matchLiteral("/") || matchLiteral("%")) {
-			Node::Subtype subtype;
+			Node::Subtype subtype = Node::Subtype::None;
 			if(matchLiteral("*")) subtype = Node::Subtype::Multiply;
 			else if(matchLiteral("/")) subtype = Node::Subtype::Divide;
 			else if(matchLiteral("%")) subtype = Node::Subtype::Modulo;
 			consume();
 
-			std::unique_ptr<Node> multiplyNode = newNode(Node::Type::Arith, node->line, subtype);
-			multiplyNode->children.push_back(std::move(node));
-			multiplyNode->children.push_back(parseSuffixExpression(true));
-			node = std::move(multiplyNode);
+			Node *multiplyNode = newNode(Node::Type::Arith, node->line, subtype);
+			mTree->addChild(*multiplyNode, node);
+			mTree->addChild(*multiplyNode, parseSuffixExpression(true));
+			node = multiplyNode;
 			continue;
 		}
 		break;
@@ -586,10 +583,10 @@ std::unique_ptr<Node> HllParser::parseMultiplyExpression(bool required)
 	return node;
 }
 
-std::unique_ptr<Node> HllParser::parseSuffixExpression(bool required)
+Node *HllParser::parseSuffixExpression(bool required)
 {
 	// <SuffixExpression> := <BaseExpression> ...
-	std::unique_ptr<Node> node = parseBaseExpression(required);
+	Node *node = parseBaseExpression(required);
 	if(!node) {
 		return 0;
 	}
@@ -600,39 +597,39 @@ std::unique_ptr<Node> HllParser::parseSuffixExpression(bool required)
 			// '(' <ExpressionList> ')'
 			consume();
 
-			std::unique_ptr<Node> callNode = newNode(Node::Type::Call, node->line);
-			callNode->children.push_back(std::move(node));
-			callNode->children.push_back(parseExpressionList());
+			Node *callNode = newNode(Node::Type::Call, node->line);
+			mTree->addChild(*callNode, node);
+			mTree->addChild(*callNode, parseExpressionList());
 			expectLiteral(")");
 
-			node = std::move(callNode);
+			node = callNode;
 		} else if(matchLiteral("[")) {
 			// '[' <Expression> ']'
 			consume();
 
-			std::unique_ptr<Node> arrayNode = newNode(Node::Type::Array, node->line);
-			arrayNode->children.push_back(std::move(node));
-			arrayNode->children.push_back(parseExpression(true));
+			Node *arrayNode = newNode(Node::Type::Array, node->line);
+			mTree->addChild(*arrayNode, node);
+			mTree->addChild(*arrayNode, parseExpression(true));
 			expectLiteral("]");
-			node = std::move(arrayNode);
+			node = arrayNode;
 		} else if(matchLiteral("++") || matchLiteral("--")) {
 			// [ '++' | '--' ]
-			Node::Subtype subtype;
+			Node::Subtype subtype = Node::Subtype::None;
 			if(matchLiteral("++")) subtype = Node::Subtype::Increment;
 			else if(matchLiteral("--")) subtype = Node::Subtype::Decrement;
 			consume();
 
-			std::unique_ptr<Node> incrementNode = newNode(Node::Type::Arith, node->line, subtype);
-			incrementNode->children.push_back(std::move(node));
-			node = std::move(incrementNode);
+			Node *incrementNode = newNode(Node::Type::Arith, node->line, subtype);
+			mTree->addChild(*incrementNode, node);
+			node = incrementNode;
 		} else if(matchLiteral(".")) {
-			std::unique_ptr<Node> memberNode = newNode(Node::Type::Member, next().line);
+			Node *memberNode = newNode(Node::Type::Member, next().line);
 			consume();
 
-			memberNode->lexVal.s = next().text;
+			memberNode->lexVal.s = mTree->intern(next().text);
 			expect(HllTokenizer::TypeIdentifier);
-			memberNode->children.push_back(std::move(node));
-			node = std::move(memberNode);
+			mTree->addChild(*memberNode, node);
+			node = memberNode;
 		} else {
 			break;
 		}
@@ -641,13 +638,13 @@ std::unique_ptr<Node> HllParser::parseSuffixExpression(bool required)
 	return node;
 }
 
-std::unique_ptr<Node> HllParser::parseExpressionList()
+Node *HllParser::parseExpressionList()
 {
 	// <ExpressionList> := { <Expression> ',' }*
-	std::unique_ptr<Node> list = newNode(Node::Type::List, next().line);
-	std::unique_ptr<Node> expression;
-	while(expression = parseExpression()) {
-		list->children.push_back(std::move(expression));
+	Node *list = newNode(Node::Type::List, next().line);
+	Node *expression = 0;
+	while((expression = parseExpression())) {
+		mTree->addChild(*list, expression);
 		if(!matchLiteral(",")) {
 			break;
 		}
@@ -657,14 +654,14 @@ std::unique_ptr<Node> HllParser::parseExpressionList()
 	return list;
 }
 
-std::unique_ptr<Node> HllParser::parseBaseExpression(bool required)
+Node *HllParser::parseBaseExpression(bool required)
 {
-	std::unique_ptr<Node> node;
+	Node *node = 0;
 
 	if(match(HllTokenizer::TypeNumber)) {
 		// <BaseExpression> := NUMBER
 		node = newNode(Node::Type::Constant, next().line);
-		node->lexVal.i = std::atoi(next().text.c_str());
+		node->lexVal.i = std::atoi(std::string(next().text).c_str());
 		node->type = Types::intrinsic(Types::Int);
 		consume();
 
@@ -672,7 +669,7 @@ std::unique_ptr<Node> HllParser::parseBaseExpression(bool required)
 	} else if(match(HllTokenizer::TypeString)) {
 		// <BaseExpression> := STRING
 		node = newNode(Node::Type::Constant, next().line);
-		node->lexVal.s = next().text;
+		node->lexVal.s = mTree->intern(next().text);
 		node->type = Types::intrinsic(Types::String);
 		consume();
 
@@ -687,11 +684,8 @@ std::unique_ptr<Node> HllParser::parseBaseExpression(bool required)
 		return node;
 	} else if(matchLiteral("true") || matchLiteral("false")) {
 		// <BaseExpression> := 'true' | 'false'
-		int value;
 		node = newNode(Node::Type::Constant, next().line);
-		if(matchLiteral("true")) value = 1;
-		else if(matchLiteral("false")) value = 0;
-		node->lexVal.i = value;
+		node->lexVal.i = matchLiteral("true") ? 1 : 0;
 		node->type = Types::intrinsic(Types::Bool);
 		consume();
 
@@ -699,7 +693,7 @@ std::unique_ptr<Node> HllParser::parseBaseExpression(bool required)
 	} else if(match(HllTokenizer::TypeIdentifier)) {
 		// <BaseExpression> := IDENTIFIER
 		node = newNode(Node::Type::Id, next().line);
-		node->lexVal.s = next().text;
+		node->lexVal.s = mTree->intern(next().text);
 		consume();
 
 		return node;
@@ -716,17 +710,17 @@ std::unique_ptr<Node> HllParser::parseBaseExpression(bool required)
 		node = newNode(Node::Type::New, next().line);
 		consume();
 
-		std::unique_ptr<Node> type = parseType(true);
-		std::unique_ptr<Node> args;
+		Node *type = parseType(true);
+		Node *args = 0;
 		if(matchLiteral("[")) {
 			consume();
 
-			std::unique_ptr<Node> count = parseExpression(true);
+			Node *count = parseExpression(true);
 			expectLiteral("]");
-			std::unique_ptr<Node> arrayType = newNode(Node::Type::Array, type->line);
-			arrayType->children.push_back(std::move(type));
-			arrayType->children.push_back(std::move(count));
-			type = std::move(arrayType);
+			Node *arrayType = newNode(Node::Type::Array, type->line);
+			mTree->addChild(*arrayType, type);
+			mTree->addChild(*arrayType, count);
+			type = arrayType;
 		} else if(matchLiteral("(")) {
 			consume();
 
@@ -736,9 +730,9 @@ std::unique_ptr<Node> HllParser::parseBaseExpression(bool required)
 			args = newNode(Node::Type::List, node->line);
 		}
 
-		node->children.push_back(std::move(type));
+		mTree->addChild(*node, type);
 		if(args) {
-			node->children.push_back(std::move(args));
+			mTree->addChild(*node, args);
 		}
 
 		return node;
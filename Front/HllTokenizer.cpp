@@ -1,15 +1,16 @@
 #include "Front/HllTokenizer.h"
 
-#include <cctype>
 #include <sstream>
 
-static std::vector<char> whitespace = { ' ', '\t', '\r', '\n' };
+static constexpr Input::CharacterSet whitespace = { " \t\r\n" };
+static constexpr Input::CharacterSet identifierCharacters = { Input::CharacterSet::Letters, "_" };
+static constexpr Input::CharacterSet digits = { Input::CharacterSet::Digits };
 
-static std::vector<std::string> literals = { "==", "!=", ">=", "<=", "++", "--", "&&", "||",
+static constexpr Input::LiteralTable literals = { "==", "!=", ">=", "<=", "++", "--", "&&", "||",
 					 ">", "<", "+", "-", "*", "/", "%", "(", ")", "=", ";", "{", "}", ",", "[", "]", ".", ":"
 					};
 
-static std::vector<std::string> keywords = { "if", "else", "while", "return", "new", "for", "break",
+static constexpr Input::LiteralTable keywords = { "if", "else", "while", "return", "new", "for", "break",
 					 "continue", "true", "false", "struct", "class", "virtual", "native", "static"
 					};
 
@@ -33,16 +34,27 @@ struct {
 	{ '\"', '\"' }
 };
 
-bool HllTokenizer::evaluateEscapes(std::string &text)
+/*!
+ * \brief Replace escape sequences in literal text with the characters they represent
+ * \param text Literal text.  If it contains escapes, it is redirected to stored, unescaped text
+ * \return True if all escape sequences were valid
+ */
+bool HllTokenizer::evaluateEscapes(std::string_view &text)
 {
+	// Text without escapes can be referenced directly from the source
+	if(text.find('\\') == std::string_view::npos) {
+		return true;
+	}
+
+	std::string evaluated;
 	for(unsigned int i=0; i<text.size(); i++) {
 		if(text[i] == '\\') {
 			bool valid = false;
 			if(i < text.size() - 1) {
 				for(auto &escape : escapes) {
 					if(text[i+1] == escape.escape) {
-						text[i] = escape.value;
-						text.erase(i+1, 1);
+						evaluated.push_back(escape.value);
+						i++;
 						valid = true;
 						break;
 					}
@@ -53,9 +65,12 @@ bool HllTokenizer::evaluateEscapes(std::string &text)
 				setError("Invalid escape sequence");
 				return false;
 			}
+		} else {
+			evaluated.push_back(text[i]);
 		}
 	}
 
+	text = storeText(std::move(evaluated));
 	return true;
 }
 
@@ -81,25 +96,12 @@ HllTokenizer::Token HllTokenizer::getNext()
 	}
 
 	// If no literals matched, see if an identifier can be constructed
-	if(std::isalpha(buffer()[0]) || buffer()[0] == '_') {
-		size_t len = 0;
-		while(std::isalpha(buffer()[len]) || buffer()[len] == '_') {
-			len++;
-			if(!fillBuffer(len + 1)) {
-				break;
-			}
-		}
-
-		TokenType type = TypeIdentifier;
-		std::string string = buffer().substr(0, len);
+	if(identifierCharacters.contains(buffer()[0])) {
+		size_t len = spanCharacters(identifierCharacters, 0);
+		std::string_view string = buffer().substr(0, len);
 
 		// Check if the string is a keyword
-		for(std::string &keyword : keywords) {
-			if(string == keyword) {
-				type = TypeLiteral;
-				break;
-			}
-		}
+		TokenType type = keywords.contains(string) ? TypeLiteral : TypeIdentifier;
 
 		// Construct a token out of the characters found
 		next = createToken(type, string);
@@ -108,14 +110,8 @@ HllTokenizer::Token HllTokenizer::getNext()
 	}
 
 	// If an identifier couldn't be found, check for a number
-	if(std::isdigit(buffer()[0])) {
-		size_t len = 0;
-		while(std::isdigit(buffer()[len])) {
-			len++;
-			if(!fillBuffer(len + 1)) {
-				break;
-			}
-		}
+	if(digits.contains(buffer()[0])) {
+		size_t len = spanCharacters(digits, 0);
 
 		// Construct a token out of the characters found
 		next = createToken(TypeNumber, buffer().substr(0, len));
@@ -138,12 +134,11 @@ HllTokenizer::Token HllTokenizer::getNext()
 		}
 
 		// Construct a token out of the characters found
-		std::string text = buffer().substr(1, len - 1);
-		emptyBuffer(len + 1);
-
+		std::string_view text = buffer().substr(1, len - 1);
 		if(evaluateEscapes(text)) {
 			next = createToken(TypeString, text);
 		}
+		emptyBuffer(len + 1);
 		return next;
 	}
 
@@ -162,9 +157,7 @@ HllTokenizer::Token HllTokenizer::getNext()
 		}
 
 		// Construct a token out of the characters found
-		std::string text = buffer().substr(1, len - 1);
-		emptyBuffer(len + 1);
-
+		std::string_view text = buffer().substr(1, len - 1);
 		if(evaluateEscapes(text)) {
 			if(text.size() == 1) {
 				next = createToken(TypeChar, text);
@@ -172,6 +165,7 @@ HllTokenizer::Token HllTokenizer::getNext()
 				setError("Invalid character literal");
 			}
 		}
+		emptyBuffer(len + 1);
 		return next;
 	}
 
@@ -4,6 +4,7 @@
 #include "Input/Tokenizer.h"
 
 #include <string>
+#include <string_view>
 #include <vector>
 
 /*!
@@ -38,7 +39,7 @@ public:
 
 private:
 	virtual Token getNext();
-	bool evaluateEscapes(std::string &text);
+	bool evaluateEscapes(std::string_view &text);
 };
 }
 #endif
@@ -14,10 +14,13 @@ namespace Front {
 	/*!
 	 * \brief Generate an IR program
 	 * \param tree Syntax tree to process
+	 * \param classHierarchy Hierarchy of every class in the complete program, or null if it is not known
 	 * \return Generated IR program
 	 */
-	std::unique_ptr<IR::Program> IRGenerator::generate(const Program &program)
+	std::unique_ptr<IR::Program> IRGenerator::generate(const Program &program, const ClassHierarchy *classHierarchy)
 	{
+		mClassHierarchy = classHierarchy;
+
 		std::unique_ptr<IR::Program> irProgram = std::make_unique<IR::Program>();
 
 		// Create an IR procedure for each procedure definition node
@@ -25,7 +28,7 @@ namespace Front {
 			std::unique_ptr<IR::Procedure> irProcedure = std::make_unique<IR::Procedure>(procedure->name);
 
 			// Emit procedure prologue
-			irProcedure->emit(new IR::EntryThreeAddr(IR::Entry::Type::Prologue));
+			irProcedure->emit(irProcedure->newEntry<IR::EntryThreeAddr>(IR::Entry::Type::Prologue));
 
 			// Add local variables to the procedure
 			std::set<std::string> names;
@@ -43,7 +46,7 @@ namespace Front {
 						break;
 					}
 				}
-				std::unique_ptr<IR::Symbol> irSymbol = std::make_unique<IR::Symbol>(name, local->type->valueSize, local);
+				IR::Symbol *irSymbol = irProcedure->newSymbol(name, local->type->valueSize, local);
 
 				int arg = 0;
 				if(procedure->object) {
@@ -53,23 +56,23 @@ namespace Front {
 				for(Symbol *argument : procedure->arguments) {
 					if(argument == local) {
 						// If this symbol is an argument, emit an argument load instruction
-						irProcedure->emit(new IR::EntryThreeAddr(IR::Entry::Type::LoadArg, irSymbol.get(), 0, 0, arg));
+						irProcedure->emit(irProcedure->newEntry<IR::EntryThreeAddr>(IR::Entry::Type::LoadArg, irSymbol, nullptr, nullptr, arg));
 					}
 					arg++;
 				}
-				irProcedure->addSymbol(std::move(irSymbol));
+				irProcedure->addSymbol(irSymbol);
 			}
 
 			// Construct context
 			Context context{ *irProcedure, 0, 0 };
 			if(procedure->object) {
 				context.object = irProcedure->findSymbol(procedure->object);
-				irProcedure->emit(new IR::EntryThreeAddr(IR::Entry::Type::LoadArg, context.object, 0, 0, 0));
-				std::shared_ptr<TypeStruct> classType = procedure->scope->parent()->classType();
+				irProcedure->emit(irProcedure->newEntry<IR::EntryThreeAddr>(IR::Entry::Type::LoadArg, context.object, nullptr, nullptr, 0));
+				TypeStruct *classType = procedure->scope->parent()->classType();
 				if(procedure->name == classType->name + "." + classType->name && classType->vtableSize > 0) {
 					IR::Symbol *vtable = irProcedure->newTemp(4);
-					irProcedure->emit(new IR::EntryString(IR::Entry::Type::LoadAddress, vtable, classType->name + "$$vtable"));
-					irProcedure->emit(new IR::EntryThreeAddr(IR::Entry::Type::StoreMem, vtable, context.object, 0, classType->vtableOffset));
+					irProcedure->emit(irProcedure->newEntry<IR::EntryString>(IR::Entry::Type::LoadAddress, vtable, classType->name + "$$vtable"));
+					irProcedure->emit(irProcedure->newEntry<IR::EntryThreeAddr>(IR::Entry::Type::StoreMem, vtable, context.object, nullptr, classType->vtableOffset, IR::MemoryRegion(IR::MemoryRegion::Kind::Field, 4)));
 				}
 			} else {
 				context.object = 0;
@@ -79,21 +82,21 @@ namespace Front {
 			processNode(*procedure->body, context);
 
 			// If the procedure's return type is void, emit an return statement 
-			if(Type::equals(*procedure->type->returnType, *Types::intrinsic(Types::Void))) {
-				irProcedure->entries().insert(irProcedure->entries().end(), new IR::EntryThreeAddr(IR::Entry::Type::StoreRet, 0, 0));
+			if(procedure->type->returnType == Types::intrinsic(Types::Void)) {
+				irProcedure->entries().insert(irProcedure->entries().end(), irProcedure->newEntry<IR::EntryThreeAddr>(IR::Entry::Type::StoreRet, nullptr, nullptr));
 			}
 
 			// Emit function epilogue
-			irProcedure->entries().insert(irProcedure->entries().end(), new IR::EntryThreeAddr(IR::Entry::Type::Epilogue));
+			irProcedure->entries().insert(irProcedure->entries().end(), irProcedure->newEntry<IR::EntryThreeAddr>(IR::Entry::Type::Epilogue));
 
 			// Add procedure to procedure list
 			irProgram->addProcedure(std::move(irProcedure));
 		}
 
 		for(unsigned int i=0; i<program.types->types().size(); i++) {
-			std::shared_ptr<Type> type = program.types->types()[i];
-			if(type->kind == Type::Kind::Class && (std::static_pointer_cast<TypeStruct>(type))->vtableSize > 0) {
-				std::shared_ptr<TypeStruct> typeStruct = std::static_pointer_cast<TypeStruct>(type);
+			Type *type = program.types->types()[i];
+			if(type->kind == Type::Kind::Class && (static_cast<TypeStruct*>(type))->vtableSize > 0) {
+				TypeStruct *typeStruct = static_cast<TypeStruct*>(type);
 				std::string name = typeStruct->name + "$$vtable";
 				std::vector<std::string> vtable(typeStruct->vtableSize);
 				while(typeStruct) {
@@ -107,7 +110,7 @@ namespace Front {
 
 				std::unique_ptr<IR::Data> irData = std::make_unique<IR::Data>(name);
 				for(std::string &target : vtable) {
-					irData->entries().push_back(new IR::EntryCall(IR::Entry::Type::FunctionAddr, target));
+					irData->entries().push_back(irData->newEntry<IR::EntryCall>(IR::Entry::Type::FunctionAddr, target));
 				}
 				irProgram->addData(std::move(irData));
 			}
@@ -129,7 +132,7 @@ namespace Front {
 		switch(node.nodeType) {
 			case Node::Type::List:
 				// Process each item in the list
-				for(std::unique_ptr<Node> &child : node.children) {
+				for(Node *child : node.children) {
 					processNode(*child, context);
 				}
 				break;
@@ -146,7 +149,7 @@ namespace Front {
 					IR::EntryLabel *nextLabel = procedure.newLabel();
 
 					// Emit conditional jump instruction to either true label or label after statement
-					procedure.emit(new IR::EntryCJump(lhs, trueLabel, nextLabel));
+					procedure.emit(procedure.newEntry<IR::EntryCJump>(lhs, trueLabel, nextLabel));
 
 					// Process true body
 					procedure.emit(trueLabel);
@@ -160,12 +163,12 @@ namespace Front {
 					IR::EntryLabel *nextLabel = procedure.newLabel();
 
 					// Emit conditional jump instruction to either true label or false label
-					procedure.emit(new IR::EntryCJump(lhs, trueLabel, falseLabel));
+					procedure.emit(procedure.newEntry<IR::EntryCJump>(lhs, trueLabel, falseLabel));
 
 					// Process true body
 					procedure.emit(trueLabel);
 					processNode(*node.children[1], context);
-					procedure.emit(new IR::EntryJump(nextLabel));
+					procedure.emit(procedure.newEntry<IR::EntryJump>(nextLabel));
 
 					// Process false body
 					procedure.emit(falseLabel);
@@ -185,7 +188,7 @@ namespace Front {
 					// Emit test of predicate and conditional jump
 					procedure.emit(testLabel);
 					lhs = processRValue(*node.children[0], context);
-					procedure.emit(new IR::EntryCJump(lhs, mainLabel, nextLabel));
+					procedure.emit(procedure.newEntry<IR::EntryCJump>(lhs, mainLabel, nextLabel));
 
 					// Construct child context
 					Context childContext = context;
@@ -195,7 +198,7 @@ namespace Front {
 					// Emit body label
 					procedure.emit(mainLabel);
 					processNode(*node.children[1], childContext);
-					procedure.emit(new IR::EntryJump(testLabel));
+					procedure.emit(procedure.newEntry<IR::EntryJump>(testLabel));
 
 					// Emit label following statement
 					procedure.emit(nextLabel);
@@ -215,7 +218,7 @@ namespace Front {
 					// Emit test of predicate and conditional jump
 					procedure.emit(testLabel);
 					lhs = processRValue(*node.children[1], context);
-					procedure.emit(new IR::EntryCJump(lhs, mainLabel, nextLabel));
+					procedure.emit(procedure.newEntry<IR::EntryCJump>(lhs, mainLabel, nextLabel));
 
 					// Construct child context
 					Context childContext = context;
@@ -228,7 +231,7 @@ namespace Front {
 
 					procedure.emit(postLabel);
 					processNode(*node.children[2], context);
-					procedure.emit(new IR::EntryJump(testLabel));
+					procedure.emit(procedure.newEntry<IR::EntryJump>(testLabel));
 
 					// Emit label following statement
 					procedure.emit(nextLabel);
@@ -241,8 +244,8 @@ namespace Front {
 					rhs = processRValue(*node.children[0], context);
 
 					// Emit procedure return and jump to end block
-					procedure.emit(new IR::EntryThreeAddr(IR::Entry::Type::StoreRet, 0, rhs));
-					procedure.emit(new IR::EntryJump(procedure.end()));
+					procedure.emit(procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::StoreRet, nullptr, rhs));
+					procedure.emit(procedure.newEntry<IR::EntryJump>(procedure.end()));
 
 					// Emit label following statement
 					IR::EntryLabel *label = procedure.newLabel();
@@ -251,11 +254,11 @@ namespace Front {
 				}
 
 			case Node::Type::Break:
-				procedure.emit(new IR::EntryJump(context.breakTarget));
+				procedure.emit(procedure.newEntry<IR::EntryJump>(context.breakTarget));
 				break;
 
 			case Node::Type::Continue:
-				procedure.emit(new IR::EntryJump(context.continueTarget));
+				procedure.emit(procedure.newEntry<IR::EntryJump>(context.continueTarget));
 				break;
 
 			default:
@@ -280,10 +283,10 @@ namespace Front {
 			case Node::Type::Constant:
 				// Construct a temporary to contain the new value
 				result = procedure.newTemp(node.type->valueSize);
-				if(Type::equals(*node.type, *Types::intrinsic(Types::String))) {
-					procedure.emit(new IR::EntryString(IR::Entry::Type::LoadString, result, node.lexVal.s));
+				if(node.type == Types::intrinsic(Types::String)) {
+					procedure.emit(procedure.newEntry<IR::EntryString>(IR::Entry::Type::LoadString, result, std::string(node.lexVal.s)));
 				} else {
-					procedure.emit(new IR::EntryThreeAddr(IR::Entry::Type::Move, result, 0, 0, node.lexVal.i));
+					procedure.emit(procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::Move, result, nullptr, nullptr, node.lexVal.i));
 				}
 				break;
 
@@ -292,7 +295,7 @@ namespace Front {
 					// Emit the load from the calculated memory location
 					result = procedure.newTemp(node.type->valueSize);
 					Front::TypeStruct::Member *member = node.symbol->scope->classType()->findMember(node.lexVal.s);
-					procedure.emit(new IR::EntryThreeAddr(IR::Entry::Type::LoadMem, result, context.object, 0, member->offset));
+					procedure.emit(procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::LoadMem, result, context.object, nullptr, member->offset, IR::MemoryRegion(IR::MemoryRegion::Kind::Field, member->type->valueSize)));
 				} else {
 					// Return the already-existing variable node
 					result = procedure.findSymbol(node.symbol);
@@ -315,13 +318,13 @@ namespace Front {
 					if(lhs.nodeType == Node::Type::Id || lhs.nodeType == Node::Type::VarDecl) {
 						if(lhs.symbol->scope->classType()) {
 							Front::TypeStruct::Member *member = lhs.symbol->scope->classType()->findMember(lhs.lexVal.s);
-							procedure.emit(new IR::EntryThreeAddr(IR::Entry::Type::StoreMem, b, context.object, 0, member->offset));
+							procedure.emit(procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::StoreMem, b, context.object, nullptr, member->offset, IR::MemoryRegion(IR::MemoryRegion::Kind::Field, member->type->valueSize)));
 						} else {
 							// Locate symbol to assign into
 							a = procedure.findSymbol(lhs.symbol);
 
 							// Emit a move into the target symbol
-							procedure.emit(new IR::EntryThreeAddr(IR::Entry::Type::Move, a, b));
+							procedure.emit(procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::Move, a, b));
 						}
 					} else if(lhs.nodeType == Node::Type::Array) {
 						// Emit code to calculate the array's base address
@@ -332,16 +335,16 @@ namespace Front {
 
 						// Compute the offset into array memory based on subscript and type size
 						IR::Symbol *offset = procedure.newTemp(4);
-						procedure.emit(new IR::EntryThreeAddr(IR::Entry::Type::Mult, offset, subscript, 0, node.type->valueSize));
+						procedure.emit(procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::Mult, offset, subscript, nullptr, node.type->valueSize));
 
 						// Emit the store into the calculated memory location
-						procedure.emit(new IR::EntryThreeAddr(IR::Entry::Type::StoreMem, b, a, offset));
+						procedure.emit(procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::StoreMem, b, a, offset, 0, IR::MemoryRegion(IR::MemoryRegion::Kind::Element, node.type->valueSize)));
 					} else if(lhs.nodeType == Node::Type::Member) {
 						a = processRValue(*lhs.children[0], context);
 
-						std::shared_ptr<Front::TypeStruct> typeStruct = std::static_pointer_cast<Front::TypeStruct>(lhs.children[0]->type);
+						Front::TypeStruct *typeStruct = static_cast<Front::TypeStruct*>(lhs.children[0]->type);
 						Front::TypeStruct::Member *member = typeStruct->findMember(lhs.lexVal.s);
-						procedure.emit(new IR::EntryThreeAddr(IR::Entry::Type::StoreMem, b, a, 0, member->offset));
+						procedure.emit(procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::StoreMem, b, a, nullptr, member->offset, IR::MemoryRegion(IR::MemoryRegion::Kind::Field, member->type->valueSize)));
 					}
 
 					// Return the resulting node
@@ -352,8 +355,8 @@ namespace Front {
 			case Node::Type::Call:
 				{
 					Node &target = *node.children[0];
-					std::shared_ptr<Front::TypeStruct> classType;
-					IR::Symbol *object;
+					Front::TypeStruct *classType = 0;
+					IR::Symbol *object = 0;
 					std::string name;
 					IR::Entry *callEntry;
 					std::vector<IR::Symbol*> args;
@@ -370,7 +373,7 @@ namespace Front {
 						case Node::Type::Member:
 							{
 								Node &base = *target.children[0];
-								classType = std::static_pointer_cast<TypeStruct>(base.type);
+								classType = static_cast<TypeStruct*>(base.type);
 								name = target.lexVal.s;
 
 								if(base.symbol) {
@@ -384,17 +387,26 @@ namespace Front {
 					// Construct the call entry
 					if(classType) {
 						Front::TypeStruct::Member *member = classType->findMember(name);
-						if(member->qualifiers & TypeStruct::Member::QualifierVirtual) {
+
+						// A virtual call which can only reach one implementation is made directly
+						std::string directTarget;
+						if((member->qualifiers & TypeStruct::Member::QualifierVirtual) && mClassHierarchy) {
+							directTarget = mClassHierarchy->uniqueTarget(*classType, name);
+						}
+
+						if(directTarget != "") {
+							callEntry = procedure.newEntry<IR::EntryCall>(IR::Entry::Type::Call, directTarget);
+						} else if(member->qualifiers & TypeStruct::Member::QualifierVirtual) {
 							IR::Symbol *vtable = procedure.newTemp(4);
-							procedure.emit(new IR::EntryThreeAddr(IR::Entry::Type::LoadMem, vtable, object, 0, classType->vtableOffset));
+							procedure.emit(procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::LoadMem, vtable, object, nullptr, classType->vtableOffset, IR::MemoryRegion(IR::MemoryRegion::Kind::Field, 4)));
 							IR::Symbol *callTarget = procedure.newTemp(4);
-							procedure.emit(new IR::EntryThreeAddr(IR::Entry::Type::LoadMem, callTarget, vtable, 0, member->offset * 4));
-							callEntry = new IR::EntryThreeAddr(IR::Entry::Type::CallIndirect, 0, callTarget);
+							procedure.emit(procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::LoadMem, callTarget, vtable, nullptr, member->offset * 4, IR::MemoryRegion(IR::MemoryRegion::Kind::Field, 4)));
+							callEntry = procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::CallIndirect, nullptr, callTarget);
 						} else {
 							std::stringstream s;
 							s << classType->name << "." << name;
 							std::string name = s.str();
-							callEntry = new IR::EntryCall(IR::Entry::Type::Call, name);
+							callEntry = procedure.newEntry<IR::EntryCall>(IR::Entry::Type::Call, name);
 						}
 
 						if(!(member->qualifiers & TypeStruct::Member::QualifierStatic)) {
@@ -402,11 +414,11 @@ namespace Front {
 							args.push_back(object);
 						}
 					} else {
-						callEntry = new IR::EntryCall(IR::Entry::Type::Call, name);
+						callEntry = procedure.newEntry<IR::EntryCall>(IR::Entry::Type::Call, name);
 					}
 
 					// Emit code for each argument, building a list of resulting symbols
-					for(std::unique_ptr<Node> &argumentNode : node.children[1]->children) {
+					for(Node *argumentNode : node.children[1]->children) {
 						IR::Symbol *arg = processRValue(*argumentNode, context);
 						args.push_back(arg);
 					}
@@ -414,17 +426,17 @@ namespace Front {
 					// Emit argument store values for each argument
 					int argIndex = 0;
 					for(IR::Symbol *arg : args) {
-						procedure.emit(new IR::EntryThreeAddr(IR::Entry::Type::StoreArg, 0, arg, 0, argIndex));
+						procedure.emit(procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::StoreArg, nullptr, arg, nullptr, argIndex));
 						argIndex++;
 					}
 
 					// Emit procedure call
 					procedure.emit(callEntry);
 
-					if(!Type::equals(*node.type, *Types::intrinsic(Types::Void))) {
+					if(node.type != Types::intrinsic(Types::Void)) {
 						// Assign return value to a new temporary
 						result = procedure.newTemp(node.type->valueSize);
-						procedure.emit(new IR::EntryThreeAddr(IR::Entry::Type::LoadRet, result));
+						procedure.emit(procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::LoadRet, result));
 					} else {
 						result = 0;
 					}
@@ -438,47 +450,47 @@ namespace Front {
 
 					// Emit code for operator arguments
 					std::vector<IR::Symbol*> arguments;
-					for(std::unique_ptr<Node> &child : node.children) {
+					for(Node *child : node.children) {
 						arguments.push_back(processRValue(*child, context));
 					}
 
 					// Emit the appropriate type of arithmetic operation
 					switch(node.nodeSubtype) {
 					case Node::Subtype::Add:
-							if(Type::equals(*node.type, *Types::intrinsic(Types::String))) {
-								procedure.emit(new IR::EntryThreeAddr(IR::Entry::Type::StoreArg, 0, arguments[0], 0, 0));
-								procedure.emit(new IR::EntryThreeAddr(IR::Entry::Type::StoreArg, 0, arguments[1], 0, 1));
-								procedure.emit(new IR::EntryCall(IR::Entry::Type::Call, "__string_concat"));
-								procedure.emit(new IR::EntryThreeAddr(IR::Entry::Type::LoadRet, result));
+							if(node.type == Types::intrinsic(Types::String)) {
+								procedure.emit(procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::StoreArg, nullptr, arguments[0], nullptr, 0));
+								procedure.emit(procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::StoreArg, nullptr, arguments[1], nullptr, 1));
+								procedure.emit(procedure.newEntry<IR::EntryCall>(IR::Entry::Type::Call, "__string_concat"));
+								procedure.emit(procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::LoadRet, result));
 							} else {
-								procedure.emit(new IR::EntryThreeAddr(IR::Entry::Type::Add, result, arguments[0], arguments[1]));
+								procedure.emit(procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::Add, result, arguments[0], arguments[1]));
 							}
 							break;
 
 						case Node::Subtype::Subtract:
-							procedure.emit(new IR::EntryThreeAddr(IR::Entry::Type::Subtract, result, arguments[0], arguments[1]));
+							procedure.emit(procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::Subtract, result, arguments[0], arguments[1]));
 							break;
 
 						case Node::Subtype::Multiply:
-							procedure.emit(new IR::EntryThreeAddr(IR::Entry::Type::Mult, result, arguments[0], arguments[1]));
+							procedure.emit(procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::Mult, result, arguments[0], arguments[1]));
 							break;
 
 						case Node::Subtype::Divide:
-							procedure.emit(new IR::EntryThreeAddr(IR::Entry::Type::Divide, result, arguments[0], arguments[1]));
+							procedure.emit(procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::Divide, result, arguments[0], arguments[1]));
 							break;
 
 						case Node::Subtype::Modulo:
-							procedure.emit(new IR::EntryThreeAddr(IR::Entry::Type::Modulo, result, arguments[0], arguments[1]));
+							procedure.emit(procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::Modulo, result, arguments[0], arguments[1]));
 							break;
 
 						case Node::Subtype::Increment:
-							procedure.emit(new IR::EntryThreeAddr(IR::Entry::Type::Move, result, arguments[0]));
-							procedure.emit(new IR::EntryThreeAddr(IR::Entry::Type::Add, arguments[0], arguments[0], 0, 1));
+							procedure.emit(procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::Move, result, arguments[0]));
+							procedure.emit(procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::Add, arguments[0], arguments[0], nullptr, 1));
 							break;
 
 						case Node::Subtype::Decrement:
-							procedure.emit(new IR::EntryThreeAddr(IR::Entry::Type::Move, result, arguments[0]));
-							procedure.emit(new IR::EntryThreeAddr(IR::Entry::Type::Add, arguments[0], arguments[0], 0, -1));
+							procedure.emit(procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::Move, result, arguments[0]));
+							procedure.emit(procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::Add, arguments[0], arguments[0], nullptr, -1));
 							break;
 					}
 					break;
@@ -495,35 +507,35 @@ namespace Front {
 				// Emit the appropriate type of comparison operation
 				switch(node.nodeSubtype) {
 					case Node::Subtype::Equal:
-						procedure.emit(new IR::EntryThreeAddr(IR::Entry::Type::Equal, result, a, b));
+						procedure.emit(procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::Equal, result, a, b));
 						break;
 
 					case Node::Subtype::Nequal:
-						procedure.emit(new IR::EntryThreeAddr(IR::Entry::Type::Nequal, result, a, b));
+						procedure.emit(procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::Nequal, result, a, b));
 						break;
 
 					case Node::Subtype::LessThan:
-						procedure.emit(new IR::EntryThreeAddr(IR::Entry::Type::LessThan, result, a, b));
+						procedure.emit(procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::LessThan, result, a, b));
 						break;
 
 					case Node::Subtype::LessThanEqual:
-						procedure.emit(new IR::EntryThreeAddr(IR::Entry::Type::LessThanE, result, a, b));
+						procedure.emit(procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::LessThanE, result, a, b));
 						break;
 
 					case Node::Subtype::GreaterThan:
-						procedure.emit(new IR::EntryThreeAddr(IR::Entry::Type::GreaterThan, result, a, b));
+						procedure.emit(procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::GreaterThan, result, a, b));
 						break;
 
 					case Node::Subtype::GreaterThanEqual:
-						procedure.emit(new IR::EntryThreeAddr(IR::Entry::Type::GreaterThanE, result, a, b));
+						procedure.emit(procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::GreaterThanE, result, a, b));
 						break;
 
 					case Node::Subtype::Or:
-						procedure.emit(new IR::EntryThreeAddr(IR::Entry::Type::Or, result, a, b));
+						procedure.emit(procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::Or, result, a, b));
 						break;
 
 					case Node::Subtype::And:
-						procedure.emit(new IR::EntryThreeAddr(IR::Entry::Type::And, result, a, b));
+						procedure.emit(procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::And, result, a, b));
 						break;
 				}
 				break;
@@ -538,33 +550,33 @@ namespace Front {
 					IR::Symbol *size = procedure.newTemp(4);
 					if(arg.nodeType == Node::Type::Array && arg.children.size() == 2) {
 						// Array allocation: total size is typeSize * count
-						std::shared_ptr<Type> &type = arg.children[0]->type;
+						Type *type = arg.children[0]->type;
 						IR::Symbol *typeSize = procedure.newTemp(4);
-						procedure.emit(new IR::EntryThreeAddr(IR::Entry::Type::Move, typeSize, 0, 0, type->valueSize));
+						procedure.emit(procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::Move, typeSize, nullptr, nullptr, type->valueSize));
 
 						IR::Symbol *count = processRValue(*arg.children[1], context);
-						procedure.emit(new IR::EntryThreeAddr(IR::Entry::Type::Mult, size, typeSize, count));
-					} else if(Type::equals(*arg.type, *Types::intrinsic(Types::String))) {
+						procedure.emit(procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::Mult, size, typeSize, count));
+					} else if(arg.type == Types::intrinsic(Types::String)) {
 						// String allocation: total size is constructor argument value
 						size = processRValue(*node.children[1]->children[0], context);
 					} else {
 						// Single allocation: total size is type's allocSize
-						std::shared_ptr<Type> &type = arg.type;
-						procedure.emit(new IR::EntryThreeAddr(IR::Entry::Type::Move, size, 0, 0, type->allocSize));
+						Type *type = arg.type;
+						procedure.emit(procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::Move, size, nullptr, nullptr, type->allocSize));
 					}
 
 					// Emit new entry
-					procedure.emit(new IR::EntryThreeAddr(IR::Entry::Type::New, result, size));
+					procedure.emit(procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::New, result, size));
 
 					// If the type is a class with a constructor, emit a call to it
-					if(arg.type->kind == Type::Kind::Class && std::static_pointer_cast<TypeStruct>(arg.type)->constructor) {
+					if(arg.type->kind == Type::Kind::Class && static_cast<TypeStruct*>(arg.type)->constructor) {
 						std::vector<IR::Symbol*> args;
 
 						// First argument is the object
 						args.push_back(result);
 
 						// Emit code for each argument, building a list of resulting symbols
-						for(std::unique_ptr<Node> &child : node.children[1]->children) {
+						for(Node *child : node.children[1]->children) {
 							IR::Symbol *arg = processRValue(*child, context);
 							args.push_back(arg);
 						}
@@ -572,13 +584,13 @@ namespace Front {
 						// Emit argument store values for each argument
 						int argIndex = 0;
 						for(IR::Symbol *arg : args) {
-							procedure.emit(new IR::EntryThreeAddr(IR::Entry::Type::StoreArg, 0, arg, 0, argIndex));
+							procedure.emit(procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::StoreArg, nullptr, arg, nullptr, argIndex));
 							argIndex++;
 						}
 
 						// Emit procedure call
 						std::string name = arg.type->name + "." + arg.type->name;
-						procedure.emit(new IR::EntryCall(IR::Entry::Type::Call, name));
+						procedure.emit(procedure.newEntry<IR::EntryCall>(IR::Entry::Type::Call, name));
 					}
 
 					break;
@@ -598,11 +610,11 @@ namespace Front {
 					IR::Symbol *offset = procedure.newTemp(4);
 					IR::Symbol *size = procedure.newTemp(4);
 
-					procedure.emit(new IR::EntryThreeAddr(IR::Entry::Type::Move, size, 0, 0, node.type->valueSize));
-					procedure.emit(new IR::EntryThreeAddr(IR::Entry::Type::Mult, offset, subscript, size));
+					procedure.emit(procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::Move, size, nullptr, nullptr, node.type->valueSize));
+					procedure.emit(procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::Mult, offset, subscript, size));
 
 					// Emit the load from the calculated memory location
-					procedure.emit(new IR::EntryThreeAddr(IR::Entry::Type::LoadMem, result, base, offset));
+					procedure.emit(procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::LoadMem, result, base, offset, 0, IR::MemoryRegion(IR::MemoryRegion::Kind::Element, node.type->valueSize)));
 					break;
 				}
 
@@ -612,11 +624,11 @@ namespace Front {
 
 					IR::Symbol *base = processRValue(*node.children[0], context);
 
-					std::shared_ptr<Front::TypeStruct> typeStruct = std::static_pointer_cast<Front::TypeStruct>(node.children[0]->type);
+					Front::TypeStruct *typeStruct = static_cast<Front::TypeStruct*>(node.children[0]->type);
 					Front::TypeStruct::Member *member = typeStruct->findMember(node.lexVal.s);
 
 					// Emit the load from the calculated memory location
-					procedure.emit(new IR::EntryThreeAddr(IR::Entry::Type::LoadMem, result, base, 0, member->offset));
+					procedure.emit(procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::LoadMem, result, base, nullptr, member->offset, IR::MemoryRegion(IR::MemoryRegion::Kind::Field, member->type->valueSize)));
 					break;
 				}
 
@@ -625,24 +637,24 @@ namespace Front {
 					IR::Symbol *source = processRValue(*node.children[0], context);
 
 					// Emit the appropriate entry for the type of conversion taking place
-					if(Type::equals(*node.type, *Types::intrinsic(Types::String))) {
+					if(node.type == Types::intrinsic(Types::String)) {
 						result = procedure.newTemp(node.type->valueSize);
 
-						std::shared_ptr<Type> &sourceType = node.children[0]->type;
-						if(Type::equals(*sourceType, *Types::intrinsic(Types::Bool))) {
-							procedure.emit(new IR::EntryThreeAddr(IR::Entry::Type::StoreArg, 0, source, 0, 0));
-							procedure.emit(new IR::EntryCall(IR::Entry::Type::Call, "__string_bool"));
-							procedure.emit(new IR::EntryThreeAddr(IR::Entry::Type::LoadRet, result));
-						} else if(Type::equals(*sourceType, *Types::intrinsic(Types::Int))) {
-							procedure.emit(new IR::EntryThreeAddr(IR::Entry::Type::StoreArg, 0, source, 0, 0));
-							procedure.emit(new IR::EntryCall(IR::Entry::Type::Call, "__string_int"));
-							procedure.emit(new IR::EntryThreeAddr(IR::Entry::Type::LoadRet, result));
-						} else if(Type::equals(*sourceType, *Types::intrinsic(Types::Char))) {
-							procedure.emit(new IR::EntryThreeAddr(IR::Entry::Type::StoreArg, 0, source, 0, 0));
-							procedure.emit(new IR::EntryCall(IR::Entry::Type::Call, "__string_char"));
-							procedure.emit(new IR::EntryThreeAddr(IR::Entry::Type::LoadRet, result));
-						} else if(sourceType->kind == Type::Kind::Array && Type::equals(*std::static_pointer_cast<Front::TypeArray>(sourceType)->baseType, *Types::intrinsic(Types::Char))) {
-							procedure.emit(new IR::EntryThreeAddr(IR::Entry::Type::Move, result, source));
+						Type *sourceType = node.children[0]->type;
+						if(sourceType == Types::intrinsic(Types::Bool)) {
+							procedure.emit(procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::StoreArg, nullptr, source, nullptr, 0));
+							procedure.emit(procedure.newEntry<IR::EntryCall>(IR::Entry::Type::Call, "__string_bool"));
+							procedure.emit(procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::LoadRet, result));
+						} else if(sourceType == Types::intrinsic(Types::Int)) {
+							procedure.emit(procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::StoreArg, nullptr, source, nullptr, 0));
+							procedure.emit(procedure.newEntry<IR::EntryCall>(IR::Entry::Type::Call, "__string_int"));
+							procedure.emit(procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::LoadRet, result));
+						} else if(sourceType == Types::intrinsic(Types::Char)) {
+							procedure.emit(procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::StoreArg, nullptr, source, nullptr, 0));
+							procedure.emit(procedure.newEntry<IR::EntryCall>(IR::Entry::Type::Call, "__string_char"));
+							procedure.emit(procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::LoadRet, result));
+						} else if(sourceType->kind == Type::Kind::Array && static_cast<Front::TypeArray*>(sourceType)->baseType == Types::intrinsic(Types::Char)) {
+							procedure.emit(procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::Move, result, source));
 						}
 					} else {
 						result = source;
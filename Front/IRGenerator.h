@@ -7,6 +7,7 @@
 
 #include "Front/Node.h"
 #include "Front/Program.h"
+#include "Front/ClassHierarchy.h"
 
 #include <string>
 
@@ -16,7 +17,7 @@ namespace Front {
 	 */
 	class IRGenerator {
 	public:
-		std::unique_ptr<IR::Program> generate(const Program &program);
+		std::unique_ptr<IR::Program> generate(const Program &program, const ClassHierarchy *classHierarchy = nullptr);
 
 	private:
 		struct Context {
@@ -28,6 +29,8 @@ namespace Front {
 
 		void processNode(Node &node, Context &context);
 		IR::Symbol *processRValue(Node &node, Context &context);
+
+		const ClassHierarchy *mClassHierarchy; //!< Class hierarchy used to resolve virtual calls, if known
 	};
 }
 
@@ -0,0 +1,86 @@
+#include "Front/Names.h"
+
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+namespace Front {
+	/*!
+	 * \brief Storage for the name table
+	 */
+	struct NameTable {
+		std::deque<std::string> strings; //!< Interned names, indexed by id
+		std::unordered_map<std::string_view, Names::Id> ids; //!< Id of each name, keyed on views of the stored names
+		std::shared_mutex mutex; //!< Guards the table; lookups share it, insertions take it exclusively
+	};
+
+	/*!
+	 * \brief Retrieve the global name table
+	 * \return Name table
+	 */
+	static NameTable &nameTable()
+	{
+		static NameTable table;
+		return table;
+	}
+
+	/*!
+	 * \brief Intern a name, assigning it an id if it has not been seen before
+	 * \param name Name to intern
+	 * \return Id of name
+	 */
+	Names::Id Names::intern(std::string_view name)
+	{
+		NameTable &table = nameTable();
+		{
+			std::shared_lock<std::shared_mutex> lock(table.mutex);
+			auto it = table.ids.find(name);
+			if(it != table.ids.end()) {
+				return it->second;
+			}
+		}
+
+		// Check again under the exclusive lock, in case another thread added the name
+		std::unique_lock<std::shared_mutex> lock(table.mutex);
+		auto it = table.ids.find(name);
+		if(it != table.ids.end()) {
+			return it->second;
+		}
+
+		Id id = (Id)table.strings.size();
+		table.strings.emplace_back(name);
+		table.ids.emplace(table.strings.back(), id);
+		return id;
+	}
+
+	/*!
+	 * \brief Look up the id of a name without interning it
+	 * \param name Name to search for
+	 * \return Id of name, or Invalid if the name has never been interned
+	 */
+	Names::Id Names::find(std::string_view name)
+	{
+		NameTable &table = nameTable();
+		std::shared_lock<std::shared_mutex> lock(table.mutex);
+		auto it = table.ids.find(name);
+		if(it == table.ids.end()) {
+			return Invalid;
+		}
+
+		return it->second;
+	}
+
+	/*!
+	 * \brief Retrieve the text of an interned name
+	 * \param id Name id
+	 * \return Name, valid for the lifetime of the program
+	 */
+	std::string_view Names::string(Id id)
+	{
+		NameTable &table = nameTable();
+		std::shared_lock<std::shared_mutex> lock(table.mutex);
+		return table.strings[id];
+	}
+}
@@ -0,0 +1,25 @@
+#ifndef FRONT_NAMES_H
+#define FRONT_NAMES_H
+
+#include <string_view>
+
+namespace Front {
+	/*!
+	 * \brief Global table of interned names
+	 *
+	 * Every distinct name is stored once and assigned a small integer id, so that
+	 * symbol, type and member tables can be keyed on ids instead of strings.  The
+	 * table is shared by all compilations in the process, and is safe to use from
+	 * multiple threads.
+	 */
+	class Names {
+	public:
+		typedef unsigned int Id;
+		static const Id Invalid = ~0u; //!< Id of a name that has never been interned
+
+		static Id intern(std::string_view name);
+		static Id find(std::string_view name);
+		static std::string_view string(Id id);
+	};
+}
+#endif
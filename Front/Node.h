@@ -4,10 +4,34 @@
 #include "Front/Type.h"
 #include "Front/Symbol.h"
 
-#include <vector>
+#include <string_view>
 #include <iostream>
 
 namespace Front {
+	struct Node;
+
+	/*!
+	 * \brief Span of child node pointers, stored in the syntax tree's arena
+	 *
+	 * Lists are grown only through SyntaxTree::addChild, which owns the storage.
+	 */
+	class NodeList {
+	public:
+		NodeList() : mNodes(0), mSize(0), mCapacity(0) {}
+
+		Node **begin() const { return mNodes; } //!< First child
+		Node **end() const { return mNodes + mSize; } //!< Past the last child
+		size_t size() const { return mSize; } //!< Number of children
+		Node *&operator[](size_t index) const { return mNodes[index]; } //!< Child at given index
+
+	private:
+		friend class SyntaxTree;
+
+		Node **mNodes; //!< Child pointers
+		unsigned int mSize; //!< Number of children
+		unsigned int mCapacity; //!< Number of child pointers available before the span must be reallocated
+	};
+
 	/*!
 	 * \brief Abstract syntax tree node
 	 */
@@ -72,15 +96,15 @@ namespace Front {
 		Node::Type nodeType; //!< Node type
 		Node::Subtype nodeSubtype; //!< Node subtype
 		int line; //!< Line in source file corresponding to node
-		std::vector<std::unique_ptr<Node>> children; //!< Children of node
-		std::shared_ptr<Front::Type> type; //!< Assigned type of language element represented by node
+		NodeList children; //!< Children of node
+		Front::Type *type; //!< Assigned type of language element represented by node
 
 		/*!
 		 * \brief Structure containing various lexical types that can be associated with the node
 		 */
 		struct LexVal {
 			int i; //!< Integer value
-			std::string s; //!< String value
+			std::string_view s; //!< String value, interned in the syntax tree
 		};
 		LexVal lexVal; //!< Lexical value from tokenizer
 
@@ -6,7 +6,7 @@ namespace Front {
 	void printNode(Node &node, std::ostream &o, std::string prefix)
 	{
 		o << prefix << node << std::endl;
-		for(std::unique_ptr<Node> &child : node.children) {
+		for(Node *child : node.children) {
 			printNode(*child, o, prefix + "  ");
 		}
 	}
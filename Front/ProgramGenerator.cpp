@@ -30,7 +30,7 @@ namespace Front {
 	 * \brief Constructor
 	 * \param tree Abstract syntax tree
 	 */
-	ProgramGenerator::ProgramGenerator(Node &tree, std::unique_ptr<Types> types, std::unique_ptr<Scope> scope)
+	ProgramGenerator::ProgramGenerator(SyntaxTree &tree, std::unique_ptr<Types> types, std::unique_ptr<Scope> scope)
 		: mTree(tree)
 	{
 		mTypes = std::move(types);
@@ -50,7 +50,7 @@ namespace Front {
 			program->scope = std::move(mScope);
 
 			// Iterate through the tree's procedure definitions
-			for(std::unique_ptr<Node> &node : mTree.children) {
+			for(Node *node : mTree.root().children) {
 				switch(node->nodeType) {
 					case Node::Type::ProcedureDef:
 						addProcedure(*node, *program, *program->scope, false);
@@ -58,9 +58,9 @@ namespace Front {
 
 					case Node::Type::ClassDef:
 						{
-							std::shared_ptr<TypeStruct> typeStruct = std::static_pointer_cast<TypeStruct>(program->types->findType(node->lexVal.s));
+							TypeStruct *typeStruct = static_cast<TypeStruct*>(program->types->findType(node->lexVal.s));
 							Node &members = *node->children[node->children.size() - 1];
-							for(std::unique_ptr<Node> &child : members.children) {
+							for(Node *child : members.children) {
 								Node &qualifiersNode = *child->children[0];
 								Node &memberNode = *child->children[1];
 								TypeStruct::Member *member = typeStruct->findMember(memberNode.lexVal.s);
@@ -105,28 +105,29 @@ namespace Front {
 
 	/*!
 	 * \brief Coerce a node to a specified type
+	 * \param tree Tree containing node
 	 * \param node Node to coerce
 	 * \param type Desired type
 	 * \return New node
 	 */
-	std::unique_ptr<Node> coerce(std::unique_ptr<Node> node, std::shared_ptr<Type> &type)
+	Node *coerce(SyntaxTree &tree, Node *node, Type *type)
 	{
 		// If node is already of the given type, do nothing
-		if(!Type::equals(*node->type, *type)) {
+		if(node->type != type) {
 			bool valid = false;
 
-			if(Type::equals(*type, *Types::intrinsic(Types::String))) {
-				if(Type::equals(*node->type, *Types::intrinsic(Types::Bool)) ||
-				   Type::equals(*node->type, *Types::intrinsic(Types::Int)) ||
-				   Type::equals(*node->type, *Types::intrinsic(Types::Char)))	{
+			if(type == Types::intrinsic(Types::String)) {
+				if(node->type == Types::intrinsic(Types::Bool) ||
+				   node->type == Types::intrinsic(Types::Int) ||
+				   node->type == Types::intrinsic(Types::Char))	{
 					valid = true;
-				} else if(node->type->kind == Type::Kind::Array && Type::equals(*(std::static_pointer_cast<Front::TypeArray>(node->type)->baseType), *Types::intrinsic(Types::Char))) {
+				} else if(node->type->kind == Type::Kind::Array && (static_cast<Front::TypeArray*>(node->type)->baseType) == Types::intrinsic(Types::Char)) {
 					valid = true;
 				}
 			} else if(type->kind == Type::Kind::Class && node->type->kind == Type::Kind::Class) {
-				std::shared_ptr<TypeStruct> classType = std::static_pointer_cast<TypeStruct>(node->type);
+				TypeStruct *classType = static_cast<TypeStruct*>(node->type);
 				while(classType) {
-					if(Type::equals(*classType, *type)) {
+					if(classType == type) {
 						valid = true;
 						break;
 					}
@@ -140,13 +141,10 @@ namespace Front {
 				throw TypeError(*node, s.str());
 			}
 
-			std::unique_ptr<Node> coerce = std::make_unique<Node>();
-			coerce->nodeType = Node::Type::Coerce;
-			coerce->nodeSubtype = Node::Subtype::None;
-			coerce->line = node->line;
+			Node *coerce = tree.newNode(Node::Type::Coerce, node->line);
 			coerce->type = type;
-			coerce->children.push_back(std::move(node));
-			node = std::move(coerce);
+			tree.addChild(*coerce, node);
+			node = coerce;
 		}
 
 		return node;
@@ -154,13 +152,14 @@ namespace Front {
 
 	/*!
 	 * \brief Coerce all children of a node to a given type
+	 * \param tree Tree containing node
 	 * \param node Node to process
 	 * \param type Type to coerce to
 	 */
-	void coerceChildren(Node &node, std::shared_ptr<Type> &type)
+	void coerceChildren(SyntaxTree &tree, Node &node, Type *type)
 	{
 		for(unsigned int i=0; i<node.children.size(); i++) {
-			node.children[i] = coerce(std::move(node.children[i]), type);
+			node.children[i] = coerce(tree, node.children[i], type);
 		}
 	}
 
@@ -172,8 +171,8 @@ namespace Front {
 	 */
 	bool isChildOfType(Node &node, Type &type)
 	{
-		for(std::unique_ptr<Node> &child : node.children) {
-			if(Type::equals(*child->type, type)) {
+		for(Node *child : node.children) {
+			if(child->type == &type) {
 				return true;
 			}
 		}
@@ -193,7 +192,7 @@ namespace Front {
 		// Construct a procedure object
 		std::unique_ptr<Procedure> procedure = std::make_unique<Procedure>();
 		Symbol *symbol = scope.findSymbol(node.lexVal.s);
-		procedure->type = std::static_pointer_cast<TypeProcedure>(symbol->type);
+		procedure->type = static_cast<TypeProcedure*>(symbol->type);
 
 		// Begin populating the procedure object
 		if(scope.classType()) {
@@ -219,12 +218,12 @@ namespace Front {
 		Node &argumentList = *node.children[1];
 		for(unsigned int i=0; i<argumentList.children.size(); i++) {
 			// Construct a symbol for the argument, and add it to the procedure's scope and argument list
-			std::unique_ptr<Symbol> argument = std::make_unique<Symbol>(procedure->type->argumentTypes[i], argumentList.children[i]->lexVal.s);
+			std::unique_ptr<Symbol> argument = std::make_unique<Symbol>(procedure->type->argumentTypes[i], std::string(argumentList.children[i]->lexVal.s));
 			procedure->arguments.push_back(argument.get());
 			procedure->scope->addSymbol(std::move(argument));
 		}
 
-		procedure->body = node.children[2].get();
+		procedure->body = node.children[2];
 		node.type = Types::intrinsic(Types::Void);
 
 		// Add the procedure to the program's procedure list
@@ -236,17 +235,17 @@ namespace Front {
 	 * \param node Node describing type
 	 * \return Type
 	 */
-	std::shared_ptr<Type> ProgramGenerator::createType(Node &node, Types *types)
+	Type *ProgramGenerator::createType(Node &node, Types *types)
 	{
-		std::shared_ptr<Type> type;
+		Type *type;
 		if(node.nodeType == Node::Type::Array) {
 			type = createType(*node.children[0], types);
-			if(Type::equals(*type, *Types::intrinsic(Types::Void))) {
+			if(type == Types::intrinsic(Types::Void)) {
 				throw TypeError(node, "Cannot declare array of voids");
 			}
-			type = std::make_shared<TypeArray>(type);
+			type = types->arrayType(type);
 		} else {
-			std::string name = node.lexVal.s;
+			std::string name(node.lexVal.s);
 			type = types->findType(name);
 			if(!type) {
 				std::stringstream s;
@@ -283,7 +282,7 @@ namespace Front {
 						throw TypeError(node, "Expression does not evaluate to a procedure");
 					}
 
-					std::shared_ptr<TypeProcedure> procedureType = std::static_pointer_cast<TypeProcedure>(procedureNode.type);
+					TypeProcedure *procedureType = static_cast<TypeProcedure*>(procedureNode.type);
 					Node &argumentsNode = *node.children[1];
 
 					// Check call target has correct number of parameters
@@ -295,7 +294,7 @@ namespace Front {
 
 					// Coerce call arguments to proper types
 					for(unsigned int i=0; i<argumentsNode.children.size(); i++) {
-						argumentsNode.children[i] = coerce(std::move(argumentsNode.children[i]), procedureType->argumentTypes[i]);
+						argumentsNode.children[i] = coerce(mTree, argumentsNode.children[i], procedureType->argumentTypes[i]);
 					}
 
 					// Checks succeeded, assign return type to the call node
@@ -306,12 +305,12 @@ namespace Front {
 			case Node::Type::VarDecl:
 				{
 					// Add the declared variable to the current scope
-					std::shared_ptr<Type> type = createType(*node.children[0], context.types);
-					if(Type::equals(*type, *Types::intrinsic(Types::Void))) {
+					Type *type = createType(*node.children[0], context.types);
+					if(type == Types::intrinsic(Types::Void)) {
 						throw TypeError(node, "Cannot declare variable of void type");
 					}
 
-					std::unique_ptr<Symbol> symbol = std::make_unique<Symbol>(type, node.lexVal.s);
+					std::unique_ptr<Symbol> symbol = std::make_unique<Symbol>(type, std::string(node.lexVal.s));
 					node.type = type;
 					node.symbol = symbol.get();
 					context.scope->addSymbol(std::move(symbol));
@@ -322,7 +321,7 @@ namespace Front {
 				{
 					checkChildren(node, context);
 
-					node.children[1] = coerce(std::move(node.children[1]), node.children[0]->type);
+					node.children[1] = coerce(mTree, node.children[1], node.children[0]->type);
 
 					Node &lhs = *node.children[0];
 					Node &rhs = *node.children[1];
@@ -336,7 +335,7 @@ namespace Front {
 							throw TypeError(node, "Lvalue required");
 					}
 
-					if(lhs.nodeType == Node::Type::Array && Type::equals(*lhs.children[0]->type, *Types::intrinsic(Types::String))) {
+					if(lhs.nodeType == Node::Type::Array && lhs.children[0]->type == Types::intrinsic(Types::String)) {
 						throw TypeError(node, "String elements cannot be assigned to");
 					}
 
@@ -352,7 +351,7 @@ namespace Front {
 					context.scope->addChild(std::move(scope));
 
 					checkChildren(node, childContext);
-					if(!Type::equals(*node.children[0]->type, *Types::intrinsic(Types::Bool))) {
+					if(node.children[0]->type != Types::intrinsic(Types::Bool)) {
 						throw TypeError(node, "Type mismatch");
 					}
 
@@ -369,7 +368,7 @@ namespace Front {
 					childContext.inLoop = true;
 
 					checkChildren(node, childContext);
-					if(!Type::equals(*node.children[0]->type, *Types::intrinsic(Types::Bool))) {
+					if(node.children[0]->type != Types::intrinsic(Types::Bool)) {
 						throw TypeError(node, "Type mismatch");
 					}
 
@@ -386,7 +385,7 @@ namespace Front {
 					childContext.inLoop = true;
 
 					checkChildren(node, childContext);
-					if(!Type::equals(*node.children[1]->type, *Types::intrinsic(Types::Bool))) {
+					if(node.children[1]->type != Types::intrinsic(Types::Bool)) {
 						throw TypeError(node, "Type mismatch");
 					}
 
@@ -400,7 +399,7 @@ namespace Front {
 				switch(node.nodeSubtype) {
 					case Node::Subtype::And:
 					case Node::Subtype::Or:
-						coerceChildren(node, Types::intrinsic(Types::Bool));
+						coerceChildren(mTree, node, Types::intrinsic(Types::Bool));
 						break;
 
 					default:
@@ -408,9 +407,9 @@ namespace Front {
 							Types::Intrinsic intrinsics[] = { Types::Int, Types::Bool, Types::Char };
 							bool found = false;
 							for(Types::Intrinsic &intrinsic : intrinsics) {
-								std::shared_ptr<Type> type = Types::intrinsic(intrinsic);
+								Type *type = Types::intrinsic(intrinsic);
 								if(isChildOfType(node, *type)) {
-									coerceChildren(node, type);
+									coerceChildren(mTree, node, type);
 									found = true;
 									break;
 								}
@@ -431,12 +430,12 @@ namespace Front {
 					checkChildren(node, context);
 
 					if(node.nodeSubtype == Node::Subtype::Add && isChildOfType(node, *Types::intrinsic(Types::String))) {
-						coerceChildren(node, Types::intrinsic(Types::String));
+						coerceChildren(mTree, node, Types::intrinsic(Types::String));
 						node.type = Types::intrinsic(Types::String);
 					} else if(node.nodeSubtype == Node::Subtype::Add && isChildOfType(node, *Types::intrinsic(Types::Char)) && isChildOfType(node, *Types::intrinsic(Types::Int))) {
 						node.type = Types::intrinsic(Types::Char);
 					} else {
-						coerceChildren(node, Types::intrinsic(Types::Int));
+						coerceChildren(mTree, node, Types::intrinsic(Types::Int));
 						node.type = Types::intrinsic(Types::Int);
 					}
 					break;
@@ -445,7 +444,7 @@ namespace Front {
 			case Node::Type::Id:
 				{
 					// Search for the named symbol in the current scope
-					std::string name = node.lexVal.s;
+					std::string name(node.lexVal.s);
 					Symbol *symbol = context.scope->findSymbol(name);
 					if(!symbol) {
 						std::stringstream s;
@@ -470,14 +469,14 @@ namespace Front {
 				break;
 
 			case Node::Type::Return:
-				if(Type::equals(*context.procedure.type->returnType, *Types::intrinsic(Types::Void))) {
+				if(context.procedure.type->returnType == Types::intrinsic(Types::Void)) {
 					throw TypeError(node, "Return statement in void procedure");
 				}
 
 				checkType(*node.children[0], context);
 
 				// Coerce the return argument to the procedure's return type
-				node.children[0] = coerce(std::move(node.children[0]), context.procedure.type->returnType);
+				node.children[0] = coerce(mTree, node.children[0], context.procedure.type->returnType);
 				node.type = Types::intrinsic(Types::Void);
 				break;
 
@@ -488,14 +487,14 @@ namespace Front {
 					node.type = typeNode.type;
 
 					// Strings can't be allocated, only created from literals or coerced from char[]
-					if(Type::equals(*typeNode.type, *Types::intrinsic(Types::String))) {
+					if(typeNode.type == Types::intrinsic(Types::String)) {
 						throw TypeError(typeNode, "Cannot allocate string type");
 					}
 
 					// Check array size argument
 					if(typeNode.nodeType == Node::Type::Array && typeNode.children.size() > 1) {
 						checkType(*typeNode.children[1], context);
-						if(!Type::equals(*typeNode.children[1]->type, *Types::intrinsic(Types::Int))) {
+						if(typeNode.children[1]->type != Types::intrinsic(Types::Int)) {
 							throw TypeError(*typeNode.children[1], "Non-integral type used for array size");
 						}
 					}
@@ -506,7 +505,7 @@ namespace Front {
 						checkType(argsNode, context);
 
 						if(typeNode.type->kind == Type::Kind::Class) {
-							std::shared_ptr<TypeStruct> typeStruct = std::static_pointer_cast<TypeStruct>(typeNode.type);
+							TypeStruct *typeStruct = static_cast<TypeStruct*>(typeNode.type);
 
 							// First, check all child nodes
 							checkChildren(argsNode, context);
@@ -519,7 +518,7 @@ namespace Front {
 
 								// Coerce call arguments to proper types
 								for(unsigned int i=0; i<argsNode.children.size(); i++) {
-									argsNode.children[i] = coerce(std::move(argsNode.children[i]), typeStruct->constructor->argumentTypes[i]);
+									argsNode.children[i] = coerce(mTree, argsNode.children[i], typeStruct->constructor->argumentTypes[i]);
 								}
 							} else {
 								if(argsNode.children.size() != 0) {
@@ -543,16 +542,16 @@ namespace Front {
 					Node &subscriptNode = *node.children[1];
 
 					// Check array subscript
-					if(!Type::equals(*subscriptNode.type, *Types::intrinsic(Types::Int))) {
+					if(subscriptNode.type != Types::intrinsic(Types::Int)) {
 						throw TypeError(subscriptNode, "Non-integral subscript");
 					}
 
-					if(Type::equals(*baseNode.type, *Types::intrinsic(Types::String))) {
+					if(baseNode.type == Types::intrinsic(Types::String)) {
 						// Indexing a string produces a character
 						node.type = Types::intrinsic(Types::Char);
 					} else if(baseNode.type->kind == Type::Kind::Array) {
 						// Indexing an array produces its base type
-						std::shared_ptr<TypeArray> typeArray = std::static_pointer_cast<TypeArray>(baseNode.type);
+						TypeArray *typeArray = static_cast<TypeArray*>(baseNode.type);
 						node.type = typeArray->baseType;
 					} else {
 						throw TypeError(baseNode, "Attempt to take subscript of illegal object");
@@ -580,7 +579,7 @@ namespace Front {
 				Node &base = *node.children[0];
 
 				bool typeName;
-				std::shared_ptr<TypeStruct> baseType = std::static_pointer_cast<TypeStruct>(context.types->findType(base.lexVal.s));
+				TypeStruct *baseType = static_cast<TypeStruct*>(context.types->findType(base.lexVal.s));
 				if(baseType) {
 					base.type = baseType;
 					typeName = true;
@@ -591,7 +590,7 @@ namespace Front {
 
 				if(base.type->kind == Type::Kind::Struct || base.type->kind == Type::Kind::Class) {
 					// Check structure field
-					std::shared_ptr<TypeStruct> typeStruct = std::static_pointer_cast<TypeStruct>(base.type);
+					TypeStruct *typeStruct = static_cast<TypeStruct*>(base.type);
 					TypeStruct::Member *member = typeStruct->findMember(node.lexVal.s);
 					if(member) {
 						if(typeName && !(member->qualifiers & TypeStruct::Member::QualifierStatic)) {
@@ -617,7 +616,7 @@ namespace Front {
 	 */
 	void ProgramGenerator::checkChildren(Node &node, Context &context)
 	{
-		for(std::unique_ptr<Node> &child : node.children) {
+		for(Node *child : node.children) {
 			checkType(*child, context);
 		}
 	}
@@ -7,7 +7,7 @@ namespace Front {
 	* \param procedure Procedure containing scope
 	*/
 	Scope::Scope()
-		: mParent(0)
+		: mParent(0), mClassType(0)
 	{
 	}
 
@@ -16,10 +16,9 @@ namespace Front {
 	* \param parent Parent scope
 	* \param procedure Procedure containing scope
 	*/
-	Scope::Scope(std::shared_ptr<TypeStruct> &classType)
-		: mParent(0)
+	Scope::Scope(TypeStruct *classType)
+		: mParent(0), mClassType(classType)
 	{
-		mClassType = classType;
 	}
 
 	/*!
@@ -29,6 +28,7 @@ namespace Front {
 	bool Scope::addSymbol(std::unique_ptr<Symbol> symbol)
 	{
 		symbol->scope = this;
+		mSymbolNames.emplace(Names::intern(symbol->name), symbol.get());
 		mSymbols.push_back(std::move(symbol));
 		return true;
 	}
@@ -38,12 +38,27 @@ namespace Front {
 	 * \param name Name of symbol
 	 * \return Symbol if found, or 0 if not
 	 */
-	Symbol *Scope::findSymbol(const std::string &name)
+	Symbol *Scope::findSymbol(std::string_view name)
 	{
-		for(std::unique_ptr<Symbol> &symbol : mSymbols) {
-			if(symbol->name == name) {
-				return symbol.get();
-			}
+		// A name which was never interned cannot belong to any symbol
+		Names::Id id = Names::find(name);
+		if(id == Names::Invalid) {
+			return 0;
+		}
+
+		return findSymbol(id);
+	}
+
+	/*!
+	 * \brief Search for a symbol in the scope
+	 * \param name Interned name of symbol
+	 * \return Symbol if found, or 0 if not
+	 */
+	Symbol *Scope::findSymbol(Names::Id name)
+	{
+		auto it = mSymbolNames.find(name);
+		if(it != mSymbolNames.end()) {
+			return it->second;
 		}
 
 		if(mParent) {
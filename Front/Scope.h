@@ -2,9 +2,12 @@
 #define FRONT_SCOPE_H
 
 #include "Front/Symbol.h"
+#include "Front/Names.h"
 
+#include <string_view>
 #include <vector>
 #include <memory>
+#include <unordered_map>
 
 namespace Front {
 	/*!
@@ -13,22 +16,24 @@ namespace Front {
 	class Scope {
 	public:
 		Scope();
-		Scope(std::shared_ptr<TypeStruct> &classType);
+		Scope(TypeStruct *classType);
 
 		Scope *parent() { return mParent; }
 		bool addSymbol(std::unique_ptr<Symbol> symbol);
-		Symbol *findSymbol(const std::string &name);
+		Symbol *findSymbol(std::string_view name);
+		Symbol *findSymbol(Names::Id name);
 		std::vector<const Symbol*> allSymbols();
 		std::vector<std::unique_ptr<Symbol>> &symbols() { return mSymbols; }
 
 		void addChild(std::unique_ptr<Scope> child);
-		std::shared_ptr<TypeStruct> classType() { return mClassType; }
+		TypeStruct *classType() { return mClassType; }
 
 	private:
 		Scope *mParent; //!< Parent scope
 		std::vector<std::unique_ptr<Scope>> mChildren; //!< Child scopes
 		std::vector<std::unique_ptr<Symbol>> mSymbols; //!< Collection of symbols
-		std::shared_ptr<TypeStruct> mClassType;
+		std::unordered_map<Names::Id, Symbol*> mSymbolNames; //!< First symbol added with each name
+		TypeStruct *mClassType;
 	};
 }
 
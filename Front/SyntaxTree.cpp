@@ -0,0 +1,65 @@
+#include "Front/SyntaxTree.h"
+
+#include <algorithm>
+
+namespace Front {
+	/*!
+	 * \brief Constructor
+	 */
+	SyntaxTree::SyntaxTree()
+	{
+		mRoot = 0;
+	}
+
+	/*!
+	 * \brief Construct a new tree node with the given type and line
+	 * \param nodeType Type for new node
+	 * \param line Line number to associate with node
+	 * \param nodeSubtype Subtype for new node
+	 * \return Newly constructed node
+	 */
+	Node *SyntaxTree::newNode(Node::Type nodeType, int line, Node::Subtype nodeSubtype)
+	{
+		Node *node = mArena.create<Node>();
+		node->nodeType = nodeType;
+		node->nodeSubtype = nodeSubtype;
+		node->line = line;
+		node->type = 0;
+		node->lexVal.i = 0;
+		node->symbol = 0;
+
+		return node;
+	}
+
+	/*!
+	 * \brief Append a child to a node
+	 * \param node Node to modify
+	 * \param child Child to append
+	 */
+	void SyntaxTree::addChild(Node &node, Node *child)
+	{
+		NodeList &children = node.children;
+
+		// Move the list into a larger span once it runs out of room.  Most nodes have
+		// only a few children, so start small
+		if(children.mSize == children.mCapacity) {
+			unsigned int capacity = std::max(children.mCapacity * 2, 2u);
+			Node **nodes = mArena.createArray<Node*>(capacity);
+			std::copy(children.begin(), children.end(), nodes);
+			children.mNodes = nodes;
+			children.mCapacity = capacity;
+		}
+
+		children.mNodes[children.mSize++] = child;
+	}
+
+	/*!
+	 * \brief Retrieve the single stored copy of a piece of text
+	 * \param text Text to intern
+	 * \return View of stored text, valid for the lifetime of the program
+	 */
+	std::string_view SyntaxTree::intern(std::string_view text)
+	{
+		return Names::string(Names::intern(text));
+	}
+}
@@ -0,0 +1,37 @@
+#ifndef FRONT_SYNTAX_TREE_H
+#define FRONT_SYNTAX_TREE_H
+
+#include "Front/Node.h"
+#include "Front/Names.h"
+
+#include "Util/Arena.h"
+
+#include <string_view>
+
+namespace Front {
+	/*!
+	 * \brief Abstract syntax tree for a single source file
+	 *
+	 * Owns the storage for every node in the tree and their child lists.  Nodes
+	 * are allocated together from an arena and released together when the tree
+	 * is destroyed.  Text referenced by nodes is interned in the global name table.
+	 */
+	class SyntaxTree {
+	public:
+		SyntaxTree();
+		SyntaxTree(const SyntaxTree &) = delete;
+		SyntaxTree &operator=(const SyntaxTree &) = delete;
+
+		Node &root() { return *mRoot; } //!< Root node
+		void setRoot(Node *root) { mRoot = root; } //!< Set root node
+
+		Node *newNode(Node::Type nodeType, int line, Node::Subtype nodeSubtype = Node::Subtype::None);
+		void addChild(Node &node, Node *child);
+		std::string_view intern(std::string_view text);
+
+	private:
+		Util::Arena mArena; //!< Storage for nodes and child lists
+		Node *mRoot; //!< Root node
+	};
+}
+#endif
@@ -3,60 +3,13 @@
 #include <sstream>
 
 namespace Front {
-	/*!
-	 * \brief Check two types for equality
-	 * \param a First type
-	 * \param b Second type
-	 * \return True if types are equal
-	 */
-	bool Type::equals(Type &a, Type &b)
-	{
-		if(a.kind != b.kind) {
-			return false;
-		}
-
-		switch(a.kind) {
-			case Type::Kind::Intrinsic:
-			case Type::Kind::Struct:
-			case Type::Kind::Class:
-			case Type::Kind::Dummy:
-				return &a == &b;
-
-			case Type::Kind::Procedure:
-			{
-				Front::TypeProcedure &ap = (Front::TypeProcedure&)a;
-				Front::TypeProcedure &bp = (Front::TypeProcedure&)b;
-				if(!equals(*ap.returnType, *bp.returnType)) {
-					return false;
-				}
-
-				if(ap.argumentTypes.size() != bp.argumentTypes.size()) {
-					return false;
-				}
-
-				for(unsigned int i=0; i<ap.argumentTypes.size(); i++) {
-					if(!equals(*ap.argumentTypes[i], *bp.argumentTypes[i])) {
-						return false;
-					}
-				}
-
-				return true;
-			}
-
-			case Type::Kind::Array:
-				return Type::equals(*((Front::TypeArray&)a).baseType, *((Front::TypeArray&)b).baseType);
-		}
-
-		return false;
-	}
-
 	/*!
 	 * \brief Get type name for a procedure type
 	 * \param returnType Return type
 	 * \param argumentTypes Argument types
 	 * \return Type name
 	 */
-	std::string TypeProcedure::getTypeName(std::shared_ptr<Type> &returnType, std::vector<std::shared_ptr<Type>> &argumentTypes)
+	std::string TypeProcedure::getTypeName(Type *returnType, const std::vector<Type*> &argumentTypes)
 	{
 		std::stringstream s;
 		s << returnType->name << "(";
@@ -75,22 +28,43 @@ namespace Front {
 	 * \param type Type of member
 	 * \param name Member name
 	 */
-	void TypeStruct::addMember(std::shared_ptr<Type> type, const std::string &name, unsigned int qualifiers)
+	void TypeStruct::addMember(Type *type, const std::string &name, unsigned int qualifiers)
 	{
 		Member member;
 		member.name = name;
 		member.type = type;
 		member.qualifiers = qualifiers;
 
+		mMemberNames.emplace(Names::intern(name), (unsigned int)members.size());
 		members.push_back(member);
 	}
 
-	TypeStruct::Member *TypeStruct::findMember(const std::string &name)
+	/*!
+	 * \brief Search for a member in the struct or its parents
+	 * \param name Member name
+	 * \return Member if found, or 0 if not
+	 */
+	TypeStruct::Member *TypeStruct::findMember(std::string_view name)
 	{
-		for(Member &member : members) {
-			if(member.name == name) {
-				return &member;
-			}
+		// A name which was never interned cannot belong to any member
+		Names::Id id = Names::find(name);
+		if(id == Names::Invalid) {
+			return 0;
+		}
+
+		return findMember(id);
+	}
+
+	/*!
+	 * \brief Search for a member in the struct or its parents
+	 * \param name Interned member name
+	 * \return Member if found, or 0 if not
+	 */
+	TypeStruct::Member *TypeStruct::findMember(Names::Id name)
+	{
+		auto it = mMemberNames.find(name);
+		if(it != mMemberNames.end()) {
+			return &members[it->second];
 		}
 
 		if(parent) {
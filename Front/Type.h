@@ -1,15 +1,21 @@
 #ifndef	TYPE_H
 #define TYPE_H
 
+#include "Front/Names.h"
+
 #include <string>
+#include <string_view>
 #include <vector>
-#include <memory>
+#include <unordered_map>
 
 namespace Front {
 	class Scope;
 
 	/*!
 	 * \brief Represents a type in the type system
+	 *
+	 * Types are owned by a Types context, which constructs each distinct type only
+	 * once.  Two types are therefore equal exactly when they are the same object.
 	 */
 	class Type {
 	public:
@@ -30,12 +36,12 @@ namespace Front {
 		{
 		}
 
+		virtual ~Type() {}
+
 		Kind kind;
 		std::string name;
 		int valueSize;
 		int allocSize;
-
-		static bool equals(Type &a, Type &b);
 	};
 
 	/*!
@@ -54,15 +60,15 @@ namespace Front {
 	 */
 	class TypeProcedure : public Type {
 	public:
-		std::shared_ptr<Type> returnType;
-		std::vector<std::shared_ptr<Type>> argumentTypes;
+		Type *returnType;
+		std::vector<Type*> argumentTypes;
 
-		TypeProcedure(std::shared_ptr<Type> &_returnType, std::vector<std::shared_ptr<Type>> _argumentTypes)
+		TypeProcedure(Type *_returnType, const std::vector<Type*> &_argumentTypes)
 			: Type(Kind::Procedure, getTypeName(_returnType, _argumentTypes), 0, 0), returnType(_returnType), argumentTypes(_argumentTypes)
 		{}
 
 	private:
-		std::string getTypeName(std::shared_ptr<Type> &returnType, std::vector<std::shared_ptr<Type>> &argumentTypes);
+		static std::string getTypeName(Type *returnType, const std::vector<Type*> &argumentTypes);
 	};
 
 	/*!
@@ -70,9 +76,9 @@ namespace Front {
 	 */
 	class TypeArray : public Type {
 	public:
-		std::shared_ptr<Type> baseType;
+		Type *baseType;
 
-		TypeArray(std::shared_ptr<Type> &_baseType)
+		TypeArray(Type *_baseType)
 			: Type(Kind::Array, _baseType->name + "[]", 4, 0), baseType(_baseType)
 		{}
 	};
@@ -88,25 +94,29 @@ namespace Front {
 				QualifierNative = 0x2,
 				QualifierStatic = 0x4
 			};
-			std::shared_ptr<Type> type;
+			Type *type;
 			std::string name;
 			unsigned int qualifiers;
 			int offset;
 		};
 
 		std::vector<Member> members;
-		std::shared_ptr<Front::TypeProcedure> constructor;
+		TypeProcedure *constructor;
 		Scope *scope;
-		std::shared_ptr<TypeStruct> parent;
+		TypeStruct *parent;
 		int vtableSize;
 		int vtableOffset;
 
 		TypeStruct(Kind _kind, const std::string &_name)
-			: Type(_kind, _name, 4, 0)
+			: Type(_kind, _name, 4, 0), constructor(0), parent(0)
 		{}
 
-		void addMember(std::shared_ptr<Type> type, const std::string &name, unsigned int qualifiers);
-		Member *findMember(const std::string &name);
+		void addMember(Type *type, const std::string &name, unsigned int qualifiers);
+		Member *findMember(std::string_view name);
+		Member *findMember(Names::Id name);
+
+	private:
+		std::unordered_map<Names::Id, unsigned int> mMemberNames; //!< Index in members of the first member with each name
 	};
 
 	/*!
@@ -1,5 +1,7 @@
 #include "Front/Types.h"
 
+#include <functional>
+
 namespace Front {
 	/*!
 	 * \brief Constructor
@@ -8,7 +10,7 @@ namespace Front {
 	{
 		// Add all intrinsic types into the type list
 		for(int i=0; i<NumIntrinsics; i++) {
-			mTypes.push_back(intrinsic((Intrinsic)i));
+			registerType(intrinsic((Intrinsic)i));
 		}
 	}
 
@@ -21,9 +23,9 @@ namespace Front {
 	 * \param type Type to register
 	 * \return True if success
 	 */
-	bool Types::registerType(std::shared_ptr<Type> type)
+	bool Types::registerType(Type *type)
 	{
-		if(findType(type->name)) {
+		if(!mTypeNames.emplace(Names::intern(type->name), mTypes.size()).second) {
 			return false;
 		}
 
@@ -37,15 +39,65 @@ namespace Front {
 	 * \param name Type name
 	 * \return Type if found, or 0
 	 */
-	std::shared_ptr<Type> Types::findType(const std::string &name)
+	Type *Types::findType(std::string_view name)
+	{
+		auto it = mTypeNames.find(Names::find(name));
+		if(it == mTypeNames.end()) {
+			return 0;
+		}
+
+		return mTypes[it->second];
+	}
+
+	/*!
+	 * \brief Retrieve the array type with a given base type, constructing it if necessary
+	 * \param baseType Base type
+	 * \return Array type
+	 */
+	TypeArray *Types::arrayType(Type *baseType)
+	{
+		TypeArray *&type = mArrayTypes[baseType];
+		if(!type) {
+			type = create<TypeArray>(baseType);
+		}
+
+		return type;
+	}
+
+	/*!
+	 * \brief Retrieve the procedure type with a given signature, constructing it if necessary
+	 * \param returnType Return type
+	 * \param argumentTypes Argument types
+	 * \return Procedure type
+	 */
+	TypeProcedure *Types::procedureType(Type *returnType, const std::vector<Type*> &argumentTypes)
+	{
+		std::vector<Type*> components;
+		components.reserve(argumentTypes.size() + 1);
+		components.push_back(returnType);
+		components.insert(components.end(), argumentTypes.begin(), argumentTypes.end());
+
+		TypeProcedure *&type = mProcedureTypes[std::move(components)];
+		if(!type) {
+			type = create<TypeProcedure>(returnType, argumentTypes);
+		}
+
+		return type;
+	}
+
+	/*!
+	 * \brief Combine the hashes of a list of component types
+	 * \param components Component types
+	 * \return Hash value
+	 */
+	size_t Types::ComponentsHash::operator()(const std::vector<Type*> &components) const
 	{
-		for(std::shared_ptr<Type> &type : mTypes) {
-			if(type->name == name) {
-				return type;
-			}
+		size_t hash = components.size();
+		for(Type *component : components) {
+			hash ^= std::hash<Type*>()(component) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
 		}
 
-		return 0;
+		return hash;
 	}
 
 	/*!
@@ -53,20 +105,16 @@ namespace Front {
 	 * \param intrinsic Intrinsic type number
 	 * \return Intrinsic type
 	 */
-	std::shared_ptr<Type> &Types::intrinsic(Intrinsic intrinsic)
+	Type *Types::intrinsic(Intrinsic intrinsic)
 	{
-		static std::vector<std::shared_ptr<Type>> intrinsics;
-
-		if(intrinsics.size() == 0) {
-			// Register all the intrinsics on first access
-			intrinsics.resize(NumIntrinsics);
-			intrinsics[Bool] = std::make_shared<TypeIntrinsic>("bool", 4);
-			intrinsics[Int] = std::make_shared<TypeIntrinsic>("int", 4);
-			intrinsics[Void] = std::make_shared<TypeIntrinsic>("void", 0);
-			intrinsics[Char] = std::make_shared<TypeIntrinsic>("char", 1);
-			intrinsics[String] = std::make_shared<TypeIntrinsic>("string", 4);
-		}
+		static TypeIntrinsic intrinsics[NumIntrinsics] = {
+			TypeIntrinsic("bool", 4),
+			TypeIntrinsic("int", 4),
+			TypeIntrinsic("void", 0),
+			TypeIntrinsic("string", 4),
+			TypeIntrinsic("char", 1)
+		};
 
-		return intrinsics[intrinsic];
+		return &intrinsics[intrinsic];
 	}
-}
\ No newline at end of file
+}
@@ -2,23 +2,48 @@
 #define FRONT_TYPES_H
 
 #include "Front/Type.h"
+#include "Front/Names.h"
 
+#include <string_view>
 #include <vector>
 #include <memory>
+#include <unordered_map>
+#include <utility>
 
 namespace Front {
 	/*!
 	 * \brief Represents a collection of types
+	 *
+	 * The collection owns every type used by a program.  Array and procedure types
+	 * are hash-consed, so that each distinct structure is constructed once and can
+	 * be compared by identity.
 	 */
 	class Types {
 	public:
 		Types();
 		~Types();
 
-		bool registerType(std::shared_ptr<Type> type);
-		std::shared_ptr<Type> findType(const std::string &name);
+		bool registerType(Type *type);
+		Type *findType(std::string_view name);
 
-		std::vector<std::shared_ptr<Type>> &types() { return mTypes; }
+		std::vector<Type*> &types() { return mTypes; }
+
+		/*!
+		 * \brief Construct a new type owned by the collection, without registering its name
+		 * \param args Constructor arguments
+		 * \return New type
+		 */
+		template<typename T, typename... Args>
+		T *create(Args&&... args)
+		{
+			std::unique_ptr<T> type = std::make_unique<T>(std::forward<Args>(args)...);
+			T *result = type.get();
+			mOwnedTypes.push_back(std::move(type));
+			return result;
+		}
+
+		TypeArray *arrayType(Type *baseType);
+		TypeProcedure *procedureType(Type *returnType, const std::vector<Type*> &argumentTypes);
 
 		enum Intrinsic {
 			Bool,
@@ -28,10 +53,21 @@ namespace Front {
 			Char,
 			NumIntrinsics
 		};
-		static std::shared_ptr<Type> &intrinsic(Intrinsic intrinsic);
+		static Type *intrinsic(Intrinsic intrinsic);
 
 	private:
-		std::vector<std::shared_ptr<Type>> mTypes;
+		/*!
+		 * \brief Hash function for a list of component types
+		 */
+		struct ComponentsHash {
+			size_t operator()(const std::vector<Type*> &components) const;
+		};
+
+		std::vector<Type*> mTypes; //!< Registered types, in order of registration
+		std::unordered_map<Names::Id, size_t> mTypeNames; //!< Index in mTypes of each type, keyed by name
+		std::vector<std::unique_ptr<Type>> mOwnedTypes; //!< Storage for all non-intrinsic types
+		std::unordered_map<Type*, TypeArray*> mArrayTypes; //!< Array types, keyed by base type
+		std::unordered_map<std::vector<Type*>, TypeProcedure*, ComponentsHash> mProcedureTypes; //!< Procedure types, keyed by return type followed by argument types
 	};
 }
-#endif
\ No newline at end of file
+#endif
@@ -3,6 +3,8 @@
 
 #include "IR/EntryList.h"
 
+#include "Util/Arena.h"
+
 #include <string>
 #include <list>
 
@@ -21,7 +23,19 @@ namespace IR {
 
 		void emit(Entry *entry);
 
+		/*!
+		 * \brief Allocate a new entry, owned by the data section
+		 * \param args Arguments to entry constructor
+		 * \return New entry
+		 */
+		template<typename T, typename... Args>
+		T *newEntry(Args&&... args)
+		{
+			return mArena.create<T>(std::forward<Args>(args)...);
+		}
+
 	private:
+		Util::Arena mArena; //!< Storage for entries
 		std::string mName; //!< Data section name
 		EntryList mEntries; //!< Entry list
 	};
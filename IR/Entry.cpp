@@ -53,8 +53,8 @@ namespace IR {
 		}
 	}
 
-	EntryThreeAddr::EntryThreeAddr(Type _type, const Symbol *_lhs, const Symbol *_rhs1, const Symbol *_rhs2, int _imm)
-		: Entry(_type), lhs(_lhs), rhs1(_rhs1),	rhs2(_rhs2), imm(_imm)
+	EntryThreeAddr::EntryThreeAddr(Type _type, const Symbol *_lhs, const Symbol *_rhs1, const Symbol *_rhs2, int _imm, const MemoryRegion &_region)
+		: Entry(_type), lhs(_lhs), rhs1(_rhs1),	rhs2(_rhs2), imm(_imm), region(_region)
 	{
 	}
 
@@ -104,6 +104,18 @@ namespace IR {
 		return (rhs1 == symbol || rhs2 == symbol || (!lhsAssign(type) && lhs == symbol));
 	}
 
+	Entry::OperandList EntryThreeAddr::useOperands() const
+	{
+		OperandList list;
+		list.add(rhs1);
+		list.add(rhs2);
+		if(!lhsAssign(type)) {
+			list.add(lhs);
+		}
+
+		return list;
+	}
+
 	void EntryThreeAddr::replaceUse(const Symbol *symbol, const Symbol *newSymbol)
 	{
 		if(rhs1 == symbol) {
@@ -158,21 +170,23 @@ namespace IR {
 		return (pred == symbol);
 	}
 
-	void EntryCJump::replaceUse(const Symbol *symbol, const Symbol *newSymbol)
+	Entry::OperandList EntryCJump::useOperands() const
 	{
-		pred = newSymbol;
+		OperandList list;
+		list.add(pred);
+
+		return list;
 	}
 
-	EntryPhi::EntryPhi(const Symbol *_base, const Symbol *_lhs, int _numArgs)
-		: Entry(Type::Phi), base(_base), lhs(_lhs), numArgs(_numArgs)
+	void EntryCJump::replaceUse(const Symbol *symbol, const Symbol *newSymbol)
 	{
-		args = new const Symbol*[numArgs];
-		memset(args, 0, numArgs * sizeof(const Symbol*));
+		pred = newSymbol;
 	}
 
-	EntryPhi::~EntryPhi()
+	EntryPhi::EntryPhi(const Symbol *_base, const Symbol *_lhs, int _numArgs, Util::Arena &arena)
+		: Entry(Type::Phi), base(_base), lhs(_lhs), numArgs(_numArgs)
 	{
-		delete[] args;
+		args = arena.createArray<const Symbol*>(numArgs);
 	}
 
 	void EntryPhi::setArg(int num, const Symbol *symbol)
@@ -213,6 +227,11 @@ namespace IR {
 		return false;
 	}
 
+	Entry::OperandList EntryPhi::useOperands() const
+	{
+		return OperandList(args, numArgs);
+	}
+
 	void EntryPhi::replaceUse(const Symbol *symbol, const Symbol *newSymbol)
 	{
 		for(int i=0; i<numArgs; i++) {
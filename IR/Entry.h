@@ -3,6 +3,8 @@
 
 #include "IR/Symbol.h"
 
+#include "Util/Arena.h"
+
 #include <string>
 #include <iostream>
 #include <set>
@@ -61,7 +63,50 @@ namespace IR {
 			FunctionAddr, //!< Function address
 		};
 
+		/*!
+		 * \brief A short list of symbol operands, iterable as a range
+		 *
+		 * Most entries have at most a few operands, which are stored inline.  Entries with
+		 * an unbounded number of operands (phi functions) refer to their own storage instead.
+		 */
+		class OperandList {
+		public:
+			static const int MaxInline = 3; //!< Maximum number of inline operands
+
+			OperandList() : mExternal(0), mSize(0) {}
+			OperandList(const Symbol *const *external, int size) : mExternal(external), mSize(size) {}
+
+			/*!
+			 * \brief Append an operand, skipping null symbols and duplicates
+			 * \param symbol Symbol to add
+			 */
+			void add(const Symbol *symbol)
+			{
+				if(!symbol) {
+					return;
+				}
+
+				for(int i=0; i<mSize; i++) {
+					if(mInline[i] == symbol) {
+						return;
+					}
+				}
+				mInline[mSize++] = symbol;
+			}
+
+			const Symbol *const *begin() const { return mExternal ? mExternal : mInline; }
+			const Symbol *const *end() const { return begin() + mSize; }
+			int size() const { return mSize; }
+			bool empty() const { return mSize == 0; }
+
+		private:
+			const Symbol *mInline[MaxInline]; //!< Inline operand storage
+			const Symbol *const *mExternal; //!< External operand storage, or 0 if inline storage is used
+			int mSize; //!< Number of operands
+		};
+
 		Type type; //!< Entry type
+		int id; //!< Dense index assigned by the owning procedure, for use in side tables
 
 		Entry *prev; //!< Linked list prev pointer
 		Entry *next; //!< Linked list next pointer
@@ -70,7 +115,7 @@ namespace IR {
 		 * \brief Base class constructor
 		 * \param _type Entry type
 		 */
-		Entry(Type _type) : type(_type), prev(0), next(0) {}
+		Entry(Type _type) : type(_type), id(-1), prev(0), next(0) {}
 
 		/*!
 		 * \brief Virtual destructor
@@ -96,6 +141,18 @@ namespace IR {
 		 */
 		virtual bool uses(const Symbol *symbol) const { return false; }
 
+		/*!
+		 * \brief List of symbols that the entry uses.  Each symbol appears at most once, except in phi functions
+		 * \return Used symbols
+		 */
+		virtual OperandList useOperands() const { return OperandList(); }
+
+		/*!
+		 * \brief List of symbols that the entry assigns to
+		 * \return Assigned symbols
+		 */
+		OperandList defOperands() const { OperandList list; list.add(assign()); return list; }
+
 		/*!
 		 * \brief Replace the assignment of a symbol with another symbol
 		 * \param symbol Original symbol
@@ -111,6 +168,33 @@ namespace IR {
 		virtual void replaceUse(const Symbol *symbol, const Symbol *newSymbol) {}
 	};
 
+	/*!
+	 * \brief Region of memory accessed by a load or store
+	 *
+	 * Recorded by the IR generator from front-end type information, so that alias analysis
+	 * can separate accesses which can never overlap.
+	 */
+	struct MemoryRegion {
+		/*!
+		 * \brief Kind of memory accessed
+		 */
+		enum class Kind {
+			Unknown, //!< Any memory
+			Field, //!< Field of a class object
+			Element //!< Array element
+		};
+
+		Kind kind; //!< Kind of memory accessed
+		int size; //!< Size of the field or array element
+
+		/*!
+		 * \brief Constructor
+		 * \param _kind Kind of memory accessed
+		 * \param _size Size of the field or array element
+		 */
+		MemoryRegion(Kind _kind = Kind::Unknown, int _size = 0) : kind(_kind), size(_size) {}
+	};
+
 	/*!
 	 * \brief Three-address entry: one assignment symbol and two arguments
 	 */
@@ -119,6 +203,7 @@ namespace IR {
 		const Symbol *rhs1; //!< Right-hand side 1
 		const Symbol *rhs2; //!< Right-hand side 2
 		int    imm; //!< Immediate value
+		MemoryRegion region; //!< Memory accessed, for LoadMem and StoreMem
 
 		/*!
 		 * \brief Constructor
@@ -126,14 +211,17 @@ namespace IR {
 		 * \param _lhs Left-hand side, or 0
 		 * \param _rhs1 Right-hand side 1, or 0
 		 * \param _rhs2 Right-hand side 2, or 0
+		 * \param _imm Immediate value
+		 * \param _region Memory accessed, for LoadMem and StoreMem
 		 */
-		EntryThreeAddr(Type _type, const Symbol *_lhs = 0, const Symbol *_rhs1 = 0, const Symbol *_rhs2 = 0, int _imm = 0);
+		EntryThreeAddr(Type _type, const Symbol *_lhs = 0, const Symbol *_rhs1 = 0, const Symbol *_rhs2 = 0, int _imm = 0, const MemoryRegion &_region = MemoryRegion());
 		virtual ~EntryThreeAddr();
 
 		virtual void print(std::ostream &o) const;
 
 		virtual const Symbol *assign() const;
 		virtual bool uses(const Symbol *symbol) const;
+		virtual OperandList useOperands() const;
 		virtual void replaceAssign(const Symbol *symbol, const Symbol *newSymbol);
 		virtual void replaceUse(const Symbol *symbol, const Symbol *newSymbol);
 	};
@@ -188,6 +276,7 @@ namespace IR {
 		virtual void print(std::ostream &o) const;
 
 		virtual bool uses(const Symbol *symbol) const;
+		virtual OperandList useOperands() const;
 		virtual void replaceUse(const Symbol *symbol, const Symbol *newSymbol);
 	};
 
@@ -198,16 +287,16 @@ namespace IR {
 		const Symbol *base; //!< Symbol that phi function derives from
 		const Symbol *lhs; //!< Left-hand side
 		int numArgs; //!< Number of arguments
-		const Symbol **args; //!< Arguments to function
+		const Symbol **args; //!< Arguments to function, allocated from the procedure arena
 
 		/*!
 		 * \brief Constructor
 		 * \param _base Symbol that phi function derives from
 		 * \param _lhs Left-hand side
 		 * \param _numArgs Number of arguments
+		 * \param arena Arena to allocate argument array from
 		 */
-		EntryPhi(const Symbol *_base, const Symbol *_lhs, int _numArgs);
-		virtual ~EntryPhi();
+		EntryPhi(const Symbol *_base, const Symbol *_lhs, int _numArgs, Util::Arena &arena);
 
 		/*!
 		 * \brief Set a given argument
@@ -226,6 +315,7 @@ namespace IR {
 
 		virtual const Symbol *assign() const;
 		virtual bool uses(const Symbol *symbol) const;
+		virtual OperandList useOperands() const;
 		virtual void replaceAssign(const Symbol *symbol, const Symbol *newSymbol);
 		virtual void replaceUse(const Symbol *symbol, const Symbol *newSymbol);
 	};
@@ -16,9 +16,11 @@ namespace IR {
 	{
 		mNextTemp = 0;
 		mNextLabel = 1;
+		mNextEntryId = 0;
+		mNextSymbolId = 0;
 		mName = name;
-		mStart = new EntryLabel("start");
-		mEnd = new EntryLabel("end");
+		mStart = newEntry<EntryLabel>("start");
+		mEnd = newEntry<EntryLabel>("end");
 		mEntries.push_back(mStart);
 		mEntries.push_back(mEnd);
 	}
@@ -35,6 +37,21 @@ namespace IR {
 		o << prefix << std::endl;
 	}
 
+	/*!
+	 * \brief Allocate a new symbol.  The symbol is owned by the procedure, but is not added to its symbol table
+	 * \param name Symbol name
+	 * \param size Symbol data size
+	 * \param symbol Front-end symbol, or 0
+	 * \return New symbol
+	 */
+	Symbol *Procedure::newSymbol(const std::string &name, int size, const Front::Symbol *symbol)
+	{
+		Symbol *ret = mArena.create<Symbol>(name, size, symbol);
+		ret->id = mNextSymbolId++;
+
+		return ret;
+	}
+
 	/*!
 	 * \brief Allocate a new temporary symbol
 	 * \param type Type to assign to symbol
@@ -46,20 +63,19 @@ namespace IR {
 		ss << mNextTemp++;
 		std::string name = "temp" + ss.str();
 
-		std::unique_ptr<Symbol> symbol = std::make_unique<Symbol>(name, size, nullptr);
-		Symbol *ret = symbol.get();
-		addSymbol(std::move(symbol));
+		Symbol *symbol = newSymbol(name, size, nullptr);
+		addSymbol(symbol);
 
-		return ret;
+		return symbol;
 	}
 
 	/*!
 	 * \brief Add an existing symbol to the procedure symbol table
 	 * \param symbol Symbol to add
 	 */
-	void Procedure::addSymbol(std::unique_ptr<Symbol> symbol)
+	void Procedure::addSymbol(Symbol *symbol)
 	{
-		mSymbols.push_back(std::move(symbol));
+		mSymbols.push_back(symbol);
 	}
 
 	/*!
@@ -69,9 +85,9 @@ namespace IR {
 	 */
 	Symbol *Procedure::findSymbol(Front::Symbol *symbol)
 	{
-		for(std::unique_ptr<Symbol> &irSymbol : mSymbols) {
+		for(Symbol *irSymbol : mSymbols) {
 			if(irSymbol->symbol == symbol) {
-				return irSymbol.get();
+				return irSymbol;
 			}
 		}
 
@@ -87,7 +103,7 @@ namespace IR {
 		std::stringstream ss;
 		ss << mNextLabel++;
 		std::string name = "bb" + ss.str();
-		return new EntryLabel(name);
+		return newEntry<EntryLabel>(name);
 	}
 
 	/*!
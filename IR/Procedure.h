@@ -5,6 +5,8 @@
 #include "IR/Symbol.h"
 #include "IR/Entry.h"
 
+#include "Util/Arena.h"
+
 #include <string>
 #include <list>
 #include <vector>
@@ -14,6 +16,11 @@
 namespace IR {
 	/*!
 	 * \brief A procedure of IR entries
+	 *
+	 * All entries and symbols of a procedure are allocated out of a single arena owned by
+	 * the procedure, and are freed together when the procedure is destroyed.  Each one is
+	 * assigned a dense id as it is created, so that analyses can keep per-entry or per-symbol
+	 * information in vectors rather than in maps keyed by pointer.
 	 */
 	class Procedure {
 	public:
@@ -26,24 +33,45 @@ namespace IR {
 		const std::string &name() const { return mName; } //!< Procedure name
 		EntryList &entries() { return mEntries; } //!< Body of procedure
 		const EntryList &entries() const { return mEntries; }
-		std::vector<std::unique_ptr<Symbol>> &symbols() { return mSymbols; } //!< Symbols in procedure
-		const std::vector<std::unique_ptr<Symbol>> &symbols() const { return mSymbols; }
+		std::vector<Symbol*> &symbols() { return mSymbols; } //!< Symbols in procedure
+		const std::vector<Symbol*> &symbols() const { return mSymbols; }
+		Symbol *newSymbol(const std::string &name, int size, const Front::Symbol *symbol);
 		Symbol *newTemp(int size);
-		void addSymbol(std::unique_ptr<Symbol> symbol);
+		void addSymbol(Symbol *symbol);
 		Symbol *findSymbol(Front::Symbol *symbol);
 		EntryLabel *newLabel();
 		void setPosition(Entry *entry);
 
 		void emit(Entry *entry);
 
+		/*!
+		 * \brief Allocate a new entry.  The entry is owned by the procedure, but is not yet part of its entry list
+		 * \param args Arguments to entry constructor
+		 * \return New entry
+		 */
+		template<typename T, typename... Args>
+		T *newEntry(Args&&... args)
+		{
+			T *entry = mArena.create<T>(std::forward<Args>(args)...);
+			entry->id = mNextEntryId++;
+			return entry;
+		}
+
+		int numEntryIds() const { return mNextEntryId; } //!< Upper bound on entry ids allocated so far
+		int numSymbolIds() const { return mNextSymbolId; } //!< Upper bound on symbol ids allocated so far
+		Util::Arena &arena() { return mArena; } //!< Arena that owns the procedure's entries and symbols
+
 	private:
+		Util::Arena mArena; //!< Storage for entries and symbols
 		std::string mName; //!< Procedure name
-		std::vector<std::unique_ptr<Symbol>> mSymbols; //!< Symbol list
+		std::vector<Symbol*> mSymbols; //!< Symbol list
 		EntryLabel *mStart; //!< Start label
 		EntryLabel *mEnd; //!< End label
 
 		int mNextTemp; //!< Next temporary number
 		int mNextLabel; //!< Next label number
+		int mNextEntryId; //!< Next entry id
+		int mNextSymbolId; //!< Next symbol id
 		EntryList mEntries; //!< Entry list
 		bool mReturnsValue; //!< Whether the procedure returns a value
 	};
@@ -18,13 +18,14 @@ namespace IR {
 		std::string name; //!< Symbol name
 		int size; //!< Symbol data size
 		const Front::Symbol *symbol; //!< Front-end symbol that this one corresponds to
+		int id; //!< Dense index assigned by the owning procedure, for use in side tables
 
 		/*!
 		 * \brief Constructor
 		 * \param _name Symbol name
 		 * \param _symbol Front-end symbol
 		 */
-		Symbol(const std::string &_name, int _size, const Front::Symbol *_symbol) : name(_name), size(_size), symbol(_symbol) {}
+		Symbol(const std::string &_name, int _size, const Front::Symbol *_symbol) : name(_name), size(_size), symbol(_symbol), id(-1) {}
 	};
 }
 #endif
\ No newline at end of file
@@ -0,0 +1,41 @@
+#ifndef INPUT_CHARACTER_SET_H
+#define INPUT_CHARACTER_SET_H
+
+#include <array>
+#include <initializer_list>
+#include <string_view>
+
+namespace Input {
+/*!
+ * \brief Set of characters, stored as a lookup table indexed by character
+ *
+ * Sets are built at compile time, so that classifying a character during
+ * tokenization is a single table load rather than a search.
+ */
+class CharacterSet {
+public:
+	/*!
+	 * \brief Constructor
+	 * \param groups Strings whose characters make up the set
+	 */
+	constexpr CharacterSet(std::initializer_list<std::string_view> groups)
+		: mMembers{}
+	{
+		for(std::string_view group : groups) {
+			for(char c : group) {
+				mMembers[(unsigned char)c] = true;
+			}
+		}
+	}
+
+	constexpr bool contains(char c) const { return mMembers[(unsigned char)c]; } //!< True if character is in the set
+
+	static constexpr std::string_view Letters = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ"; //!< Alphabetic characters
+	static constexpr std::string_view Digits = "0123456789"; //!< Decimal digits
+
+private:
+	std::array<bool, 256> mMembers; //!< Membership, indexed by character
+};
+}
+
+#endif
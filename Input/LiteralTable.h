@@ -0,0 +1,110 @@
+#ifndef INPUT_LITERAL_TABLE_H
+#define INPUT_LITERAL_TABLE_H
+
+#include <array>
+#include <initializer_list>
+#include <stdexcept>
+#include <string_view>
+
+namespace Input {
+/*!
+ * \brief Deterministic automaton recognizing a fixed set of literal strings
+ *
+ * The automaton is a trie over the characters used by the literals, laid out
+ * as a transition table.  Input characters are first mapped to a dense
+ * character class, so that each step of a match is two table loads.  Tables
+ * are built at compile time from the literal list.
+ */
+class LiteralTable {
+public:
+	/*!
+	 * \brief Constructor
+	 * \param literals Strings recognized by the table
+	 */
+	constexpr LiteralTable(std::initializer_list<std::string_view> literals)
+		: mClasses{}, mTransitions{}, mAccept{}
+	{
+		int numClasses = 1;
+		int numStates = Start + 1;
+
+		for(std::string_view literal : literals) {
+			int state = Start;
+			for(char c : literal) {
+				// Assign a class to each character the first time it is seen
+				unsigned char &cls = mClasses[(unsigned char)c];
+				if(cls == 0) {
+					if(numClasses == MaxClasses) {
+						throw std::length_error("Too many distinct characters in literal table");
+					}
+					cls = (unsigned char)numClasses++;
+				}
+
+				// Follow the existing transition, or create a new state
+				unsigned char &nextState = mTransitions[state][cls];
+				if(nextState == Dead) {
+					if(numStates == MaxStates) {
+						throw std::length_error("Too many states in literal table");
+					}
+					nextState = (unsigned char)numStates++;
+				}
+				state = nextState;
+			}
+
+			mAccept[state] = true;
+		}
+	}
+
+	/*!
+	 * \brief Find the longest literal which is a prefix of the given text
+	 * \param text Text to match
+	 * \return Length of the literal, or 0 if none matched
+	 */
+	constexpr size_t match(std::string_view text) const
+	{
+		int state = Start;
+		size_t length = 0;
+		for(size_t i=0; i<text.size(); i++) {
+			state = mTransitions[state][mClasses[(unsigned char)text[i]]];
+			if(state == Dead) {
+				break;
+			}
+
+			if(mAccept[state]) {
+				length = i + 1;
+			}
+		}
+
+		return length;
+	}
+
+	/*!
+	 * \brief Check whether the given text is exactly one of the literals
+	 * \param text Text to check
+	 * \return True if text is in the table
+	 */
+	constexpr bool contains(std::string_view text) const
+	{
+		int state = Start;
+		for(char c : text) {
+			state = mTransitions[state][mClasses[(unsigned char)c]];
+			if(state == Dead) {
+				return false;
+			}
+		}
+
+		return mAccept[state];
+	}
+
+private:
+	static const int MaxStates = 256; //!< Maximum number of automaton states
+	static const int MaxClasses = 64; //!< Maximum number of character classes, including the class of unused characters
+	static const int Dead = 0; //!< State reached once no literal can match
+	static const int Start = 1; //!< Initial state
+
+	std::array<unsigned char, 256> mClasses; //!< Character class of each character, 0 if unused by any literal
+	std::array<std::array<unsigned char, MaxClasses>, MaxStates> mTransitions; //!< Next state, indexed by state and character class
+	std::array<bool, MaxStates> mAccept; //!< True if a literal ends in the state
+};
+}
+
+#endif
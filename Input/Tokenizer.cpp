@@ -1,14 +1,31 @@
 #include "Input/Tokenizer.h"
 
+#include <algorithm>
+#include <iterator>
+
 namespace Input {
 /*!
  * \brief Constructor
- * \param filename Filename to read
+ * \param stream Stream to read
  * \param lookahead Number of lookahead tokens
  */
 Tokenizer::Tokenizer(std::istream &stream, int lookahead)
-	: mStream(stream)
 {
+	// Read the entire stream up front, so that tokens can reference it directly
+	stream.seekg(0, std::ios_base::end);
+	std::streamoff size = stream.tellg();
+	if(size >= 0) {
+		stream.seekg(0, std::ios_base::beg);
+		mSource.resize((size_t)size);
+		stream.read(mSource.data(), size);
+		mSource.resize((size_t)stream.gcount());
+	} else {
+		// Stream is not seekable, fall back to reading it sequentially
+		stream.clear();
+		mSource.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+	}
+
+	mPosition = 0;
 	mLine = 1;
 	mColumn = 1;
 	mError = false;
@@ -54,18 +71,8 @@ void Tokenizer::consume()
  */
 bool Tokenizer::fillBuffer(size_t length)
 {
-	// Read one character at a time until we either fill the buffer or hit EOF
-	while(mBuffer.size() < length) {
-		char c;
-		mStream.read(&c, 1);
-		if(mStream.eof()) {
-			break;
-		} else {
-			mBuffer.push_back(c);
-		}
-	}
-
-	return mBuffer.size() >= length;
+	// The whole source is already resident, so just check how much of it remains
+	return mSource.size() - mPosition >= length;
 }
 
 /*!
@@ -74,51 +81,41 @@ bool Tokenizer::fillBuffer(size_t length)
  */
 void Tokenizer::emptyBuffer(size_t length)
 {
-	// Remove characters one at a time
-	for(size_t i=0; i<length; i++) {
-		if(i >= mBuffer.size()) {
-			break;
-		}
+	size_t end = std::min(mPosition + length, mSource.size());
 
-		// Update line and column information
+	// Step over the characters, updating line and column information
+	for(; mPosition < end; mPosition++) {
 		mColumn++;
-		if(mBuffer[i] == '\n') {
+		if(mSource[mPosition] == '\n') {
 			mLine++;
 			mColumn = 1;
 		}
 	}
-
-	mBuffer.erase(0, length);
 }
 
 /*!
- * \brief Skip all characters in a given list from the front of the input buffer
+ * \brief Skip all characters in a given set from the front of the input buffer
  * \param characters Characters to skip
- * \param numCharacters Number of characters in list
  */
-void Tokenizer::skipCharacters(const std::vector<char> &characters)
+void Tokenizer::skipCharacters(const CharacterSet &characters)
 {
-	while(true) {
-		// Ensure the buffer has at least one character
-		if(!fillBuffer(1)) {
-			break;
-		}
-
-		// If the front character matches any of the characters in the list, remove it
-		bool found = false;
-		for(char c : characters) {
-			if(mBuffer[0] == c) {
-				emptyBuffer(1);
-				found = true;
-				break;
-			}
-		}
+	emptyBuffer(spanCharacters(characters, 0));
+}
 
-		// Break if the buffer now contains a character not in the list at the front
-		if(!found) {
-			break;
-		}
+/*!
+ * \brief Measure a run of characters from a given set in the input buffer
+ * \param characters Characters to accept
+ * \param start Offset in buffer at which to start the run
+ * \return Offset in buffer of the first character after the run
+ */
+size_t Tokenizer::spanCharacters(const CharacterSet &characters, size_t start)
+{
+	size_t end = mPosition + start;
+	while(end < mSource.size() && characters.contains(mSource[end])) {
+		end++;
 	}
+
+	return end - mPosition;
 }
 
 /*!
@@ -137,46 +134,47 @@ void Tokenizer::setError(const std::string &message)
  * \param text Token text
  * \return New token
  */
-Tokenizer::Token Tokenizer::createToken(int type, const std::string &text)
+Tokenizer::Token Tokenizer::createToken(int type, std::string_view text)
 {
 	Token token;
 
 	token.type = (Token::Type)type;
 	token.text = text;
+	token.offset = mPosition;
 	token.line = mLine;
 	token.column = mColumn;
 
 	return token;
 }
 
+/*!
+ * \brief Retain token text which cannot be referenced directly from the source
+ * \param text Text to store
+ * \return View of the stored text, valid for the lifetime of the tokenizer
+ */
+std::string_view Tokenizer::storeText(std::string &&text)
+{
+	mStoredText.push_back(std::move(text));
+	return mStoredText.back();
+}
+
 /*!
  * \brief Utility function to scan a set of literals, and return a token if found
- * \param literals Set of strings to scan for
- * \param numLiterals Number of literals
+ * \param literals Set of literals to scan for.  The longest matching literal is taken
  * \param token Token to construct
- * \param literalType Type to assign to token if literal is found
  * \return True if literal was found
  */
-bool Tokenizer::scanLiteral(const std::vector<std::string> &literals, Token &token)
+bool Tokenizer::scanLiteral(const LiteralTable &literals, Token &token)
 {
-	// Scan through the list of literals and see if any match
-	for(const std::string &lit : literals) {
-		size_t len = lit.size();
-
-		// Ensure that there are a sufficient number of characters in the buffer
-		if(!fillBuffer(len)) {
-			continue;
-		}
-
-		// If the buffer matches, construct a token out of it and remove it from the buffer
-		if(buffer().substr(0, len) == lit) {
-			token = createToken(Token::TypeLiteral, buffer().substr(0, len));
-			emptyBuffer(len);
-			return true;
-		}
+	size_t len = literals.match(buffer());
+	if(len == 0) {
+		return false;
 	}
 
-	return false;
+	// Construct a token out of the literal and remove it from the buffer
+	token = createToken(Token::TypeLiteral, buffer().substr(0, len));
+	emptyBuffer(len);
+	return true;
 }
 
 }
\ No newline at end of file
@@ -1,9 +1,14 @@
 #ifndef INPUT_TOKENIZER_H
 #define INPUT_TOKENIZER_H
 
+#include "Input/CharacterSet.h"
+#include "Input/LiteralTable.h"
+
 #include <string>
+#include <string_view>
 #include <istream>
 #include <vector>
+#include <deque>
 
 namespace Input {
 class Tokenizer {
@@ -20,7 +25,8 @@ public:
 		};
 
 		Type type; //!< Token type
-		std::string text; //!< Textual content of token
+		std::string_view text; //!< Textual content of token, referencing the tokenizer's source
+		size_t offset; //!< Offset of token in source
 		int line; //!< Starting line of token
 		int column; //!< Starting column of token
 	};
@@ -37,21 +43,24 @@ public:
 	virtual std::string typeName(int type) = 0;
 
 protected:
-	const std::string &buffer() { return mBuffer; }
+	std::string_view buffer() { return std::string_view(mSource).substr(mPosition); }
 	bool fillBuffer(size_t length);
 	void emptyBuffer(size_t length);
-	void skipCharacters(const std::vector<char> &characters);
+	void skipCharacters(const CharacterSet &characters);
+	size_t spanCharacters(const CharacterSet &characters, size_t start);
 	void setError(const std::string &message);
 
-	Token createToken(int type, const std::string& text);
+	Token createToken(int type, std::string_view text);
+	std::string_view storeText(std::string &&text);
 
-	bool scanLiteral(const std::vector<std::string> &literals, Token &token);
+	bool scanLiteral(const LiteralTable &literals, Token &token);
 
 	virtual Token getNext() = 0;
 
 private:
-	std::istream &mStream; //!< Underlying file stream
-	std::string mBuffer; //!< Buffer containing upcoming characters
+	std::string mSource; //!< Entire contents of the input stream
+	size_t mPosition; //!< Current position in source
+	std::deque<std::string> mStoredText; //!< Token text which does not appear verbatim in the source
 	int mLine; //!< Current line
 	int mColumn; //!< Current column
 	bool mPopulated; //!< True if lookahead has been populated
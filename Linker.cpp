@@ -28,14 +28,12 @@ std::unique_ptr<VM::Program> Linker::link(const std::vector<std::reference_wrapp
 	for(unsigned int i=0; i<programs.size(); i++) {
 		const VM::Program &program = programs[i];
 
-		if(program.instructions.size() > 0) {
-			linked->instructions.resize(linked->instructions.size() + program.instructions.size());
-			std::memcpy(&linked->instructions[offset], &program.instructions[0], program.instructions.size());
-		}
+		std::span<const unsigned char> code = program.code();
+		linked->instructions.insert(linked->instructions.end(), code.begin(), code.end());
 
-		for(auto it = program.symbols.begin(); it != program.symbols.end(); it++) {
-			linked->symbols[it->first] = it->second + offset;
-		}
+		program.forEachSymbol([&](std::string_view name, int symbolOffset) {
+			linked->symbols[std::string(name)] = symbolOffset + offset;
+		});
 
 		for(unsigned int j=0; j<program.relocations.size(); j++) {
 			VM::Program::Relocation relocation = program.relocations[j];
@@ -43,7 +41,7 @@ std::unique_ptr<VM::Program> Linker::link(const std::vector<std::reference_wrapp
 			relocations.push_back(relocation);
 		}
 
-		offset += (int)program.instructions.size();
+		offset += (int)code.size();
 
 		unsigned int exportInfoOffset = (unsigned int)exportInfoData.size();
 		unsigned int exportInfoStringOffset = (unsigned int)exportInfoStringData.size();
@@ -59,39 +57,40 @@ std::unique_ptr<VM::Program> Linker::link(const std::vector<std::reference_wrapp
 		}
 	}
 
-	// Resolve symbol references in program
+	// Resolve symbol references in program, looking each one up once
 	for(unsigned int i=0; i<relocations.size(); i++) {
-		if(linked->symbols.find(relocations[i].symbol) == linked->symbols.end()) {
+		auto symbol = linked->symbols.find(relocations[i].symbol);
+		if(symbol == linked->symbols.end()) {
 			linked->relocations.push_back(relocations[i]);
-		} else {
-			switch(relocations[i].type) {
-				case VM::Program::Relocation::Type::Absolute:
-					{
-						unsigned long address = linked->symbols[relocations[i].symbol];
-						std::memcpy(&linked->instructions[relocations[i].offset], &address, 4);
-						break;
-					}
-
-				case VM::Program::Relocation::Type::Call:
-					{
-						VM::Instruction instr;
-						std::memcpy(&instr, &linked->instructions[relocations[i].offset], 4);
-						int symbolOffset = linked->symbols[relocations[i].symbol];
-						instr.one.imm = (symbolOffset - relocations[i].offset) / 4;
-						std::memcpy(&linked->instructions[relocations[i].offset], &instr, 4);
-						break;
-					}
-
-				case VM::Program::Relocation::Type::AddPCRel:
-					{
-						VM::Instruction instr;
-						std::memcpy(&instr, &linked->instructions[relocations[i].offset], 4);
-						int symbolOffset = linked->symbols[relocations[i].symbol];
-						instr.two.imm = symbolOffset - relocations[i].offset;
-						std::memcpy(&linked->instructions[relocations[i].offset], &instr, 4);
-						break;
-					}
-			}
+			continue;
+		}
+
+		int symbolOffset = symbol->second;
+		switch(relocations[i].type) {
+			case VM::Program::Relocation::Type::Absolute:
+				{
+					unsigned long address = symbolOffset;
+					std::memcpy(&linked->instructions[relocations[i].offset], &address, 4);
+					break;
+				}
+
+			case VM::Program::Relocation::Type::Call:
+				{
+					VM::Instruction instr;
+					std::memcpy(&instr, &linked->instructions[relocations[i].offset], 4);
+					instr.one.imm = (symbolOffset - relocations[i].offset) / 4;
+					std::memcpy(&linked->instructions[relocations[i].offset], &instr, 4);
+					break;
+				}
+
+			case VM::Program::Relocation::Type::AddPCRel:
+				{
+					VM::Instruction instr;
+					std::memcpy(&instr, &linked->instructions[relocations[i].offset], 4);
+					instr.two.imm = symbolOffset - relocations[i].offset;
+					std::memcpy(&linked->instructions[relocations[i].offset], &instr, 4);
+					break;
+				}
 		}
 	}
 
@@ -1,85 +1,97 @@
-#include "Compiler.h"
-#include "Linker.h"
+#include "Builder.h"
 #include "Assembler.h"
 
 #include "VM/Interp.h"
 
 #include "Util/Log.h"
 
+#include <cstdlib>
 #include <iostream>
 #include <string>
-#include <fstream>
 
 /*!
- * \brief Compile the runtime if not already present
+ * \brief Directory in which compiled units are cached between runs
+ */
+static const std::string CacheDirectory = "orc-cache";
+
+/*!
+ * \brief Build the runtime.  Units are cached, so this only recompiles runtime sources which
+ * have changed since the last run
  * \param runtimeFilename Filename to store runtime in
+ * \param options Compiler options
  * \return True if success
  */
-bool compileRuntime(const std::string &runtimeFilename)
+bool compileRuntime(const std::string &runtimeFilename, const Compiler::Options &options)
 {
-	std::ifstream runtimeFileTest(runtimeFilename.c_str());
-	if(runtimeFileTest.fail()) {
-		// If runtime file was not present, compile it
-		std::vector<std::string> sourceFilenames;
-		std::vector<std::string> importFilenames;
-		sourceFilenames.push_back("string.lang");
-		sourceFilenames.push_back("System.lang");
-
-		Compiler compiler;
-		std::vector<std::unique_ptr<VM::Program>> programs;
-		std::vector<std::reference_wrapper<const VM::Program>> programList;
-		for(unsigned int i=0; i<sourceFilenames.size(); i++) {
-			std::unique_ptr<VM::Program> program = compiler.compile(sourceFilenames[i], importFilenames);
-			if(!program) {
-				std::cerr << "Error: " << compiler.errorMessage() << std::endl;
-				return false;
-			}
-			programList.push_back(*program);
-			programs.push_back(std::move(program));
-		}
+	// The runtime's source files do not import each other, so they are compiled concurrently
+	Builder builder;
+	builder.setCacheDirectory(CacheDirectory);
+	builder.setOptions(options);
+	builder.addUnit("string.lang", std::vector<std::string>());
+	builder.addUnit("System.lang", std::vector<std::string>());
 
-		Linker linker;
-		std::unique_ptr<VM::Program> linked = linker.link(programList);
-		if(!linked) {
-			std::cerr << "Error: " << linker.errorMessage() << std::endl;
+	std::unique_ptr<VM::Program> linked = builder.build();
+	if(!linked) {
+		std::cerr << "Error: " << builder.errorMessage() << std::endl;
+		return false;
+	}
+	linked->write(runtimeFilename);
+
+	return true;
+}
+
+/*!
+ * \brief Parse command-line options
+ * \param argc Number of arguments
+ * \param argv Arguments
+ * \param options Options to fill in
+ * \return True if success
+ */
+bool parseOptions(int argc, char *argv[], Compiler::Options &options)
+{
+	for(int i=1; i<argc; i++) {
+		std::string argument = argv[i];
+		if(argument == "--allocator=coloring") {
+			options.allocatorMode = Back::RegisterAllocator::Mode::Coloring;
+		} else if(argument == "--allocator=linear-scan") {
+			options.allocatorMode = Back::RegisterAllocator::Mode::LinearScan;
+		} else if(argument == "--allocator=auto") {
+			options.allocatorMode = Back::RegisterAllocator::Mode::Auto;
+		} else if(argument.starts_with("--unroll=")) {
+			options.unrollFactor = std::atoi(argument.c_str() + 9);
+		} else {
+			std::cerr << "Error: Unknown option " << argument << std::endl;
 			return false;
 		}
-		linked->write(runtimeFilename);
 	}
 
 	return true;
 }
 
-int main(int arg, char *argv[])
+int main(int argc, char *argv[])
 {
-	// Ensure that the runtime is compiled
-	std::string runtimeFilename = "runtime.orc";
-	if(!compileRuntime(runtimeFilename)) {
+	Compiler::Options options;
+	if(!parseOptions(argc, argv, options)) {
 		return 1;
 	}
 
-	// Compile the user program
-	Compiler compiler;
-	std::vector<std::string> importFilenames;
-	importFilenames.push_back(runtimeFilename);
-	std::unique_ptr<VM::Program> vmProgram = compiler.compile("input.lang", importFilenames);
-	if(!vmProgram) {
-		std::cerr << "Error: " << compiler.errorMessage() << std::endl;
+	// Ensure that the runtime is up to date
+	std::string runtimeFilename = "runtime.orc";
+	if(!compileRuntime(runtimeFilename, options)) {
 		return 1;
 	}
 
-	// Load the runtime binary
-	std::unique_ptr<VM::Program> runtime = std::make_unique<VM::Program>(runtimeFilename);
-
-	// Link runtime library into program
-	std::vector<std::reference_wrapper<const VM::Program>> programs;
-	programs.push_back(*runtime);
-	programs.push_back(*vmProgram);
+	// Compile the user program and link the runtime library into it.  Nothing imports the
+	// program, so its classes are final
+	Builder builder;
+	builder.setCacheDirectory(CacheDirectory);
+	builder.setOptions(options);
+	builder.addLibrary(runtimeFilename);
+	builder.addUnit("input.lang", std::vector<std::string>{runtimeFilename}, true);
 
-	Linker linker;
-	std::unique_ptr<VM::Program> linked = linker.link(programs);
+	std::unique_ptr<VM::Program> linked = builder.build();
 	if(!linked) {
-		std::cerr << "Error: " << linker.errorMessage() << std::endl;
+		std::cerr << "Error: " << builder.errorMessage() << std::endl;
 		return 1;
 	}
 
@@ -0,0 +1,206 @@
+#include "Middle/Inliner.h"
+
+#include "Analysis/CallGraph.h"
+
+#include "Util/Log.h"
+
+#include <map>
+#include <vector>
+
+namespace Middle {
+	/*!
+	 * \brief Inline calls throughout a program
+	 * \param program Program to transform
+	 */
+	void Inliner::inlineCalls(IR::Program &program)
+	{
+		Analysis::CallGraph callGraph(program);
+
+		for(IR::Procedure *caller : callGraph.bottomUp()) {
+			int callerSize = size(*caller);
+
+			std::vector<IR::Entry*> calls;
+			for(IR::Entry *entry : caller->entries()) {
+				if(entry->type == IR::Entry::Type::Call) {
+					calls.push_back(entry);
+				}
+			}
+
+			for(IR::Entry *call : calls) {
+				IR::Procedure *callee = callGraph.procedure(((IR::EntryCall*)call)->target);
+				if(!callee || callGraph.recursive(callee)) {
+					continue;
+				}
+
+				// Only inline small procedures, and stop once the caller has grown too large
+				int calleeSize = size(*callee);
+				if(calleeSize > MaxInlineSize || callerSize + calleeSize > MaxProcedureSize) {
+					continue;
+				}
+
+				if(inlineCall(*caller, call, *callee)) {
+					callerSize += calleeSize;
+					Util::log("opt") << "Inlined " << callee->name() << " into " << caller->name() << std::endl;
+				}
+			}
+		}
+	}
+
+	/*!
+	 * \brief Estimate the size of a procedure's body
+	 *
+	 * Entries which disappear when the procedure is inlined are not counted.
+	 * \param procedure Procedure to measure
+	 * \return Number of entries
+	 */
+	int Inliner::size(const IR::Procedure &procedure)
+	{
+		int size = 0;
+		for(const IR::Entry *entry : procedure.entries()) {
+			switch(entry->type) {
+				case IR::Entry::Type::Label:
+				case IR::Entry::Type::Prologue:
+				case IR::Entry::Type::Epilogue:
+				case IR::Entry::Type::LoadArg:
+				case IR::Entry::Type::StoreRet:
+					break;
+
+				default:
+					size++;
+					break;
+			}
+		}
+
+		return size;
+	}
+
+	/*!
+	 * \brief Replace a call with a copy of the callee's body
+	 * \param caller Procedure containing the call
+	 * \param call Call entry
+	 * \param callee Procedure being called
+	 * \return True if the call was inlined
+	 */
+	bool Inliner::inlineCall(IR::Procedure &caller, IR::Entry *call, const IR::Procedure &callee)
+	{
+		// Collect the argument stores which immediately precede the call, and the return load
+		// which immediately follows it
+		std::map<int, IR::EntryThreeAddr*> storeArgs;
+		for(IR::Entry *entry = call->prev; entry->type == IR::Entry::Type::StoreArg; entry = entry->prev) {
+			IR::EntryThreeAddr *storeArg = (IR::EntryThreeAddr*)entry;
+			if(storeArgs.find(storeArg->imm) != storeArgs.end()) {
+				return false;
+			}
+			storeArgs[storeArg->imm] = storeArg;
+		}
+
+		IR::EntryThreeAddr *loadRet = nullptr;
+		if(call->next->type == IR::Entry::Type::LoadRet) {
+			loadRet = (IR::EntryThreeAddr*)call->next;
+		}
+
+		for(const IR::Entry *entry : callee.entries()) {
+			if(entry->type == IR::Entry::Type::Phi) {
+				return false;
+			}
+
+			if(entry->type == IR::Entry::Type::LoadArg && storeArgs.find(((const IR::EntryThreeAddr*)entry)->imm) == storeArgs.end()) {
+				return false;
+			}
+		}
+
+		// Each of the callee's symbols and labels is given a fresh copy in the caller
+		std::map<const IR::Symbol*, const IR::Symbol*> symbols;
+		auto mapSymbol = [&](const IR::Symbol *symbol) -> const IR::Symbol* {
+			if(!symbol) {
+				return nullptr;
+			}
+
+			const IR::Symbol *&newSymbol = symbols[symbol];
+			if(!newSymbol) {
+				IR::Symbol *copy = caller.newSymbol(callee.name() + "." + symbol->name, symbol->size, symbol->symbol);
+				caller.addSymbol(copy);
+				newSymbol = copy;
+			}
+			return newSymbol;
+		};
+
+		std::map<const IR::EntryLabel*, IR::EntryLabel*> labels;
+		auto mapLabel = [&](const IR::EntryLabel *label) {
+			IR::EntryLabel *&newLabel = labels[label];
+			if(!newLabel) {
+				newLabel = caller.newLabel();
+			}
+			return newLabel;
+		};
+
+		// Copy the callee's body in place of the call.  The callee's end label becomes the
+		// point at which the inlined body rejoins the caller
+		for(const IR::Entry *entry : callee.entries()) {
+			const IR::EntryThreeAddr *threeAddr = (const IR::EntryThreeAddr*)entry;
+			IR::Entry *newEntry = nullptr;
+
+			switch(entry->type) {
+				case IR::Entry::Type::Prologue:
+				case IR::Entry::Type::Epilogue:
+					break;
+
+				case IR::Entry::Type::LoadArg:
+					newEntry = caller.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::Move, mapSymbol(threeAddr->lhs), storeArgs[threeAddr->imm]->rhs1);
+					break;
+
+				case IR::Entry::Type::StoreRet:
+					if(threeAddr->rhs1 && loadRet) {
+						newEntry = caller.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::Move, loadRet->lhs, mapSymbol(threeAddr->rhs1));
+					}
+					break;
+
+				case IR::Entry::Type::Label:
+					newEntry = mapLabel((const IR::EntryLabel*)entry);
+					break;
+
+				case IR::Entry::Type::Jump:
+					newEntry = caller.newEntry<IR::EntryJump>(mapLabel(((const IR::EntryJump*)entry)->target));
+					break;
+
+				case IR::Entry::Type::CJump:
+					{
+						const IR::EntryCJump *cJump = (const IR::EntryCJump*)entry;
+						newEntry = caller.newEntry<IR::EntryCJump>(mapSymbol(cJump->pred), mapLabel(cJump->trueTarget), mapLabel(cJump->falseTarget));
+						break;
+					}
+
+				case IR::Entry::Type::Call:
+					newEntry = caller.newEntry<IR::EntryCall>(IR::Entry::Type::Call, ((const IR::EntryCall*)entry)->target);
+					break;
+
+				case IR::Entry::Type::LoadString:
+				case IR::Entry::Type::LoadAddress:
+					{
+						const IR::EntryString *string = (const IR::EntryString*)entry;
+						newEntry = caller.newEntry<IR::EntryString>(entry->type, mapSymbol(string->lhs), string->string);
+						break;
+					}
+
+				default:
+					newEntry = caller.newEntry<IR::EntryThreeAddr>(entry->type, mapSymbol(threeAddr->lhs), mapSymbol(threeAddr->rhs1), mapSymbol(threeAddr->rhs2), threeAddr->imm, threeAddr->region);
+					break;
+			}
+
+			if(newEntry) {
+				caller.entries().insert(call, newEntry);
+			}
+		}
+
+		// Remove the original calling sequence
+		for(auto &storeArg : storeArgs) {
+			caller.entries().erase(storeArg.second);
+		}
+		if(loadRet) {
+			caller.entries().erase(loadRet);
+		}
+		caller.entries().erase(call);
+
+		return true;
+	}
+}
\ No newline at end of file
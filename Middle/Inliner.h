@@ -0,0 +1,29 @@
+#ifndef MIDDLE_INLINER_H
+#define MIDDLE_INLINER_H
+
+#include "IR/Program.h"
+#include "IR/Procedure.h"
+#include "IR/Entry.h"
+
+namespace Middle {
+	/*!
+	 * \brief Inline small procedures into their callers
+	 *
+	 * Operates on an entire program, visiting procedures bottom-up in the call graph so that
+	 * callees have already had their own calls inlined.  A call is replaced by a copy of the
+	 * callee's body, with argument loads and return stores rewritten into moves to and from
+	 * the caller's symbols.  Recursive procedures are never inlined.
+	 */
+	class Inliner {
+	public:
+		static const int MaxInlineSize = 20; //!< Largest callee, in entries, which will be inlined
+		static const int MaxProcedureSize = 500; //!< Size beyond which nothing more is inlined into a procedure
+
+		static void inlineCalls(IR::Program &program);
+
+	private:
+		static int size(const IR::Procedure &procedure);
+		static bool inlineCall(IR::Procedure &caller, IR::Entry *call, const IR::Procedure &callee);
+	};
+}
+#endif
\ No newline at end of file
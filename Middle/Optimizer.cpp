@@ -11,7 +11,12 @@
 #include "Transform/CopyProp.h"
 #include "Transform/ThreadJumps.h"
 #include "Transform/LoopInvariantCodeMotion.h"
-#include "Transform/CommonSubexpressionElimination.h"
+#include "Transform/StrengthReduction.h"
+#include "Transform/LoopUnrolling.h"
+#include "Transform/GlobalValueNumbering.h"
+#include "Transform/PartialRedundancyElimination.h"
+
+#include "Middle/Inliner.h"
 
 #include "IR/Program.h"
 #include "IR/Procedure.h"
@@ -24,9 +29,12 @@ namespace Middle {
 	/*!
 	 * \brief Optimize a program
 	 * \param program Program to optimize
+	 * \param unrollFactor Number of copies made when partially unrolling loops
 	 */
-	void Optimizer::optimize(IR::Program &program)
+	void Optimizer::optimize(IR::Program &program, int unrollFactor)
 	{
+		Transform::LoopUnrolling loopUnrolling(unrollFactor);
+
 		std::vector<Transform::Transform*> startingTransforms;
 		std::map<Transform::Transform*, std::vector<Transform::Transform*>> transformMap;
 
@@ -36,7 +44,10 @@ namespace Middle {
 		startingTransforms.push_back(Transform::DeadCodeElimination::instance());
 		startingTransforms.push_back(Transform::ThreadJumps::instance());
 		startingTransforms.push_back(Transform::LoopInvariantCodeMotion::instance());
-		startingTransforms.push_back(Transform::CommonSubexpressionElimination::instance());
+		startingTransforms.push_back(Transform::StrengthReduction::instance());
+		startingTransforms.push_back(&loopUnrolling);
+		startingTransforms.push_back(Transform::GlobalValueNumbering::instance());
+		startingTransforms.push_back(Transform::PartialRedundancyElimination::instance());
 
 		// Transforms to run after CopyProp
 		transformMap[Transform::CopyProp::instance()].push_back(Transform::DeadCodeElimination::instance());
@@ -48,8 +59,25 @@ namespace Middle {
 		transformMap[Transform::DeadCodeElimination::instance()].push_back(Transform::ConstantProp::instance());
 		transformMap[Transform::DeadCodeElimination::instance()].push_back(Transform::CopyProp::instance());
 
-		// Transforms to run after CommonSubexpressionElimination
-		transformMap[Transform::CommonSubexpressionElimination::instance()].push_back(Transform::CopyProp::instance());
+		// Transforms to run after StrengthReduction
+		transformMap[Transform::StrengthReduction::instance()].push_back(Transform::CopyProp::instance());
+
+		// Transforms to run after LoopUnrolling.  Unrolling itself is never repeated, since
+		// that would unroll the loops it has already unrolled
+		transformMap[&loopUnrolling].push_back(Transform::ConstantProp::instance());
+		transformMap[&loopUnrolling].push_back(Transform::CopyProp::instance());
+		transformMap[&loopUnrolling].push_back(Transform::ThreadJumps::instance());
+
+		// Transforms to run after GlobalValueNumbering
+		transformMap[Transform::GlobalValueNumbering::instance()].push_back(Transform::CopyProp::instance());
+		transformMap[Transform::GlobalValueNumbering::instance()].push_back(Transform::ConstantProp::instance());
+
+		// Transforms to run after PartialRedundancyElimination
+		transformMap[Transform::PartialRedundancyElimination::instance()].push_back(Transform::CopyProp::instance());
+
+		// Inline small procedures first, so that the per-procedure passes can optimize the
+		// inlined bodies in the context of their callers
+		Inliner::inlineCalls(program);
 
 		// Optimize each procedure in turn
 		for(std::unique_ptr<IR::Procedure> &procedure : program.procedures()) {
@@ -6,6 +6,7 @@
 #include "Util/UniqueQueue.h"
 
 #include <sstream>
+#include <climits>
 
 namespace Transform {
 	int log2(int value)
@@ -55,7 +56,6 @@ namespace Transform {
 			IR::Entry *toDelete = entry;
 			entry = entry->prev;
 			entries.erase(toDelete);
-			delete toDelete;
 		}
 
 		entry = callEntry->next;
@@ -63,12 +63,10 @@ namespace Transform {
 			IR::Entry *toDelete = entry;
 			entry = entry->next;
 			entries.erase(toDelete);
-			delete toDelete;
 		}
 
 		entries.insert(callEntry, newEntry);
 		entries.erase(callEntry);
-		delete callEntry;
 	}
 
 	bool ConstantProp::transform(IR::Procedure &procedure, Analysis::Analysis &analysis)
@@ -122,11 +120,15 @@ namespace Transform {
 							rhs2Const = true;
 						}
 
+						// A division which would trap is left to be performed at runtime, since it
+						// may lie on a path which is never taken
+						bool traps = (entry->type == IR::Entry::Type::Divide || entry->type == IR::Entry::Type::Modulo) && rhs1Const && rhs2Const && (rhs2 == 0 || (rhs1 == INT_MIN && rhs2 == -1));
+
 						// If both RHS symbols are constant, the entry can be evaluated
 						IR::Entry *newEntry = 0;
-						if(rhs1Const && rhs2Const) {
+						if(rhs1Const && rhs2Const && !traps) {
 							// Calculate the value of the entry
-							int value;
+							int value = 0;
 							switch(entry->type) {
 								case IR::Entry::Type::Add:
 									value = rhs1 + rhs2;
@@ -186,7 +188,7 @@ namespace Transform {
 							}
 
 							// Create a new immediate load entry with the calculated value
-							newEntry = new IR::EntryThreeAddr(IR::Entry::Type::Move, threeAddr->lhs, 0, 0, value);
+							newEntry = procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::Move, threeAddr->lhs, nullptr, nullptr, value);
 						} else if(threeAddr->rhs2 && (rhs1Const || rhs2Const)) {
 							// If one argument is constant and the other is not, an entry can
 							// at least be turned into an Immediate entry
@@ -203,23 +205,28 @@ namespace Transform {
 							switch(threeAddr->type) {
 								case IR::Entry::Type::Add:
 									if(constant == 0) {
-										newEntry = new IR::EntryThreeAddr(IR::Entry::Type::Move, threeAddr->lhs, symbol);
+										newEntry = procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::Move, threeAddr->lhs, symbol);
 									} else {
-										newEntry = new IR::EntryThreeAddr(IR::Entry::Type::Add, threeAddr->lhs, symbol, 0, constant);
+										newEntry = procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::Add, threeAddr->lhs, symbol, nullptr, constant);
 									}
 									break;
 								case IR::Entry::Type::Subtract:
+									// Subtraction does not commute, so only a constant subtrahend can be folded
+									if(rhs1Const) {
+										break;
+									}
+
 									if(constant == 0) {
-										newEntry = new IR::EntryThreeAddr(IR::Entry::Type::Move, threeAddr->lhs, symbol);
+										newEntry = procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::Move, threeAddr->lhs, symbol);
 									} else {
-										newEntry = new IR::EntryThreeAddr(IR::Entry::Type::Add, threeAddr->lhs, symbol, 0, -constant);
+										newEntry = procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::Add, threeAddr->lhs, symbol, nullptr, -constant);
 									}
 									break;
 								case IR::Entry::Type::Mult:
 									if(constant == 1) {
-										newEntry = new IR::EntryThreeAddr(IR::Entry::Type::Move, threeAddr->lhs, symbol);
+										newEntry = procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::Move, threeAddr->lhs, symbol);
 									} else {
-										newEntry = new IR::EntryThreeAddr(IR::Entry::Type::Mult, threeAddr->lhs, symbol, 0, constant);
+										newEntry = procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::Mult, threeAddr->lhs, symbol, nullptr, constant);
 									}
 									break;
 							}
@@ -239,7 +246,6 @@ namespace Transform {
 							// Substitute the new entry into the procedure
 							procedure.entries().insert(threeAddr, newEntry);
 							procedure.entries().erase(threeAddr);
-							delete threeAddr;
 							changed = true;
 						}
 						break;
@@ -263,7 +269,7 @@ namespace Transform {
 							rhs2 = constants.getStringValue(rhs2Entry, rhs2Entry->rhs1, rhs2Const);
 
 							if(rhs1Const && rhs2Const) {
-								IR::Entry *newEntry = new IR::EntryString(IR::Entry::Type::LoadString, retEntry->lhs, rhs1 + rhs2);
+								IR::Entry *newEntry = procedure.newEntry<IR::EntryString>(IR::Entry::Type::LoadString, retEntry->lhs, rhs1 + rhs2);
 
 								// Add all uses of the entry into the queue, it may now be possible
 								// to do further constant propagation on them
@@ -301,7 +307,7 @@ namespace Transform {
 									str = (char)rhs;
 								}
 
-								IR::Entry *newEntry = new IR::EntryString(IR::Entry::Type::LoadString, retEntry->lhs, str);
+								IR::Entry *newEntry = procedure.newEntry<IR::EntryString>(IR::Entry::Type::LoadString, retEntry->lhs, str);
 
 								// Add all uses of the entry into the queue, it may now be possible
 								// to do further constant propagation on them
@@ -334,7 +340,7 @@ namespace Transform {
 						if(isConstant) {
 							analysis.replaceUse(threeAddr, threeAddr->rhs2, 0);
 							threeAddr->rhs2 = 0;
-							threeAddr->imm = value;
+							threeAddr->imm = value << threeAddr->imm;
 							changed = true;
 						} else {
 							const std::set<const IR::Entry*> &defs = useDefs.defines(entry, threeAddr->rhs2);
@@ -365,16 +371,15 @@ namespace Transform {
 						// on the value of the predicate, and construct a new jump entry.
 						IR::EntryJump *jump;
 						if(value) {
-							jump = new IR::EntryJump(cJump->trueTarget);
+							jump = procedure.newEntry<IR::EntryJump>(cJump->trueTarget);
 						} else {
-							jump = new IR::EntryJump(cJump->falseTarget);
+							jump = procedure.newEntry<IR::EntryJump>(cJump->falseTarget);
 						}
 
 						// Update the useDef chains and the procedure itself
 						analysis.replace(cJump, jump);
 						procedure.entries().insert(cJump, jump);
 						procedure.entries().erase(cJump);
-						delete cJump;
 						changed = true;
 						invalidate = true;
 
@@ -25,8 +25,8 @@ namespace Transform {
 	{
 		bool changed = false;
 		std::set<const IR::Entry*> allLoads;
-		std::map<const IR::Entry*, std::set<const IR::Entry*>> gen;
-		std::map<const IR::Entry*, std::set<const IR::Entry*>> kill;
+		std::vector<std::set<const IR::Entry*>> gen(procedure.numEntryIds());
+		std::vector<std::set<const IR::Entry*>> kill(procedure.numEntryIds());
 
 		// Construct the set of all move entries in the procedure
 		for(IR::Entry *entry : procedure.entries()) {
@@ -34,7 +34,7 @@ namespace Transform {
 				allLoads.insert(entry);
 
 				// A move instruction generates that entry
-				gen[entry].insert(entry);
+				gen[entry->id].insert(entry);
 			}
 		}
 
@@ -47,7 +47,7 @@ namespace Transform {
 			for(const IR::Entry *load : allLoads) {
 				// Any entry which assigns to a symbol kills all moves to that same symbol
 				if(entry != load && (load->assign() == entry->assign() || load->uses(entry->assign()))) {
-					kill[entry].insert(load);
+					kill[entry->id].insert(load);
 				}
 			}
 		}
@@ -55,13 +55,13 @@ namespace Transform {
 		// Perform forward data flow analysis with the gen/kill sets constructed above
 		Analysis::DataFlow<const IR::Entry*> dataFlow;
 		const Analysis::FlowGraph &flowGraph = analysis.flowGraph();
-		std::map<const IR::Entry*, std::set<const IR::Entry*>> loads = dataFlow.analyze(flowGraph, gen, kill, allLoads, Analysis::DataFlow<const IR::Entry*>::Meet::Intersect, Analysis::DataFlow<const IR::Entry*>::Direction::Forward);
+		std::vector<std::set<const IR::Entry*>> loads = dataFlow.analyze(flowGraph, gen, kill, allLoads, Analysis::DataFlow<const IR::Entry*>::Meet::Intersect, Analysis::DataFlow<const IR::Entry*>::Direction::Forward);
 
 		// Iterate through the procedure's entries
 		for(IR::Entry *entry : procedure.entries()) {
 			// If a move entry survived to this point, any use of the move's LHS can be
 			// replaced with its RHS
-			for(const IR::Entry *load : loads[entry]) {
+			for(const IR::Entry *load : loads[entry->id]) {
 				IR::EntryThreeAddr *loadEntry = (IR::EntryThreeAddr*)load;
 				if(entry->uses(loadEntry->lhs)) {
 					analysis.replaceUse(entry, loadEntry->lhs, loadEntry->rhs1);
@@ -83,8 +83,8 @@ namespace Transform {
 	{
 		bool changed = false;
 		std::set<const IR::Entry*> allLoads;
-		std::map<const IR::Entry*, std::set<const IR::Entry*>> gen;
-		std::map<const IR::Entry*, std::set<const IR::Entry*>> kill;
+		std::vector<std::set<const IR::Entry*>> gen(procedure.numEntryIds());
+		std::vector<std::set<const IR::Entry*>> kill(procedure.numEntryIds());
 
 		// Construct the set of all move entries in the procedure
 		for(const IR::Entry *entry : procedure.entries()) {
@@ -92,7 +92,7 @@ namespace Transform {
 				allLoads.insert(entry);
 
 				// A move entry generates that entry
-				gen[entry].insert(entry);
+				gen[entry->id].insert(entry);
 			}
 		}
 
@@ -103,7 +103,7 @@ namespace Transform {
 
 				// Any entry which assigns to a symbol kills all moves to that same symbol
 				if(entry != load && (entry->assign() == loadThreeAddr->lhs || entry->assign() == loadThreeAddr->rhs1 || entry->uses(loadThreeAddr->lhs) || entry->uses(loadThreeAddr->rhs1))) {
-					kill[entry].insert(load);
+					kill[entry->id].insert(load);
 				}
 			}
 		}
@@ -111,13 +111,13 @@ namespace Transform {
 		// Perform backwards data flow analysis with the gen/kill sets constructed above
 		Analysis::DataFlow<const IR::Entry*> dataFlow;
 		const Analysis::FlowGraph &flowGraph = analysis.flowGraph();
-		std::map<const IR::Entry*, std::set<const IR::Entry*>> loads = dataFlow.analyze(flowGraph, gen, kill, allLoads, Analysis::DataFlow<const IR::Entry*>::Meet::Intersect, Analysis::DataFlow<const IR::Entry*>::Direction::Backward);
+		std::vector<std::set<const IR::Entry*>> loads = dataFlow.analyze(flowGraph, gen, kill, allLoads, Analysis::DataFlow<const IR::Entry*>::Meet::Intersect, Analysis::DataFlow<const IR::Entry*>::Direction::Backward);
 
 		std::set<const IR::Entry*> deleted;
 
 		// Iterate backwards through the procedure's entries
 		for(IR::Entry *entry : procedure.entries()) {
-			for(const IR::Entry *load : loads[entry]) {
+			for(const IR::Entry *load : loads[entry->id]) {
 				IR::EntryThreeAddr *loadThreeAddr = (IR::EntryThreeAddr*)load;
 
 				// If a move entry survived to this point, any assignment to the load's RHS
@@ -7,6 +7,8 @@
 #include "Analysis/FlowGraph.h"
 #include "Analysis/ReachingDefs.h"
 
+#include <algorithm>
+
 namespace Transform {
 	bool DeadCodeElimination::transform(IR::Procedure &procedure, Analysis::Analysis &analysis)
 	{
@@ -35,7 +37,6 @@ namespace Transform {
 
 		for (const IR::Entry *entry : deleted) {
 			procedure.entries().erase(entry);
-			delete entry;
 		}
 		deleted.clear();
 
@@ -95,7 +96,28 @@ namespace Transform {
 
 		for (const IR::Entry *entry : deleted) {
 			procedure.entries().erase(entry);
-			delete entry;
+		}
+		deleted.clear();
+
+		// Remove stores whose value can never be read
+		const Analysis::AliasAnalysis &aliasAnalysis = analysis.aliasAnalysis();
+		std::vector<const IR::Entry*> loads;
+		for(const IR::Entry *entry : procedure.entries()) {
+			if(entry->type == IR::Entry::Type::LoadMem) {
+				loads.push_back(entry);
+			}
+		}
+
+		for(const IR::Entry *entry : procedure.entries()) {
+			if(entry->type == IR::Entry::Type::StoreMem && isDeadStore(entry, loads, aliasAnalysis)) {
+				deleted.insert(entry);
+			}
+		}
+
+		for (const IR::Entry *entry : deleted) {
+			analysis.remove(entry);
+			procedure.entries().erase(entry);
+			changed = true;
 		}
 		deleted.clear();
 
@@ -109,7 +131,7 @@ namespace Transform {
 		}
 
 		auto it = std::remove_if(procedure.symbols().begin(), procedure.symbols().end(), [&](auto &symbol) {
-			return symbolCount[symbol.get()] == 0;
+			return symbolCount[symbol] == 0;
 		});
 		if(it != procedure.symbols().end()) {
 			changed = true;
@@ -119,6 +141,63 @@ namespace Transform {
 		return changed;
 	}
 
+	/*!
+	 * \brief Check whether a store's value can never be read
+	 *
+	 * A store is dead if it is overwritten later in its block by a store to the same address,
+	 * with no possibly-aliasing load or call in between, or if it writes to memory which is
+	 * invisible outside the procedure and which no load in the procedure may read.
+	 * \param store StoreMem entry
+	 * \param loads All loads in the procedure
+	 * \param aliasAnalysis Alias analysis of the procedure
+	 * \return True if the store is dead
+	 */
+	bool DeadCodeElimination::isDeadStore(const IR::Entry *store, const std::vector<const IR::Entry*> &loads, const Analysis::AliasAnalysis &aliasAnalysis)
+	{
+		for(const IR::Entry *entry = store->next; ; entry = entry->next) {
+			bool done = false;
+			switch(entry->type) {
+				case IR::Entry::Type::StoreMem:
+					if(aliasAnalysis.mustAlias(store, entry)) {
+						return true;
+					}
+					break;
+
+				case IR::Entry::Type::LoadMem:
+					done = aliasAnalysis.mayAlias(store, entry);
+					break;
+
+				case IR::Entry::Type::None:
+				case IR::Entry::Type::Label:
+				case IR::Entry::Type::Jump:
+				case IR::Entry::Type::CJump:
+				case IR::Entry::Type::Call:
+				case IR::Entry::Type::CallIndirect:
+					done = true;
+					break;
+
+				default:
+					break;
+			}
+
+			if(done) {
+				break;
+			}
+		}
+
+		if(!aliasAnalysis.isLocal(store)) {
+			return false;
+		}
+
+		for(const IR::Entry *load : loads) {
+			if(aliasAnalysis.mayAlias(store, load)) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
 	/*!
 	 * \brief Singleton
 	 * \return Instance
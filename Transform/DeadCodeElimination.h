@@ -3,13 +3,18 @@
 
 #include "Transform/Transform.h"
 
+#include "Analysis/AliasAnalysis.h"
+
+#include <vector>
+
 namespace Transform {
 	/*!
 	 * \brief Perform dead code elimination on a procedure
 	 *
 	 * Dead code is defined as any instruction not necessary for the correct functioning
 	 * of the procedure.  This includes assignments to variables which are never read, as
-	 * well as blocks of code which cannot be reached by any path through the control flow graph.
+	 * well as blocks of code which cannot be reached by any path through the control flow graph,
+	 * and stores to memory which is never read afterwards.
 	 */
 	class DeadCodeElimination : public Transform {
 	public:
@@ -17,6 +22,9 @@ namespace Transform {
 		virtual std::string name() { return "DeadCodeElimination"; }
 
 		static DeadCodeElimination *instance();
+
+	private:
+		bool isDeadStore(const IR::Entry *store, const std::vector<const IR::Entry*> &loads, const Analysis::AliasAnalysis &aliasAnalysis);
 	};
 }
 #endif
\ No newline at end of file
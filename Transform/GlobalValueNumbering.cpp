@@ -0,0 +1,437 @@
+#include "Transform/GlobalValueNumbering.h"
+
+#include "IR/Procedure.h"
+
+#include <algorithm>
+
+namespace Transform {
+	bool GlobalValueNumbering::Expression::operator==(const Expression &other) const
+	{
+		return type == other.type && operands[0] == other.operands[0] && operands[1] == other.operands[1] && imm == other.imm && size == other.size && memory == other.memory;
+	}
+
+	size_t GlobalValueNumbering::ExpressionHash::operator()(const Expression &expression) const
+	{
+		size_t hash = (size_t)expression.type;
+		hash = hash * 31 + expression.operands[0];
+		hash = hash * 31 + expression.operands[1];
+		hash = hash * 31 + expression.imm;
+		hash = hash * 31 + expression.size;
+		hash = hash * 31 + expression.memory;
+		return hash;
+	}
+
+	bool GlobalValueNumbering::transform(IR::Procedure &procedure, Analysis::Analysis &analysis)
+	{
+		const Analysis::FlowGraph &flowGraph = analysis.flowGraph();
+		Analysis::DominatorTree doms(procedure, flowGraph);
+
+		State state(procedure, analysis);
+
+		// Build the dominator tree's child lists.  Unreachable blocks are left out of the tree
+		for(const std::unique_ptr<Analysis::FlowGraph::Block> &block : flowGraph.blocks()) {
+			const Analysis::FlowGraph::Block *idom = doms.idom(block.get());
+			if(idom && block.get() != flowGraph.start()) {
+				state.children[idom].push_back(block.get());
+			}
+		}
+
+		for(const IR::Entry *entry : procedure.entries()) {
+			for(const IR::Symbol *symbol : entry->defOperands()) {
+				state.numDefs[symbol]++;
+			}
+		}
+
+		// Number every value in the procedure, recording the redundant entries found
+		processBlock(flowGraph.start(), state);
+
+		if(state.replacements.empty() && state.constants.empty()) {
+			return false;
+		}
+
+		// Replace each redundant entry with a copy of the value's existing symbol, or with the
+		// constant it was found to compute
+		for(auto &replacement : state.replacements) {
+			IR::Entry *entry = replacement.first;
+			procedure.entries().insert(entry, procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::Move, entry->assign(), replacement.second.symbol));
+			procedure.entries().erase(entry);
+		}
+
+		for(auto &constant : state.constants) {
+			IR::Entry *entry = constant.first;
+			procedure.entries().insert(entry, procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::Move, entry->assign(), nullptr, nullptr, constant.second));
+			procedure.entries().erase(entry);
+		}
+
+		analysis.invalidate();
+
+		return true;
+	}
+
+	/*!
+	 * \brief Number the values in a block and the blocks it dominates
+	 * \param block Block to process
+	 * \param state Transform state
+	 */
+	void GlobalValueNumbering::processBlock(const Analysis::FlowGraph::Block *block, State &state)
+	{
+		UndoLog undo;
+
+		// A block with a single predecessor sees memory as its predecessor (which is also its
+		// immediate dominator) left it.  At a join point, memory may have been changed along
+		// any incoming path, so it receives a new version
+		int memory;
+		if(block->pred.size() == 1 && state.memory.find(*block->pred.begin()) != state.memory.end()) {
+			memory = state.memory[*block->pred.begin()];
+		} else {
+			memory = state.nextValue++;
+		}
+
+		for(const IR::Entry *entry : block->entries) {
+			processEntry(state.procedure.entries().entry(entry), block, memory, state, undo);
+		}
+		state.memory[block] = memory;
+
+		for(const Analysis::FlowGraph::Block *child : state.children[block]) {
+			processBlock(child, state);
+		}
+
+		// Remove the expressions computed in this block, since they do not dominate the
+		// remainder of the tree
+		for(auto it = undo.rbegin(); it != undo.rend(); it++) {
+			if(it->second.number == -1) {
+				state.table.erase(it->first);
+			} else {
+				state.table[it->first] = it->second;
+			}
+		}
+	}
+
+	/*!
+	 * \brief Number the value computed by an entry
+	 * \param entry Entry to process
+	 * \param block Block containing the entry
+	 * \param memory Current memory version
+	 * \param state Transform state
+	 * \param undo Undo log for the current scope
+	 */
+	void GlobalValueNumbering::processEntry(IR::Entry *entry, const Analysis::FlowGraph::Block *block, int &memory, State &state, UndoLog &undo)
+	{
+		IR::EntryThreeAddr *threeAddr = (IR::EntryThreeAddr*)entry;
+		Expression expression;
+		expression.type = entry->type;
+		expression.imm = 0;
+		expression.size = 0;
+		expression.memory = 0;
+
+		switch(entry->type) {
+			case IR::Entry::Type::Move:
+				if(state.defValues.find(entry) == state.defValues.end()) {
+					state.defValues[entry] = threeAddr->rhs1 ? operandValue(entry, threeAddr->rhs1, block, state) : constantValue(threeAddr->imm, state);
+				}
+				break;
+
+			case IR::Entry::Type::Add:
+			case IR::Entry::Type::Subtract:
+			case IR::Entry::Type::Mult:
+			case IR::Entry::Type::Divide:
+			case IR::Entry::Type::Modulo:
+			case IR::Entry::Type::Equal:
+			case IR::Entry::Type::Nequal:
+			case IR::Entry::Type::LessThan:
+			case IR::Entry::Type::LessThanE:
+			case IR::Entry::Type::GreaterThan:
+			case IR::Entry::Type::GreaterThanE:
+			case IR::Entry::Type::And:
+			case IR::Entry::Type::Or:
+				{
+					int a = operandValue(entry, threeAddr->rhs1, block, state);
+					int b = threeAddr->rhs2 ? operandValue(entry, threeAddr->rhs2, block, state) : constantValue(threeAddr->imm, state);
+
+					// Apply algebraic identities which reduce the entry to one of its operands or
+					// to a constant
+					const IR::Symbol *identity = nullptr;
+					int zero = constantValue(0, state);
+					int one = constantValue(1, state);
+					switch(entry->type) {
+						case IR::Entry::Type::Add:
+							if(b == zero) {
+								identity = threeAddr->rhs1;
+							} else if(a == zero && threeAddr->rhs2) {
+								identity = threeAddr->rhs2;
+							}
+							break;
+
+						case IR::Entry::Type::Subtract:
+							if(b == zero) {
+								identity = threeAddr->rhs1;
+							} else if(a == b) {
+								state.constants.push_back(std::make_pair(entry, 0));
+								state.defValues[entry] = zero;
+								return;
+							}
+							break;
+
+						case IR::Entry::Type::Mult:
+							if(a == zero || b == zero) {
+								state.constants.push_back(std::make_pair(entry, 0));
+								state.defValues[entry] = zero;
+								return;
+							} else if(b == one) {
+								identity = threeAddr->rhs1;
+							} else if(a == one && threeAddr->rhs2) {
+								identity = threeAddr->rhs2;
+							}
+							break;
+
+						default:
+							break;
+					}
+
+					if(identity) {
+						Value value = { operandValue(entry, identity, block, state), identity, nullptr, nullptr };
+						state.replacements.push_back(std::make_pair(entry, value));
+						state.defValues[entry] = value.number;
+						return;
+					}
+
+					// Place the operands in canonical order, so that equivalent expressions hash
+					// identically
+					switch(entry->type) {
+						case IR::Entry::Type::Add:
+						case IR::Entry::Type::Mult:
+						case IR::Entry::Type::Equal:
+						case IR::Entry::Type::Nequal:
+						case IR::Entry::Type::And:
+						case IR::Entry::Type::Or:
+							if(a > b) {
+								std::swap(a, b);
+							}
+							break;
+
+						case IR::Entry::Type::GreaterThan:
+							expression.type = IR::Entry::Type::LessThan;
+							std::swap(a, b);
+							break;
+
+						case IR::Entry::Type::GreaterThanE:
+							expression.type = IR::Entry::Type::LessThanE;
+							std::swap(a, b);
+							break;
+
+						default:
+							break;
+					}
+
+					expression.operands[0] = a;
+					expression.operands[1] = b;
+					processExpression(entry, expression, state, undo);
+					break;
+				}
+
+			case IR::Entry::Type::LoadMem:
+				expression.operands[0] = operandValue(entry, threeAddr->rhs1, block, state);
+				expression.operands[1] = threeAddr->rhs2 ? operandValue(entry, threeAddr->rhs2, block, state) : -1;
+				expression.imm = threeAddr->imm;
+				expression.size = threeAddr->lhs->size;
+				expression.memory = memory;
+				processExpression(entry, expression, state, undo);
+				break;
+
+			case IR::Entry::Type::StoreMem:
+				{
+					// Remove any loads which the store may overwrite.  Afterwards, the stored value
+					// is known to be at the stored address
+					const Analysis::AliasAnalysis &aliasAnalysis = state.analysis.aliasAnalysis();
+					std::vector<Expression> clobbered;
+					for(auto &pair : state.table) {
+						if(pair.first.type == IR::Entry::Type::LoadMem && pair.first.memory == memory && aliasAnalysis.mayAlias(entry, pair.second.access)) {
+							clobbered.push_back(pair.first);
+						}
+					}
+
+					for(const Expression &clobber : clobbered) {
+						auto it = state.table.find(clobber);
+						undo.push_back(*it);
+						state.table.erase(it);
+					}
+
+					expression.type = IR::Entry::Type::LoadMem;
+					expression.operands[0] = operandValue(entry, threeAddr->rhs1, block, state);
+					expression.operands[1] = threeAddr->rhs2 ? operandValue(entry, threeAddr->rhs2, block, state) : -1;
+					expression.imm = threeAddr->imm;
+					expression.size = threeAddr->lhs->size;
+					expression.memory = memory;
+
+					const std::set<const IR::Entry*> &defs = state.analysis.useDefs().defines(entry, threeAddr->lhs);
+					if(defs.size() == 1) {
+						Value value = { operandValue(entry, threeAddr->lhs, block, state), threeAddr->lhs, *defs.begin(), entry };
+						record(expression, value, state, undo);
+					}
+					break;
+				}
+
+			case IR::Entry::Type::Call:
+			case IR::Entry::Type::CallIndirect:
+				memory = state.nextValue++;
+				break;
+
+			default:
+				if(entry->assign()) {
+					defValue(entry, state);
+				}
+				break;
+		}
+	}
+
+	/*!
+	 * \brief Look up an expression computed by an entry, and record it as redundant if possible
+	 * \param entry Entry computing the expression
+	 * \param expression Expression computed
+	 * \param state Transform state
+	 * \param undo Undo log for the current scope
+	 */
+	void GlobalValueNumbering::processExpression(IR::Entry *entry, const Expression &expression, State &state, UndoLog &undo)
+	{
+		auto it = state.table.find(expression);
+		if(it == state.table.end()) {
+			Value value = { defValue(entry, state), entry->assign(), entry, entry };
+			record(expression, value, state, undo);
+			return;
+		}
+
+		Value existing = it->second;
+		if(state.defValues.find(entry) == state.defValues.end()) {
+			state.defValues[entry] = existing.number;
+		}
+
+		if(holds(existing, entry, state)) {
+			// The value is still available, so the entry is redundant
+			state.replacements.push_back(std::make_pair(entry, existing));
+		} else {
+			// The value's symbol has since been overwritten, so this entry becomes the new
+			// source of the value
+			Value value = { existing.number, entry->assign(), entry, entry };
+			record(expression, value, state, undo);
+		}
+	}
+
+	/*!
+	 * \brief Determine the value number of an operand
+	 *
+	 * An operand with a single reaching definition takes that definition's value.  Operands
+	 * with several reaching definitions are numbered per block: within a block, no other
+	 * definition can intervene without becoming the single reaching definition.
+	 * \param entry Entry using the operand
+	 * \param symbol Operand symbol
+	 * \param block Block containing the entry
+	 * \param state Transform state
+	 * \return Value number
+	 */
+	int GlobalValueNumbering::operandValue(const IR::Entry *entry, const IR::Symbol *symbol, const Analysis::FlowGraph::Block *block, State &state)
+	{
+		const std::set<const IR::Entry*> &defs = state.analysis.useDefs().defines(entry, symbol);
+		if(defs.size() == 1) {
+			return defValue(*defs.begin(), state);
+		}
+
+		// A symbol with no reaching definitions holds the same (undefined) value everywhere
+		std::pair<const IR::Symbol*, const Analysis::FlowGraph::Block*> key(symbol, defs.empty() ? nullptr : block);
+		auto it = state.mergedValues.find(key);
+		if(it != state.mergedValues.end()) {
+			return it->second;
+		}
+
+		int value = state.nextValue++;
+		state.mergedValues[key] = value;
+		return value;
+	}
+
+	/*!
+	 * \brief Determine the value number of a constant
+	 * \param value Constant
+	 * \param state Transform state
+	 * \return Value number
+	 */
+	int GlobalValueNumbering::constantValue(int value, State &state)
+	{
+		auto it = state.constantValues.find(value);
+		if(it != state.constantValues.end()) {
+			return it->second;
+		}
+
+		int number = state.nextValue++;
+		state.constantValues[value] = number;
+		return number;
+	}
+
+	/*!
+	 * \brief Determine the value number assigned by a definition
+	 *
+	 * A definition which is used before it is processed (along a loop back edge) is given a
+	 * new value number at that point.
+	 * \param entry Definition
+	 * \param state Transform state
+	 * \return Value number
+	 */
+	int GlobalValueNumbering::defValue(const IR::Entry *entry, State &state)
+	{
+		auto it = state.defValues.find(entry);
+		if(it != state.defValues.end()) {
+			return it->second;
+		}
+
+		int number = state.nextValue++;
+		state.defValues[entry] = number;
+		return number;
+	}
+
+	/*!
+	 * \brief Check whether a value is still held in its symbol at an entry
+	 * \param value Value to check
+	 * \param entry Entry at which the value is needed
+	 * \param state Transform state
+	 * \return True if the value's symbol holds the value at the entry
+	 */
+	bool GlobalValueNumbering::holds(const Value &value, const IR::Entry *entry, State &state)
+	{
+		// The value's definition dominates the entry, so if it is the only definition of the
+		// symbol, the symbol must still hold the value
+		if(state.numDefs[value.symbol] == 1) {
+			return true;
+		}
+
+		std::set<const IR::Entry*> defs = state.analysis.reachingDefs().defsForSymbol(entry, value.symbol);
+		return defs.size() == 1 && *defs.begin() == value.def;
+	}
+
+	/*!
+	 * \brief Record the value of an expression in the current scope
+	 * \param expression Expression
+	 * \param value Value of the expression
+	 * \param state Transform state
+	 * \param undo Undo log for the current scope
+	 */
+	void GlobalValueNumbering::record(const Expression &expression, const Value &value, State &state, UndoLog &undo)
+	{
+		auto it = state.table.find(expression);
+		if(it == state.table.end()) {
+			Value absent = { -1, nullptr, nullptr, nullptr };
+			undo.push_back(std::make_pair(expression, absent));
+			state.table[expression] = value;
+		} else {
+			undo.push_back(std::make_pair(expression, it->second));
+			it->second = value;
+		}
+	}
+
+	/*!
+	 * \brief Singleton
+	 * \return Instance
+	 */
+	GlobalValueNumbering *GlobalValueNumbering::instance()
+	{
+		static GlobalValueNumbering inst;
+		return &inst;
+	}
+}
\ No newline at end of file
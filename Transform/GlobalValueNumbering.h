@@ -0,0 +1,104 @@
+#ifndef TRANSFORM_GLOBAL_VALUE_NUMBERING_H
+#define TRANSFORM_GLOBAL_VALUE_NUMBERING_H
+
+#include "Transform/Transform.h"
+
+#include "Analysis/DominatorTree.h"
+
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace Transform {
+	/*!
+	 * \brief Eliminate redundant computations by global value numbering
+	 *
+	 * Each value computed in the procedure is assigned a number, such that entries which
+	 * compute the same value receive the same number.  Expressions are hashed on their
+	 * operator and the value numbers of their operands, with commutative operands placed
+	 * in a canonical order, in a hash table scoped by the dominator tree.  An expression
+	 * whose value was already computed by a dominating entry, and is still held in that
+	 * entry's result symbol, is replaced by a copy.
+	 *
+	 * Since the procedure is not in SSA form, the value of an operand is that of its
+	 * reaching definition.  Memory is given a version number which changes at every call
+	 * and at every join point in the flow graph, and a store removes the loads which alias
+	 * analysis says it may overwrite, so that loads are only reused when no store could
+	 * have changed their value.
+	 */
+	class GlobalValueNumbering : public Transform {
+	public:
+		virtual bool transform(IR::Procedure &procedure, Analysis::Analysis &analysis);
+		virtual std::string name() { return "GlobalValueNumbering"; }
+
+		static GlobalValueNumbering *instance();
+
+	private:
+		/*!
+		 * \brief An expression, in terms of the value numbers of its operands
+		 */
+		struct Expression {
+			IR::Entry::Type type; //!< Operation
+			int operands[2]; //!< Operand value numbers, or -1 if not present
+			int imm; //!< Immediate operand, for memory accesses
+			int size; //!< Size of value, for memory accesses
+			int memory; //!< Memory version, for memory accesses
+
+			bool operator==(const Expression &other) const;
+		};
+
+		/*!
+		 * \brief Hash function for expressions
+		 */
+		struct ExpressionHash {
+			size_t operator()(const Expression &expression) const;
+		};
+
+		/*!
+		 * \brief A computed value, along with a symbol known to hold it
+		 */
+		struct Value {
+			int number; //!< Value number
+			const IR::Symbol *symbol; //!< Symbol holding the value
+			const IR::Entry *def; //!< Definition of the symbol which holds the value
+			const IR::Entry *access; //!< Load or store which produced the value, for memory expressions
+		};
+
+		/*!
+		 * \brief State of the transform while walking the dominator tree
+		 */
+		struct State {
+			IR::Procedure &procedure; //!< Procedure being transformed
+			Analysis::Analysis &analysis; //!< Analysis of the procedure
+			std::map<const Analysis::FlowGraph::Block*, std::vector<const Analysis::FlowGraph::Block*>> children; //!< Dominator tree children of each block
+			std::map<const Analysis::FlowGraph::Block*, int> memory; //!< Memory version at the end of each block
+			std::unordered_map<Expression, Value, ExpressionHash> table; //!< Values of expressions computed in dominating entries
+			std::map<const IR::Entry*, int> defValues; //!< Value number assigned by each definition
+			std::map<std::pair<const IR::Symbol*, const Analysis::FlowGraph::Block*>, int> mergedValues; //!< Values of symbols with several reaching definitions, at the start of a block
+			std::map<const IR::Symbol*, int> numDefs; //!< Number of definitions of each symbol
+			std::map<int, int> constantValues; //!< Value numbers of constants
+			std::vector<std::pair<IR::Entry*, Value>> replacements; //!< Entries to replace with copies
+			std::vector<std::pair<IR::Entry*, int>> constants; //!< Entries to replace with constant moves
+			int nextValue; //!< Next unused value number
+
+			/*!
+			 * \brief Constructor
+			 * \param _procedure Procedure being transformed
+			 * \param _analysis Analysis of the procedure
+			 */
+			State(IR::Procedure &_procedure, Analysis::Analysis &_analysis) : procedure(_procedure), analysis(_analysis), nextValue(0) {}
+		};
+
+		typedef std::vector<std::pair<Expression, Value>> UndoLog; //!< Table entries to restore when leaving a dominator tree scope
+
+		void processBlock(const Analysis::FlowGraph::Block *block, State &state);
+		void processEntry(IR::Entry *entry, const Analysis::FlowGraph::Block *block, int &memory, State &state, UndoLog &undo);
+		void processExpression(IR::Entry *entry, const Expression &expression, State &state, UndoLog &undo);
+		int operandValue(const IR::Entry *entry, const IR::Symbol *symbol, const Analysis::FlowGraph::Block *block, State &state);
+		int constantValue(int value, State &state);
+		int defValue(const IR::Entry *entry, State &state);
+		bool holds(const Value &value, const IR::Entry *entry, State &state);
+		void record(const Expression &expression, const Value &value, State &state, UndoLog &undo);
+	};
+}
+#endif
\ No newline at end of file
@@ -8,6 +8,7 @@
 
 #include <sstream>
 #include <queue>
+#include <vector>
 
 namespace Transform {
 
@@ -54,20 +55,35 @@ bool LiveRangeRenaming::transform(IR::Procedure &procedure, Analysis::Analysis &
 {
 	bool changed = false;
 
-	std::vector<std::unique_ptr<IR::Symbol>> newSymbols;
+	std::vector<IR::Symbol*> newSymbols;
 
 	// Construct use-def chains for the procedure
 	const Analysis::UseDefs &useDefs = analysis.useDefs();
 
+	// Collect the entries which reference each symbol, in procedure order
+	std::vector<std::vector<IR::Entry*>> references(procedure.numSymbolIds());
+	for(IR::Entry *entry : procedure.entries()) {
+		for(const IR::Symbol *symbol : entry->useOperands()) {
+			references[symbol->id].push_back(entry);
+		}
+
+		for(const IR::Symbol *symbol : entry->defOperands()) {
+			std::vector<IR::Entry*> &list = references[symbol->id];
+			if(list.empty() || list.back() != entry) {
+				list.push_back(entry);
+			}
+		}
+	}
+
 	// Iterate through each symbol in the procedure
-	for(std::unique_ptr<IR::Symbol> &symbol : procedure.symbols()) {
+	for(IR::Symbol *symbol : procedure.symbols()) {
 		int idx = 0;
 
-		// Iterate through each entry in the procedure
-		for(IR::Entry *entry : procedure.entries()) {
-			// If the given symbol is assigned or used in this entry, rename all uses of the variable
+		// Iterate through each entry which references the symbol
+		for(IR::Entry *entry : references[symbol->id]) {
+			// If the given symbol is still assigned or used in this entry, rename all uses of the variable
 			// that are connected to this one by def-use or use-def chains
-			if(entry->assign() == symbol.get() || entry->uses(symbol.get())) {
+			if(entry->assign() == symbol || entry->uses(symbol)) {
 				std::string newName;
 				if(idx == 0) {
 					// Preserve the same name for the first live range
@@ -81,9 +97,9 @@ bool LiveRangeRenaming::transform(IR::Procedure &procedure, Analysis::Analysis &
 				idx++;
 
 				// Rename the symbol
-				std::unique_ptr<IR::Symbol> newSymbol = std::make_unique<IR::Symbol>(newName, symbol->size, symbol->symbol);
-				renameSymbol(procedure, entry, symbol.get(), newSymbol.get(), useDefs);
-				newSymbols.push_back(std::move(newSymbol));
+				IR::Symbol *newSymbol = procedure.newSymbol(newName, symbol->size, symbol->symbol);
+				renameSymbol(procedure, entry, symbol, newSymbol, useDefs);
+				newSymbols.push_back(newSymbol);
 			}
 		}
 
@@ -93,13 +109,13 @@ bool LiveRangeRenaming::transform(IR::Procedure &procedure, Analysis::Analysis &
 	}
 
 	procedure.symbols().clear();
-	for (std::unique_ptr<IR::Symbol> &symbol : newSymbols) {
-		procedure.addSymbol(std::move(symbol));
+	for (IR::Symbol *symbol : newSymbols) {
+		procedure.addSymbol(symbol);
 	}
 
-	if(changed) {
-		analysis.invalidate();
-	}
+	// Every symbol in the procedure was replaced above, so any cached analysis now refers
+	// to stale symbols, even if no live ranges were actually split
+	analysis.invalidate();
 
 	return changed;
 }
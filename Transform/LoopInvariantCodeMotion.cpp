@@ -5,76 +5,229 @@
 
 #include "IR/Procedure.h"
 
+#include <vector>
+
 namespace Transform {
 	bool LoopInvariantCodeMotion::transform(IR::Procedure &procedure, Analysis::Analysis &analysis)
 	{
-		// Perform loop analysis on the procedure
-		Analysis::Loops loops(procedure, analysis.flowGraph());
+		bool changed = false;
 
-		// Recursively process the root loop of the procedure
-		bool changed = processLoop(*loops.rootLoop(), procedure, loops);
+		// Moving entries invalidates the flow graph, so after each loop is transformed, the
+		// analyses are rebuilt and the search begins again
+		while(true) {
+			// Perform loop analysis on the procedure
+			Analysis::Loops loops(procedure, analysis.flowGraph());
+			Analysis::LiveVariables liveVariables(procedure, analysis.flowGraph());
+			Analysis::DominatorTree doms(procedure, analysis.flowGraph());
+			const Analysis::AliasAnalysis &aliasAnalysis = analysis.aliasAnalysis();
+
+			// Recursively process the root loop of the procedure
+			if(!processLoop(*loops.rootLoop(), procedure, loops, liveVariables, doms, aliasAnalysis)) {
+				break;
+			}
 
-		if(changed) {
 			analysis.invalidate();
+			changed = true;
 		}
 
 		return changed;
 	}
 
+	/*!
+	 * \brief Append an entry to the end of a loop's preheader
+	 * \param procedure Procedure that contains the loop
+	 * \param loop Loop to add to
+	 * \param entry Entry to add
+	 */
+	void LoopInvariantCodeMotion::addToPreheader(IR::Procedure &procedure, const Analysis::Loops::Loop &loop, IR::Entry *entry)
+	{
+		// The preheader may end with a jump to the loop header, in which case the entry goes before it
+		const IR::Entry *position = *loop.preheader->entries.end();
+		if(loop.preheader->entries.back()->type == IR::Entry::Type::Jump) {
+			position = loop.preheader->entries.back();
+		}
+
+		procedure.entries().insert(position, entry);
+	}
+
 	/*!
 	 * \brief Recursively analyze and transform a loop and its descendents
 	 * \param loop Loop to transform
 	 * \param procedure Procedure that contains the loop
 	 * \param loops Loop analysis of the procedure
+	 * \param liveVariables Live variable analysis of the procedure
+	 * \param doms Dominator tree of the procedure
+	 * \param aliasAnalysis Alias analysis of the procedure
+	 * \return True if a loop was transformed
 	 */
-	bool LoopInvariantCodeMotion::processLoop(Analysis::Loops::Loop &loop, IR::Procedure &procedure, Analysis::Loops &loops)
+	bool LoopInvariantCodeMotion::processLoop(Analysis::Loops::Loop &loop, IR::Procedure &procedure, Analysis::Loops &loops, const Analysis::LiveVariables &liveVariables, const Analysis::DominatorTree &doms, const Analysis::AliasAnalysis &aliasAnalysis)
 	{
-		bool changed = false;
-
-		// Process all child loops recursively
+		// Process all child loops recursively, stopping as soon as one is transformed
 		for(Analysis::Loops::Loop *child : loop.children) {
-			changed |= processLoop(*child, procedure, loops);
+			if(processLoop(*child, procedure, loops, liveVariables, doms, aliasAnalysis)) {
+				return true;
+			}
 		}
 
 		// There is no point in processing the root loop, since there is nowhere to move code to
-		if(&loop == loops.rootLoop()) {
-			return changed;
+		if(&loop == loops.rootLoop() || !loop.preheader) {
+			return false;
 		}
 
-		// Construct a set of entries which are invariant in the loop
-		std::set<const IR::Entry*> invariants;
-		std::map<const IR::Symbol *, std::set<const IR::Entry*>> defs;
-
+		// Record all definitions which take place inside of the loop, along with the block
+		// that each entry belongs to, the blocks through which the loop can be exited, and
+		// the entries which may write to memory
+		std::map<const IR::Symbol*, int> numDefs;
+		std::map<const IR::Entry*, const Analysis::FlowGraph::Block*> entryBlocks;
+		std::vector<const Analysis::FlowGraph::Block*> exits;
+		std::vector<const IR::Entry*> stores;
+		bool hasCall = false;
 		for(const Analysis::FlowGraph::Block *block : loop.blocks) {
 			for(const IR::Entry *entry : block->entries) {
-				if(entry->assign()) {
-					// Record all definitions which take place inside of the loop
-					defs[entry->assign()].insert(entry);
+				for(const IR::Symbol *symbol : entry->defOperands()) {
+					numDefs[symbol]++;
 				}
+				entryBlocks[entry] = block;
 
-				// TODO: Non-constant invariants
-				if(entry->type == IR::Entry::Type::Move && ((IR::EntryThreeAddr*)entry)->rhs1 == 0) {
-					// If a symbol is assigned to a constant, it is invariant
-					invariants.insert(entry);
+				if(entry->type == IR::Entry::Type::StoreMem) {
+					stores.push_back(entry);
+				} else if(entry->type == IR::Entry::Type::Call || entry->type == IR::Entry::Type::CallIndirect) {
+					hasCall = true;
+				}
+			}
+
+			for(const Analysis::FlowGraph::Block *succ : block->succ) {
+				if(loop.blocks.find(succ) == loop.blocks.end()) {
+					exits.push_back(succ);
 				}
 			}
 		}
 
-		// Iterate through the invariant entries discovered above
-		for(const IR::Entry *constEntry : invariants) {
-			IR::Entry *entry = procedure.entries().entry(constEntry);
-			// TODO: Test for use outside of loops
-			if(defs[entry->assign()].size() != 1) {
-				continue;
+		// Symbols live on entry to the loop header carry a value in from outside the loop, or
+		// around from the previous iteration
+		const std::set<const IR::Symbol*> &headerLive = liveVariables.variables(loop.header->entries.front());
+
+		// Construct a list of entries which are invariant in the loop.  An entry is invariant
+		// if each of its arguments is either assigned only outside of the loop, or is assigned
+		// by another invariant entry.  The list is built up until no further invariants are
+		// found, so that each entry appears after the invariants it depends on.
+		std::vector<IR::Entry*> invariants;
+		std::set<const IR::Symbol*> invariantSymbols;
+		bool found = true;
+		while(found) {
+			found = false;
+			for(auto &entryBlock : entryBlocks) {
+				const IR::Entry *entry = entryBlock.first;
+				const IR::Symbol *assign = entry->assign();
+				if(!assign || invariantSymbols.find(assign) != invariantSymbols.end()) {
+					continue;
+				}
+
+				// A load may fault, so it is only hoisted from the loop header, which runs
+				// whenever the preheader does.  Nothing in the loop may write to the loaded memory.
+				if(entry->type == IR::Entry::Type::LoadMem) {
+					if(entryBlock.second != loop.header || hasCall) {
+						continue;
+					}
+
+					bool clobbered = false;
+					for(const IR::Entry *store : stores) {
+						if(aliasAnalysis.mayAlias(store, entry)) {
+							clobbered = true;
+							break;
+						}
+					}
+
+					if(clobbered) {
+						continue;
+					}
+				} else if(!isHoistable(entry)) {
+					continue;
+				}
+
+				// The symbol must be assigned only here, and must not be read in the loop
+				// before this assignment takes place
+				if(numDefs[assign] != 1 || headerLive.find(assign) != headerLive.end()) {
+					continue;
+				}
+
+				bool invariant = true;
+				for(const IR::Symbol *symbol : entry->useOperands()) {
+					if(numDefs.find(symbol) != numDefs.end() && invariantSymbols.find(symbol) == invariantSymbols.end()) {
+						invariant = false;
+						break;
+					}
+				}
+
+				if(!invariant) {
+					continue;
+				}
+
+				// Unless the assignment takes place on every path through the loop, hoisting
+				// it must not change the value seen after the loop exits
+				for(const Analysis::FlowGraph::Block *exit : exits) {
+					const std::set<const IR::Symbol*> &exitLive = liveVariables.variables(exit->entries.front());
+					if(exitLive.find(assign) != exitLive.end()) {
+						for(const Analysis::FlowGraph::Block *pred : exit->pred) {
+							if(loop.blocks.find(pred) != loop.blocks.end() && pred != entryBlock.second && !doms.dominates(pred, entryBlock.second)) {
+								invariant = false;
+							}
+						}
+					}
+				}
+
+				if(invariant) {
+					invariants.push_back(procedure.entries().entry(entry));
+					invariantSymbols.insert(assign);
+					found = true;
+				}
 			}
+		}
 
-			// Move the entry into the loop's preheader
+		// Move the invariant entries into the loop's preheader
+		for(IR::Entry *entry : invariants) {
 			procedure.entries().erase(entry);
-			procedure.entries().insert(*loop.preheader->entries.end(), entry);
-			changed = true;
+			addToPreheader(procedure, loop, entry);
 		}
 
-		return changed;
+		return invariants.size() > 0;
+	}
+
+	/*!
+	 * \brief Check whether an entry can be executed speculatively outside of its loop
+	 * \param entry Entry to check
+	 * \return True if the entry has no side effects and cannot fault
+	 */
+	bool LoopInvariantCodeMotion::isHoistable(const IR::Entry *entry)
+	{
+		switch(entry->type) {
+			case IR::Entry::Type::Move:
+			case IR::Entry::Type::Add:
+			case IR::Entry::Type::Subtract:
+			case IR::Entry::Type::Mult:
+			case IR::Entry::Type::Equal:
+			case IR::Entry::Type::Nequal:
+			case IR::Entry::Type::LessThan:
+			case IR::Entry::Type::LessThanE:
+			case IR::Entry::Type::GreaterThan:
+			case IR::Entry::Type::GreaterThanE:
+			case IR::Entry::Type::And:
+			case IR::Entry::Type::Or:
+			case IR::Entry::Type::LoadString:
+			case IR::Entry::Type::LoadAddress:
+				return true;
+
+			case IR::Entry::Type::Divide:
+			case IR::Entry::Type::Modulo:
+				{
+					// Division is only safe to hoist if the divisor is a nonzero constant
+					const IR::EntryThreeAddr *threeAddr = (const IR::EntryThreeAddr*)entry;
+					return !threeAddr->rhs2 && threeAddr->imm != 0;
+				}
+
+			default:
+				return false;
+		}
 	}
 
 	/*!
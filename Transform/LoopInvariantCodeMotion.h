@@ -4,6 +4,9 @@
 #include "Transform/Transform.h"
 
 #include "Analysis/Loops.h"
+#include "Analysis/LiveVariables.h"
+#include "Analysis/DominatorTree.h"
+#include "Analysis/AliasAnalysis.h"
 
 namespace Transform {
 	/*!
@@ -19,8 +22,11 @@ namespace Transform {
 
 		static LoopInvariantCodeMotion *instance();
 
+		static void addToPreheader(IR::Procedure &procedure, const Analysis::Loops::Loop &loop, IR::Entry *entry);
+
 	private:
-		bool processLoop(Analysis::Loops::Loop &loop, IR::Procedure &procedure, Analysis::Loops &loops);
+		bool processLoop(Analysis::Loops::Loop &loop, IR::Procedure &procedure, Analysis::Loops &loops, const Analysis::LiveVariables &liveVariables, const Analysis::DominatorTree &doms, const Analysis::AliasAnalysis &aliasAnalysis);
+		bool isHoistable(const IR::Entry *entry);
 	};
 }
 #endif
\ No newline at end of file
@@ -0,0 +1,491 @@
+#include "Transform/LoopUnrolling.h"
+
+#include "Analysis/InductionVariables.h"
+
+#include "IR/Procedure.h"
+
+#include <algorithm>
+
+namespace Transform {
+	/*!
+	 * \brief Constructor
+	 * \param factor Number of copies made by partial unrolling.  No loops are unrolled at
+	 *        all, even completely, if this is less than 2
+	 */
+	LoopUnrolling::LoopUnrolling(int factor)
+	{
+		mFactor = factor;
+	}
+
+	bool LoopUnrolling::transform(IR::Procedure &procedure, Analysis::Analysis &analysis)
+	{
+		if(mFactor < 2) {
+			return false;
+		}
+
+		Analysis::Loops loops(procedure, analysis.flowGraph());
+		Analysis::LiveVariables liveVariables(procedure, analysis.flowGraph());
+
+		// Plan the unrolling of every innermost loop before changing anything, since the
+		// analyses are invalidated by the first change
+		std::vector<Plan> plans;
+		for(std::unique_ptr<Analysis::Loops::Loop> &loop : loops.loops()) {
+			Plan plan;
+			if(loop->children.empty() && planLoop(*loop, procedure, analysis, liveVariables, plan)) {
+				plans.push_back(plan);
+			}
+		}
+
+		for(Plan &plan : plans) {
+			if(plan.trips != -1) {
+				unrollFully(procedure, plan);
+			} else if(plan.compare) {
+				unrollCounted(procedure, plan);
+			} else {
+				unrollChained(procedure, plan);
+			}
+		}
+
+		if(plans.size() > 0) {
+			analysis.invalidate();
+			return true;
+		}
+
+		return false;
+	}
+
+	/*!
+	 * \brief Determine whether and how a loop should be unrolled
+	 * \param loop Loop to examine
+	 * \param procedure Procedure containing the loop
+	 * \param analysis Analysis of the procedure
+	 * \param liveVariables Live variable analysis of the procedure
+	 * \param plan Plan to fill out
+	 * \return True if the loop should be unrolled
+	 */
+	bool LoopUnrolling::planLoop(Analysis::Loops::Loop &loop, IR::Procedure &procedure, Analysis::Analysis &analysis, const Analysis::LiveVariables &liveVariables, Plan &plan)
+	{
+		if(!loop.preheader) {
+			return false;
+		}
+
+		// The preheader must reach the header either by falling through or by an unconditional jump
+		const IR::Entry *preheaderBack = loop.preheader->entries.back();
+		plan.preheaderJump = nullptr;
+		if(preheaderBack->type == IR::Entry::Type::Jump) {
+			plan.preheaderJump = procedure.entries().entry(preheaderBack);
+		} else if(preheaderBack->type == IR::Entry::Type::CJump) {
+			return false;
+		}
+
+		// The loop must occupy a contiguous range of entries, starting with the header label
+		// and ending with the only jump back to it
+		std::set<const IR::Entry*> loopEntries;
+		std::vector<IR::Entry*> loopDefs;
+		for(const Analysis::FlowGraph::Block *block : loop.blocks) {
+			for(const IR::Entry *entry : block->entries) {
+				loopEntries.insert(entry);
+				if(entry->type == IR::Entry::Type::Phi) {
+					return false;
+				}
+			}
+		}
+
+		const IR::Entry *headerLabel = loop.header->entries.front();
+		if(headerLabel->type != IR::Entry::Type::Label) {
+			return false;
+		}
+
+		plan.entries.clear();
+		for(IR::Entry *entry = procedure.entries().entry(headerLabel); plan.entries.size() < loopEntries.size(); entry = entry->next) {
+			if(loopEntries.find(entry) == loopEntries.end()) {
+				return false;
+			}
+			plan.entries.push_back(entry);
+			if(entry->assign()) {
+				loopDefs.push_back(entry);
+			}
+		}
+
+		IR::Entry *back = plan.entries.back();
+		if(back->type != IR::Entry::Type::Jump || ((IR::EntryJump*)back)->target != headerLabel) {
+			return false;
+		}
+
+		// Temporaries which are live neither around the back edge nor out of the loop hold
+		// values which are local to one iteration, so each copy of the body gets its own
+		std::set<const IR::Symbol*> outliving = liveVariables.variables(headerLabel);
+		for(const IR::Entry *entry : plan.entries) {
+			if(entry->type == IR::Entry::Type::Jump || entry->type == IR::Entry::Type::CJump) {
+				const IR::EntryLabel *target = (entry->type == IR::Entry::Type::Jump) ? ((IR::EntryJump*)entry)->target : ((IR::EntryCJump*)entry)->trueTarget;
+				const IR::EntryLabel *target2 = (entry->type == IR::Entry::Type::Jump) ? target : ((IR::EntryCJump*)entry)->falseTarget;
+				for(const IR::EntryLabel *exit : {target, target2}) {
+					if(loopEntries.find(exit) == loopEntries.end()) {
+						const std::set<const IR::Symbol*> &exitLive = liveVariables.variables(exit);
+						outliving.insert(exitLive.begin(), exitLive.end());
+					}
+				}
+			}
+		}
+
+		plan.locals.clear();
+		for(const IR::Entry *def : loopDefs) {
+			if(!def->assign()->symbol && outliving.find(def->assign()) == outliving.end()) {
+				plan.locals.insert(def->assign());
+			}
+		}
+
+		for(IR::Entry *entry : plan.entries) {
+			if(entry != back && entry->type == IR::Entry::Type::Jump && ((IR::EntryJump*)entry)->target == headerLabel) {
+				return false;
+			}
+			if(entry->type == IR::Entry::Type::CJump && (((IR::EntryCJump*)entry)->trueTarget == headerLabel || ((IR::EntryCJump*)entry)->falseTarget == headerLabel)) {
+				return false;
+			}
+		}
+
+		// Check for a counted loop: the header compares a basic induction variable, incremented
+		// on every iteration, against a bound which does not change in the loop, and the loop
+		// is exited only from the header
+		plan.compare = nullptr;
+		plan.test = nullptr;
+		plan.trips = -1;
+		const IR::Symbol *inductionVariable = nullptr;
+		Analysis::InductionVariables inductionVariables(loop);
+
+		if(plan.entries.size() > 3 && plan.entries[1]->type >= IR::Entry::Type::LessThan && plan.entries[1]->type <= IR::Entry::Type::GreaterThanE && plan.entries[2]->type == IR::Entry::Type::CJump) {
+			IR::EntryThreeAddr *compare = (IR::EntryThreeAddr*)plan.entries[1];
+			IR::EntryCJump *test = (IR::EntryCJump*)plan.entries[2];
+
+			bool counted = (test->pred == compare->lhs && test->trueTarget == plan.entries[3] && loopEntries.find(test->falseTarget) == loopEntries.end());
+
+			// The comparison result must not be needed once the loop exits
+			const std::set<const IR::Symbol*> &exitLive = liveVariables.variables(test->falseTarget);
+			counted = counted && exitLive.find(compare->lhs) == exitLive.end();
+
+			auto itBasic = inductionVariables.basicVariables().find(compare->rhs1);
+			counted = counted && compare->rhs2 && itBasic != inductionVariables.basicVariables().end();
+
+			for(const IR::Entry *def : loopDefs) {
+				counted = counted && def->assign() != compare->rhs2;
+			}
+
+			for(const IR::Entry *entry : plan.entries) {
+				if(entry != test && (entry->type == IR::Entry::Type::CJump || (entry->type == IR::Entry::Type::Jump && entry != back))) {
+					const IR::EntryLabel *target = (entry->type == IR::Entry::Type::Jump) ? ((IR::EntryJump*)entry)->target : ((IR::EntryCJump*)entry)->trueTarget;
+					const IR::EntryLabel *target2 = (entry->type == IR::Entry::Type::Jump) ? target : ((IR::EntryCJump*)entry)->falseTarget;
+					counted = counted && loopEntries.find(target) != loopEntries.end() && loopEntries.find(target2) != loopEntries.end();
+				}
+			}
+
+			if(counted) {
+				// The increment must take place on every iteration, so it must be in the block which
+				// jumps back to the header
+				const Analysis::FlowGraph::Block *latch = nullptr;
+				for(const Analysis::FlowGraph::Block *block : loop.blocks) {
+					if(block->entries.back() == back) {
+						latch = block;
+					}
+				}
+
+				bool inLatch = false;
+				for(const IR::Entry *entry : latch->entries) {
+					inLatch = inLatch || entry == itBasic->second.increment;
+				}
+
+				if(inLatch) {
+					plan.compare = compare;
+					plan.test = test;
+					plan.step = itBasic->second.step;
+					inductionVariable = itBasic->first;
+				}
+			}
+		}
+
+		// Unroll completely if the trip count is known and small enough
+		if(plan.compare) {
+			int trips = tripCount(plan, inductionVariable, loopDefs, analysis);
+			if(trips != -1 && trips * size(plan.entries, 3) <= MaxUnrolledSize) {
+				plan.trips = trips;
+				return true;
+			}
+		}
+
+		// Otherwise choose a partial unrolling factor that keeps the loop within the size limit
+		int loopSize = plan.compare ? size(plan.entries, 3) : size(plan.entries, 0);
+		plan.factor = std::min(mFactor, MaxUnrolledSize / std::max(loopSize, 1));
+		if(plan.factor < 2) {
+			return false;
+		}
+
+		// A counted loop is unrolled ahead of a remainder loop only if the induction variable
+		// moves toward the bound, and the amount it moves in one trip through the unrolled
+		// loop fits in an immediate operand
+		if(plan.compare) {
+			bool increasing = (plan.compare->type == IR::Entry::Type::LessThan || plan.compare->type == IR::Entry::Type::LessThanE);
+			long distance = (long)(plan.factor - 1) * plan.step;
+			if((increasing ? plan.step <= 0 : plan.step >= 0) || distance < -0x8000 || distance > 0x7fff) {
+				plan.compare = nullptr;
+				plan.test = nullptr;
+				plan.factor = std::min(mFactor, MaxUnrolledSize / std::max(size(plan.entries, 0), 1));
+				if(plan.factor < 2) {
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	/*!
+	 * \brief Determine the trip count of a counted loop
+	 * \param plan Loop plan
+	 * \param inductionVariable Loop's induction variable
+	 * \param loopDefs Assignments inside the loop
+	 * \param analysis Analysis of the procedure
+	 * \return Trip count, or -1 if it is unknown or too large to unroll completely
+	 */
+	int LoopUnrolling::tripCount(const Plan &plan, const IR::Symbol *inductionVariable, const std::vector<IR::Entry*> &loopDefs, Analysis::Analysis &analysis)
+	{
+		// The induction variable must be set to a constant before the loop begins
+		const IR::Entry *initial = nullptr;
+		for(const IR::Entry *def : analysis.useDefs().defines(plan.compare, inductionVariable)) {
+			if(std::find(loopDefs.begin(), loopDefs.end(), def) != loopDefs.end()) {
+				continue;
+			}
+
+			if(initial) {
+				return -1;
+			}
+			initial = def;
+		}
+
+		if(!initial || initial->type != IR::Entry::Type::Move || ((IR::EntryThreeAddr*)initial)->rhs1) {
+			return -1;
+		}
+
+		bool isConstant;
+		int bound = analysis.constants().getIntValue(plan.compare, plan.compare->rhs2, isConstant);
+		if(!isConstant) {
+			return -1;
+		}
+
+		// Step the induction variable until the comparison fails
+		int value = ((IR::EntryThreeAddr*)initial)->imm;
+		for(int trips = 0; trips <= MaxFullUnrollTrips; trips++) {
+			bool result;
+			switch(plan.compare->type) {
+				case IR::Entry::Type::LessThan: result = value < bound; break;
+				case IR::Entry::Type::LessThanE: result = value <= bound; break;
+				case IR::Entry::Type::GreaterThan: result = value > bound; break;
+				case IR::Entry::Type::GreaterThanE: result = value >= bound; break;
+				default: return -1;
+			}
+
+			if(!result) {
+				return trips;
+			}
+
+			value += plan.step;
+		}
+
+		return -1;
+	}
+
+	/*!
+	 * \brief Replace a counted loop with one copy of its body per iteration
+	 * \param procedure Procedure containing the loop
+	 * \param plan Loop plan
+	 */
+	void LoopUnrolling::unrollFully(IR::Procedure &procedure, Plan &plan)
+	{
+		IR::Entry *headerLabel = plan.entries.front();
+		IR::EntryLabel *start = procedure.newLabel();
+		procedure.entries().insert(headerLabel, start);
+
+		for(int i=0; i<plan.trips; i++) {
+			// Each copy falls through into the next
+			IR::EntryLabel *next = procedure.newLabel();
+			copyBody(procedure, plan, 3, headerLabel, next);
+			procedure.entries().insert(headerLabel, next);
+		}
+		procedure.entries().insert(headerLabel, procedure.newEntry<IR::EntryJump>(plan.test->falseTarget));
+
+		if(plan.preheaderJump) {
+			((IR::EntryJump*)plan.preheaderJump)->target = start;
+		}
+
+		for(IR::Entry *entry : plan.entries) {
+			procedure.entries().erase(entry);
+		}
+	}
+
+	/*!
+	 * \brief Precede a counted loop with an unrolled copy
+	 *
+	 * The unrolled loop runs while the induction variable will still satisfy the bound after
+	 * all of its copies of the body have executed, and then falls into the original loop,
+	 * which completes the remaining iterations.
+	 * \param procedure Procedure containing the loop
+	 * \param plan Loop plan
+	 */
+	void LoopUnrolling::unrollCounted(IR::Procedure &procedure, Plan &plan)
+	{
+		IR::Entry *headerLabel = plan.entries.front();
+		IR::EntryLabel *start = procedure.newLabel();
+		IR::EntryLabel *body = procedure.newLabel();
+		IR::Symbol *limit = procedure.newTemp(plan.compare->rhs1->size);
+		IR::Symbol *pred = procedure.newTemp(plan.compare->lhs->size);
+
+		procedure.entries().insert(headerLabel, start);
+		procedure.entries().insert(headerLabel, procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::Add, limit, plan.compare->rhs1, nullptr, (plan.factor - 1) * plan.step));
+		procedure.entries().insert(headerLabel, procedure.newEntry<IR::EntryThreeAddr>(plan.compare->type, pred, limit, plan.compare->rhs2));
+		procedure.entries().insert(headerLabel, procedure.newEntry<IR::EntryCJump>(pred, body, (IR::EntryLabel*)headerLabel));
+		procedure.entries().insert(headerLabel, body);
+
+		for(int i=0; i<plan.factor; i++) {
+			IR::EntryLabel *next = (i == plan.factor - 1) ? start : procedure.newLabel();
+			copyBody(procedure, plan, 3, headerLabel, next);
+			if(next != start) {
+				procedure.entries().insert(headerLabel, next);
+			}
+		}
+		procedure.entries().insert(headerLabel, procedure.newEntry<IR::EntryJump>(start));
+
+		if(plan.preheaderJump) {
+			((IR::EntryJump*)plan.preheaderJump)->target = start;
+		}
+	}
+
+	/*!
+	 * \brief Unroll a loop by chaining copies of it together
+	 *
+	 * Each copy retains its own exit tests, and jumps back into the next copy.  The last copy
+	 * jumps back to the original loop.
+	 * \param procedure Procedure containing the loop
+	 * \param plan Loop plan
+	 */
+	void LoopUnrolling::unrollChained(IR::Procedure &procedure, Plan &plan)
+	{
+		IR::Entry *back = plan.entries.back();
+		IR::Entry *position = back->next;
+		IR::EntryLabel *headerLabel = (IR::EntryLabel*)plan.entries.front();
+
+		// The original loop now falls through into the first copy
+		procedure.entries().erase(back);
+
+		for(int i=1; i<plan.factor; i++) {
+			copyBody(procedure, plan, 0, position, headerLabel);
+		}
+		procedure.entries().insert(position, procedure.newEntry<IR::EntryJump>(headerLabel));
+	}
+
+	/*!
+	 * \brief Insert a copy of part of a loop
+	 *
+	 * The final jump back to the loop header is not copied, so the copy falls through to
+	 * whatever follows it.  Other jumps back to the header are redirected to a new target.
+	 * \param procedure Procedure containing the loop
+	 * \param plan Loop plan
+	 * \param begin Index of the first loop entry to copy
+	 * \param position Entry to insert the copy before
+	 * \param backTarget Target for jumps back to the header
+	 */
+	void LoopUnrolling::copyBody(IR::Procedure &procedure, Plan &plan, unsigned int begin, const IR::Entry *position, IR::EntryLabel *backTarget)
+	{
+		const IR::EntryLabel *headerLabel = (const IR::EntryLabel*)plan.entries.front();
+
+		// Give each label in the copied range a fresh copy
+		std::map<const IR::EntryLabel*, IR::EntryLabel*> labels;
+		for(unsigned int i=begin; i<plan.entries.size(); i++) {
+			if(plan.entries[i]->type == IR::Entry::Type::Label) {
+				labels[(IR::EntryLabel*)plan.entries[i]] = procedure.newLabel();
+			}
+		}
+
+		auto mapTarget = [&](IR::EntryLabel *target) {
+			if(target == headerLabel) {
+				return backTarget;
+			}
+
+			auto it = labels.find(target);
+			return (it == labels.end()) ? target : it->second;
+		};
+
+		// Likewise give each temporary which is local to one iteration and assigned in the
+		// copied range a fresh symbol
+		std::map<const IR::Symbol*, const IR::Symbol*> symbols;
+		for(unsigned int i=begin; i<plan.entries.size(); i++) {
+			const IR::Symbol *symbol = plan.entries[i]->assign();
+			if(symbol && plan.locals.find(symbol) != plan.locals.end() && symbols.find(symbol) == symbols.end()) {
+				symbols[symbol] = procedure.newTemp(symbol->size);
+			}
+		}
+
+		auto mapSymbol = [&](const IR::Symbol *symbol) {
+			auto it = symbols.find(symbol);
+			return (it == symbols.end()) ? symbol : it->second;
+		};
+
+		for(unsigned int i=begin; i<plan.entries.size() - 1; i++) {
+			const IR::Entry *entry = plan.entries[i];
+			IR::Entry *newEntry;
+
+			switch(entry->type) {
+				case IR::Entry::Type::Label:
+					newEntry = labels[(IR::EntryLabel*)entry];
+					break;
+
+				case IR::Entry::Type::Jump:
+					newEntry = procedure.newEntry<IR::EntryJump>(mapTarget(((const IR::EntryJump*)entry)->target));
+					break;
+
+				case IR::Entry::Type::CJump:
+					{
+						const IR::EntryCJump *cJump = (const IR::EntryCJump*)entry;
+						newEntry = procedure.newEntry<IR::EntryCJump>(mapSymbol(cJump->pred), mapTarget(cJump->trueTarget), mapTarget(cJump->falseTarget));
+						break;
+					}
+
+				case IR::Entry::Type::Call:
+					newEntry = procedure.newEntry<IR::EntryCall>(IR::Entry::Type::Call, ((const IR::EntryCall*)entry)->target);
+					break;
+
+				case IR::Entry::Type::LoadString:
+				case IR::Entry::Type::LoadAddress:
+					{
+						const IR::EntryString *string = (const IR::EntryString*)entry;
+						newEntry = procedure.newEntry<IR::EntryString>(entry->type, mapSymbol(string->lhs), string->string);
+						break;
+					}
+
+				default:
+					{
+						const IR::EntryThreeAddr *threeAddr = (const IR::EntryThreeAddr*)entry;
+						newEntry = procedure.newEntry<IR::EntryThreeAddr>(entry->type, mapSymbol(threeAddr->lhs), mapSymbol(threeAddr->rhs1), mapSymbol(threeAddr->rhs2), threeAddr->imm, threeAddr->region);
+						break;
+					}
+			}
+
+			procedure.entries().insert(position, newEntry);
+		}
+	}
+
+	/*!
+	 * \brief Count the entries in part of a loop, not including labels
+	 * \param entries Loop entries
+	 * \param begin Index of first entry to count
+	 * \return Number of entries
+	 */
+	int LoopUnrolling::size(const std::vector<IR::Entry*> &entries, unsigned int begin)
+	{
+		int size = 0;
+		for(unsigned int i=begin; i<entries.size(); i++) {
+			if(entries[i]->type != IR::Entry::Type::Label) {
+				size++;
+			}
+		}
+
+		return size;
+	}
+}
\ No newline at end of file
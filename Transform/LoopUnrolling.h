@@ -0,0 +1,65 @@
+#ifndef TRANSFORM_LOOP_UNROLLING_H
+#define TRANSFORM_LOOP_UNROLLING_H
+
+#include "Transform/Transform.h"
+
+#include "Analysis/Loops.h"
+#include "Analysis/LiveVariables.h"
+
+#include <vector>
+#include <set>
+
+namespace Transform {
+	/*!
+	 * \brief Unroll innermost loops
+	 *
+	 * A counted loop (one which compares a basic induction variable against an invariant
+	 * bound in its header, and exits nowhere else) is unrolled completely if its trip count
+	 * is a small constant.  Otherwise, it is preceded by an unrolled copy which runs several
+	 * iterations for each test of the bound, leaving the original loop to run the remaining
+	 * iterations.  Any other loop is unrolled by chaining copies of it together, each of
+	 * which keeps its own exit test, which saves the jump back to the header.
+	 *
+	 * Unlike most transforms, this one is not a singleton, since its factor is chosen per
+	 * compilation and compilations may run concurrently.
+	 */
+	class LoopUnrolling : public Transform {
+	public:
+		virtual bool transform(IR::Procedure &procedure, Analysis::Analysis &analysis);
+		virtual std::string name() { return "LoopUnrolling"; }
+
+		LoopUnrolling(int factor = DefaultFactor);
+
+		int factor() { return mFactor; } //!< Number of copies made by partial unrolling
+
+		static const int DefaultFactor = 4; //!< Default unrolling factor
+		static const int MaxUnrolledSize = 48; //!< Largest number of entries an unrolled loop may contain
+		static const int MaxFullUnrollTrips = 16; //!< Largest trip count which will be unrolled completely
+
+	private:
+		/*!
+		 * \brief Description of a loop to be unrolled
+		 */
+		struct Plan {
+			std::vector<IR::Entry*> entries; //!< Loop entries, beginning with the header label and ending with the jump back to it
+			IR::Entry *preheaderJump; //!< Jump from the preheader to the header, if any
+			IR::EntryThreeAddr *compare; //!< Comparison of the induction variable against the bound, for counted loops
+			IR::EntryCJump *test; //!< Conditional jump on the comparison, for counted loops
+			int step; //!< Induction variable step, for counted loops
+			int trips; //!< Trip count, or -1 if unknown
+			int factor; //!< Number of copies to make, for partial unrolling
+			std::set<const IR::Symbol*> locals; //!< Temporaries whose values do not outlive one iteration
+		};
+
+		bool planLoop(Analysis::Loops::Loop &loop, IR::Procedure &procedure, Analysis::Analysis &analysis, const Analysis::LiveVariables &liveVariables, Plan &plan);
+		int tripCount(const Plan &plan, const IR::Symbol *inductionVariable, const std::vector<IR::Entry*> &loopDefs, Analysis::Analysis &analysis);
+		void unrollFully(IR::Procedure &procedure, Plan &plan);
+		void unrollCounted(IR::Procedure &procedure, Plan &plan);
+		void unrollChained(IR::Procedure &procedure, Plan &plan);
+		void copyBody(IR::Procedure &procedure, Plan &plan, unsigned int begin, const IR::Entry *position, IR::EntryLabel *backTarget);
+		static int size(const std::vector<IR::Entry*> &entries, unsigned int begin);
+
+		int mFactor; //!< Number of copies made by partial unrolling
+	};
+}
+#endif
\ No newline at end of file
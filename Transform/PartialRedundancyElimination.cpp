@@ -0,0 +1,376 @@
+#include "Transform/PartialRedundancyElimination.h"
+
+#include "Analysis/DataFlow.h"
+
+#include "IR/Procedure.h"
+
+#include "Util/UniqueQueue.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace Transform {
+	/*!
+	 * \brief Compute the difference of two expression sets
+	 * \param a Set to subtract from
+	 * \param b Set to subtract
+	 * \return Expressions in a but not in b
+	 */
+	static std::set<int> difference(const std::set<int> &a, const std::set<int> &b)
+	{
+		std::set<int> result;
+		std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::inserter(result, result.end()));
+		return result;
+	}
+
+	/*!
+	 * \brief Compute the intersection of two expression sets
+	 * \param a First set
+	 * \param b Second set
+	 * \return Expressions in both a and b
+	 */
+	static std::set<int> intersection(const std::set<int> &a, const std::set<int> &b)
+	{
+		std::set<int> result;
+		std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::inserter(result, result.end()));
+		return result;
+	}
+
+	bool PartialRedundancyElimination::Expression::operator<(const Expression &other) const
+	{
+		if(type != other.type) return type < other.type;
+		if(rhs1 != other.rhs1) return rhs1 < other.rhs1;
+		if(rhs2 != other.rhs2) return rhs2 < other.rhs2;
+		if(imm != other.imm) return imm < other.imm;
+		if(size != other.size) return size < other.size;
+		if(region.kind != other.region.kind) return region.kind < other.region.kind;
+		return region.size < other.region.size;
+	}
+
+	bool PartialRedundancyElimination::transform(IR::Procedure &procedure, Analysis::Analysis &analysis)
+	{
+		const Analysis::FlowGraph &flowGraph = analysis.flowGraph();
+
+		// Number each distinct expression in the procedure, and record which expressions use
+		// each symbol
+		std::map<Expression, int> expressionMap;
+		std::vector<Expression> expressions;
+		std::vector<int> entryExpressions(procedure.numEntryIds(), -1);
+		std::map<const IR::Symbol*, std::set<int>> symbolExpressions;
+		std::map<int, const IR::Entry*> loads;
+		for(const IR::Entry *entry : procedure.entries()) {
+			if(!isExpression(entry)) {
+				continue;
+			}
+
+			const IR::EntryThreeAddr *threeAddr = (const IR::EntryThreeAddr*)entry;
+			Expression expression = { entry->type, threeAddr->rhs1, threeAddr->rhs2, threeAddr->imm, threeAddr->lhs->size, threeAddr->region };
+			auto it = expressionMap.find(expression);
+			if(it == expressionMap.end()) {
+				it = expressionMap.insert(std::make_pair(expression, (int)expressions.size())).first;
+				expressions.push_back(expression);
+				symbolExpressions[expression.rhs1].insert(it->second);
+				if(expression.rhs2) {
+					symbolExpressions[expression.rhs2].insert(it->second);
+				}
+				if(expression.type == IR::Entry::Type::LoadMem) {
+					loads[it->second] = entry;
+				}
+			}
+			entryExpressions[entry->id] = it->second;
+		}
+
+		if(expressions.empty()) {
+			return false;
+		}
+
+		std::set<int> all;
+		for(int i = 0; i < (int)expressions.size(); i++) {
+			all.insert(i);
+		}
+
+		// Construct gen/kill sets.  An entry kills every expression using a symbol it assigns.
+		// A call also kills every load, and a store kills the loads which it may alias, with the
+		// load's address evaluated at the store.  An expression is anticipated before an entry
+		// which computes it, but is only available after the entry if the entry does not also
+		// kill it
+		const Analysis::AliasAnalysis &aliasAnalysis = analysis.aliasAnalysis();
+		std::vector<std::set<int>> kill(procedure.numEntryIds());
+		std::vector<std::set<int>> antGen(procedure.numEntryIds());
+		std::vector<std::set<int>> avGen(procedure.numEntryIds());
+		for(const IR::Entry *entry : procedure.entries()) {
+			std::set<int> &k = kill[entry->id];
+			for(const IR::Symbol *symbol : entry->defOperands()) {
+				auto it = symbolExpressions.find(symbol);
+				if(it != symbolExpressions.end()) {
+					k.insert(it->second.begin(), it->second.end());
+				}
+			}
+
+			switch(entry->type) {
+				case IR::Entry::Type::StoreMem:
+					for(auto &load : loads) {
+						if(aliasAnalysis.mayAlias(entry, entry, load.second, entry)) {
+							k.insert(load.first);
+						}
+					}
+					break;
+
+				case IR::Entry::Type::Call:
+				case IR::Entry::Type::CallIndirect:
+					for(auto &load : loads) {
+						k.insert(load.first);
+					}
+					break;
+
+				default:
+					break;
+			}
+
+			int expression = entryExpressions[entry->id];
+			if(expression != -1) {
+				antGen[entry->id].insert(expression);
+				if(k.find(expression) == k.end()) {
+					avGen[entry->id].insert(expression);
+				}
+			}
+		}
+
+		Analysis::DataFlow<int> dataFlow;
+		std::vector<std::set<int>> anticipated = dataFlow.analyze(flowGraph, antGen, kill, all, Analysis::DataFlow<int>::Meet::Intersect, Analysis::DataFlow<int>::Direction::Backward);
+		std::vector<std::set<int>> available = dataFlow.analyze(flowGraph, avGen, kill, all, Analysis::DataFlow<int>::Meet::Intersect, Analysis::DataFlow<int>::Direction::Forward);
+
+		// Compute the local properties of each block.  Every block begins with a label, so the
+		// data flow sets at the front entry are those at the block's entry
+		std::map<const Analysis::FlowGraph::Block*, BlockInfo> info;
+		for(const std::unique_ptr<Analysis::FlowGraph::Block> &block : flowGraph.blocks()) {
+			BlockInfo &blockInfo = info[block.get()];
+			std::set<int> killed;
+			for(const IR::Entry *entry : block->entries) {
+				int expression = entryExpressions[entry->id];
+				if(expression != -1) {
+					if(killed.find(expression) == killed.end() && blockInfo.antloc.insert(expression).second) {
+						blockInfo.first[expression] = procedure.entries().entry(entry);
+					}
+					blockInfo.comp.insert(expression);
+					blockInfo.last[expression] = procedure.entries().entry(entry);
+				}
+
+				for(int k : kill[entry->id]) {
+					blockInfo.comp.erase(k);
+				}
+				killed.insert(kill[entry->id].begin(), kill[entry->id].end());
+			}
+
+			blockInfo.transp = difference(all, killed);
+			blockInfo.antin = anticipated[block->entries.front()->id];
+			blockInfo.antout = anticipated[block->entries.back()->id];
+
+			const IR::Entry *back = block->entries.back();
+			blockInfo.avout = avGen[back->id];
+			for(int expression : available[back->id]) {
+				if(kill[back->id].find(expression) == kill[back->id].end()) {
+					blockInfo.avout.insert(expression);
+				}
+			}
+		}
+
+		// Determine how far each insertion can be postponed.  This is a forward intersection
+		// problem on edges, starting from the earliest point at which each expression could
+		// be placed.  The start block is entered along an implicit edge on which every
+		// expression anticipated there is earliest.
+		Util::UniqueQueue<const Analysis::FlowGraph::Block*> queue;
+		for(const std::unique_ptr<Analysis::FlowGraph::Block> &block : flowGraph.blocks()) {
+			if(block.get() == flowGraph.start()) {
+				info[block.get()].laterin = info[block.get()].antin;
+			} else if(!block->pred.empty()) {
+				info[block.get()].laterin = all;
+			}
+			queue.push(block.get());
+		}
+
+		while(!queue.empty()) {
+			const Analysis::FlowGraph::Block *block = queue.front();
+			queue.pop();
+
+			if(block->pred.empty() && block != flowGraph.start()) {
+				continue;
+			}
+
+			std::set<int> laterin = (block == flowGraph.start()) ? info[block].antin : all;
+			for(const Analysis::FlowGraph::Block *pred : block->pred) {
+				laterin = intersection(laterin, later(pred, block, info));
+			}
+
+			if(laterin != info[block].laterin) {
+				info[block].laterin = laterin;
+				for(const Analysis::FlowGraph::Block *succ : block->succ) {
+					queue.push(succ);
+				}
+			}
+		}
+
+		// An expression computed in a block is deleted if its computation could not be
+		// postponed past the block's entry, in which case it is computed along every edge
+		// leading in
+		std::set<int> deleted;
+		for(auto &pair : info) {
+			std::set<int> del = difference(pair.second.antloc, pair.second.laterin);
+			deleted.insert(del.begin(), del.end());
+		}
+
+		if(deleted.empty()) {
+			return false;
+		}
+
+		std::map<int, IR::Symbol*> temps;
+		for(int expression : deleted) {
+			temps[expression] = procedure.newTemp(expressions[expression].size);
+		}
+
+		// Record the conditional jump ending each block before any edge is split, since splitting
+		// an edge places a new block after the jump, and the block's entry list then ends with
+		// the new block instead
+		std::map<const Analysis::FlowGraph::Block*, IR::EntryCJump*> cJumps;
+		for(const std::unique_ptr<Analysis::FlowGraph::Block> &block : flowGraph.blocks()) {
+			const IR::Entry *back = block->entries.back();
+			if(back->type == IR::Entry::Type::CJump) {
+				cJumps[block.get()] = (IR::EntryCJump*)procedure.entries().entry(back);
+			}
+		}
+
+		// Insert computations on the edges where they are needed.  An edge out of a block with
+		// one successor is placed at the end of that block, and an edge into a block with one
+		// predecessor is placed at its beginning.  Other edges are split.
+		for(const std::unique_ptr<Analysis::FlowGraph::Block> &block : flowGraph.blocks()) {
+			for(const Analysis::FlowGraph::Block *pred : block->pred) {
+				std::set<int> insert = intersection(difference(later(pred, block.get(), info), info[block.get()].laterin), deleted);
+				if(insert.empty()) {
+					continue;
+				}
+
+				const IR::Entry *position;
+				if(pred->succ.size() == 1) {
+					const IR::Entry *back = pred->entries.back();
+					if(back->type == IR::Entry::Type::Jump || back->type == IR::Entry::Type::CJump) {
+						position = back;
+					} else {
+						position = *pred->entries.end();
+					}
+				} else if(block->pred.size() == 1) {
+					IR::EntrySubList::const_iterator it = block->entries.begin();
+					it++;
+					position = *it;
+				} else {
+					position = Analysis::FlowGraph::splitEdge(procedure, cJumps[pred], block.get());
+				}
+
+				for(int expression : insert) {
+					const Expression &e = expressions[expression];
+					procedure.entries().insert(position, procedure.newEntry<IR::EntryThreeAddr>(e.type, temps[expression], e.rhs1, e.rhs2, e.imm, e.region));
+				}
+			}
+		}
+
+		// Replace the deleted computations with copies from the expression's temporary, and
+		// save the result of each remaining computation whose value may reach one of them
+		for(auto &pair : info) {
+			BlockInfo &blockInfo = pair.second;
+			std::set<IR::Entry*> replaced;
+			for(int expression : difference(blockInfo.antloc, blockInfo.laterin)) {
+				IR::Entry *entry = blockInfo.first[expression];
+				procedure.entries().insert(entry, procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::Move, entry->assign(), temps[expression]));
+				procedure.entries().erase(entry);
+				replaced.insert(entry);
+			}
+
+			for(int expression : intersection(blockInfo.comp, deleted)) {
+				IR::Entry *entry = blockInfo.last[expression];
+				if(replaced.find(entry) != replaced.end()) {
+					continue;
+				}
+
+				const Expression &e = expressions[expression];
+				procedure.entries().insert(entry, procedure.newEntry<IR::EntryThreeAddr>(e.type, temps[expression], e.rhs1, e.rhs2, e.imm, e.region));
+				procedure.entries().insert(entry, procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::Move, entry->assign(), temps[expression]));
+				procedure.entries().erase(entry);
+			}
+		}
+
+		analysis.invalidate();
+
+		return true;
+	}
+
+	/*!
+	 * \brief Check whether an entry computes an expression which can be moved
+	 * \param entry Entry to check
+	 * \return True if entry is an expression
+	 */
+	bool PartialRedundancyElimination::isExpression(const IR::Entry *entry)
+	{
+		switch(entry->type) {
+			case IR::Entry::Type::Add:
+			case IR::Entry::Type::Subtract:
+			case IR::Entry::Type::Mult:
+			case IR::Entry::Type::Divide:
+			case IR::Entry::Type::Modulo:
+			case IR::Entry::Type::Equal:
+			case IR::Entry::Type::Nequal:
+			case IR::Entry::Type::LessThan:
+			case IR::Entry::Type::LessThanE:
+			case IR::Entry::Type::GreaterThan:
+			case IR::Entry::Type::GreaterThanE:
+			case IR::Entry::Type::And:
+			case IR::Entry::Type::Or:
+			case IR::Entry::Type::LoadMem:
+				return true;
+
+			default:
+				return false;
+		}
+	}
+
+	/*!
+	 * \brief Compute the expressions which can be placed on an edge, but not any earlier
+	 *
+	 * An expression is earliest on an edge if it is anticipated at the edge's destination,
+	 * not available at its source, and could not have been placed any earlier in the source
+	 * block, either because the block changes its operands or because it is not anticipated
+	 * along every path out of the block.
+	 * \param pred Source block of edge
+	 * \param succ Destination block of edge
+	 * \param info Block information
+	 * \return Set of expressions
+	 */
+	std::set<int> PartialRedundancyElimination::earliest(const Analysis::FlowGraph::Block *pred, const Analysis::FlowGraph::Block *succ, std::map<const Analysis::FlowGraph::Block*, BlockInfo> &info)
+	{
+		BlockInfo &predInfo = info[pred];
+		return difference(difference(info[succ].antin, predInfo.avout), intersection(predInfo.transp, predInfo.antout));
+	}
+
+	/*!
+	 * \brief Compute the expressions whose placement can be postponed to an edge
+	 * \param pred Source block of edge
+	 * \param succ Destination block of edge
+	 * \param info Block information
+	 * \return Set of expressions
+	 */
+	std::set<int> PartialRedundancyElimination::later(const Analysis::FlowGraph::Block *pred, const Analysis::FlowGraph::Block *succ, std::map<const Analysis::FlowGraph::Block*, BlockInfo> &info)
+	{
+		std::set<int> result = earliest(pred, succ, info);
+		std::set<int> postponed = difference(info[pred].laterin, info[pred].antloc);
+		result.insert(postponed.begin(), postponed.end());
+		return result;
+	}
+
+	/*!
+	 * \brief Singleton
+	 * \return Instance
+	 */
+	PartialRedundancyElimination *PartialRedundancyElimination::instance()
+	{
+		static PartialRedundancyElimination inst;
+		return &inst;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,73 @@
+#ifndef TRANSFORM_PARTIAL_REDUNDANCY_ELIMINATION_H
+#define TRANSFORM_PARTIAL_REDUNDANCY_ELIMINATION_H
+
+#include "Transform/Transform.h"
+
+#include "Analysis/FlowGraph.h"
+
+#include <map>
+#include <set>
+#include <vector>
+
+namespace Transform {
+	/*!
+	 * \brief Eliminate partially redundant computations by lazy code motion
+	 *
+	 * An expression is partially redundant if it has already been computed along some, but
+	 * not all, paths leading to it.  Lazy code motion inserts computations of the expression
+	 * on the flow graph edges where it is missing, making the original computation fully
+	 * redundant.  Insertion points are chosen using anticipability and availability data
+	 * flow analyses, such that no path computes the expression more often than before, and
+	 * such that each computation is placed as late as possible to limit the lifetime of its
+	 * result.  Lazy code motion never speculates, so it does not hoist a computation out of
+	 * a loop which tests its condition at the header, since the computation is not made
+	 * on the path which exits the loop without entering the body.  LoopInvariantCodeMotion
+	 * handles those cases.
+	 *
+	 * Each expression whose computations are moved is given a temporary, which every
+	 * remaining computation also writes, and the deleted computations are replaced by
+	 * copies from it.  Critical edges are split where an insertion is needed on them.
+	 */
+	class PartialRedundancyElimination : public Transform {
+	public:
+		virtual bool transform(IR::Procedure &procedure, Analysis::Analysis &analysis);
+		virtual std::string name() { return "PartialRedundancyElimination"; }
+
+		static PartialRedundancyElimination *instance();
+
+	private:
+		/*!
+		 * \brief A lexical expression
+		 */
+		struct Expression {
+			IR::Entry::Type type; //!< Operation
+			const IR::Symbol *rhs1; //!< First operand
+			const IR::Symbol *rhs2; //!< Second operand, or null
+			int imm; //!< Immediate operand
+			int size; //!< Size of result
+			IR::MemoryRegion region; //!< Memory accessed, for loads
+
+			bool operator<(const Expression &other) const;
+		};
+
+		/*!
+		 * \brief Local properties of a block, and the data flow results at its boundaries
+		 */
+		struct BlockInfo {
+			std::set<int> antloc; //!< Expressions computed in the block before their operands change
+			std::set<int> comp; //!< Expressions computed in the block after their operands last change
+			std::set<int> transp; //!< Expressions whose operands the block does not change
+			std::set<int> antin; //!< Expressions anticipated at the block's entry
+			std::set<int> antout; //!< Expressions anticipated at the block's exit
+			std::set<int> avout; //!< Expressions available at the block's exit
+			std::set<int> laterin; //!< Expressions whose insertion can be postponed past the block's entry
+			std::map<int, IR::Entry*> first; //!< First computation of each expression in antloc
+			std::map<int, IR::Entry*> last; //!< Last computation of each expression in comp
+		};
+
+		bool isExpression(const IR::Entry *entry);
+		std::set<int> earliest(const Analysis::FlowGraph::Block *pred, const Analysis::FlowGraph::Block *succ, std::map<const Analysis::FlowGraph::Block*, BlockInfo> &info);
+		std::set<int> later(const Analysis::FlowGraph::Block *pred, const Analysis::FlowGraph::Block *succ, std::map<const Analysis::FlowGraph::Block*, BlockInfo> &info);
+	};
+}
+#endif
\ No newline at end of file
@@ -31,7 +31,7 @@ namespace Transform {
 
 	bool SSA::transform(IR::Procedure &proc, Analysis::Analysis &analysis)
 	{
-		std::vector<std::unique_ptr<IR::Symbol>> newSymbols;
+		std::vector<IR::Symbol*> newSymbols;
 
 		// Perform flow graph and dominance analysis on the procedure
 		const Analysis::FlowGraph &flowGraph = analysis.flowGraph();
@@ -39,13 +39,13 @@ namespace Transform {
 		Analysis::DominanceFrontiers dominanceFrontiers(dominatorTree);
 
 		// Iterate through the list of symbols in the procedure
-		for(std::unique_ptr<IR::Symbol> &symbol : proc.symbols()) {
+		for(IR::Symbol *symbol : proc.symbols()) {
 			Util::UniqueQueue<const Analysis::FlowGraph::Block*> blocks;
 
 			// Initialize queue with variable assignments
 			for(const std::unique_ptr<Analysis::FlowGraph::Block> &block : flowGraph.blocks()) {
 				for(const IR::Entry *entry : block->entries) {
-					if(entry->assign() == symbol.get()) {
+					if(entry->assign() == symbol) {
 						blocks.push(block.get());
 					}
 				}
@@ -59,8 +59,8 @@ namespace Transform {
 				for(const Analysis::FlowGraph::Block *frontier : dominanceFrontiers.frontiers(block)) {
 					const IR::Entry *head = *(frontier->entries.begin()++);
 
-					if(head->type != IR::Entry::Type::Phi || ((IR::EntryPhi*)head)->lhs != symbol.get()) {
-						proc.entries().insert(head, new IR::EntryPhi(symbol.get(), symbol.get(), (int)frontier->pred.size()));
+					if(head->type != IR::Entry::Type::Phi || ((IR::EntryPhi*)head)->lhs != symbol) {
+						proc.entries().insert(head, proc.newEntry<IR::EntryPhi>(symbol, symbol, (int)frontier->pred.size(), proc.arena()));
 						blocks.push(frontier);
 					}
 				}
@@ -69,9 +69,9 @@ namespace Transform {
 			// Rename variables
 			int nextVersion = 0;
 			std::map<const Analysis::FlowGraph::Block*, IR::Symbol*> activeList;
-			std::unique_ptr<IR::Symbol> newSymbol = std::make_unique<IR::Symbol>(newSymbolName(symbol.get(), nextVersion++), symbol->size, symbol->symbol);
-			activeList[flowGraph.start()] = newSymbol.get();
-			newSymbols.push_back(std::move(newSymbol));
+			IR::Symbol *newSymbol = proc.newSymbol(newSymbolName(symbol, nextVersion++), symbol->size, symbol->symbol);
+			activeList[flowGraph.start()] = newSymbol;
+			newSymbols.push_back(newSymbol);
 			for(const std::unique_ptr<Analysis::FlowGraph::Block> &block : flowGraph.blocks()) {
 				if(activeList.find(block.get()) == activeList.end())
 					activeList[block.get()] = activeList[dominatorTree.idom(block.get())];
@@ -79,17 +79,17 @@ namespace Transform {
 
 				for(const IR::Entry *constEntry : block->entries) {
 					IR::Entry *entry = proc.entries().entry(constEntry);
-					if(entry->uses(symbol.get())) {
-						entry->replaceUse(symbol.get(), active);
+					if(entry->uses(symbol)) {
+						entry->replaceUse(symbol, active);
 					}
 
 					// Create a new version of the variable for each assignment
-					if(entry->assign() == symbol.get()) {
-						std::unique_ptr<IR::Symbol> newSymbol = std::make_unique<IR::Symbol>(newSymbolName(symbol.get(), nextVersion++), symbol->size, symbol->symbol);
-						entry->replaceAssign(active, newSymbol.get());
-						active = newSymbol.get();
+					if(entry->assign() == symbol) {
+						IR::Symbol *newSymbol = proc.newSymbol(newSymbolName(symbol, nextVersion++), symbol->size, symbol->symbol);
+						entry->replaceAssign(active, newSymbol);
+						active = newSymbol;
 						activeList[block.get()] = active;
-						newSymbols.push_back(std::move(newSymbol));
+						newSymbols.push_back(newSymbol);
 					}
 				}
 
@@ -97,7 +97,7 @@ namespace Transform {
 				for(const Analysis::FlowGraph::Block *succ : block->succ) {
 					const IR::Entry *head = *(succ->entries.begin()++);
 
-					if(head->type == IR::Entry::Type::Phi && ((IR::EntryPhi*)head)->base == symbol.get()) {
+					if(head->type == IR::Entry::Type::Phi && ((IR::EntryPhi*)head)->base == symbol) {
 						int l = 0;
 						for(const Analysis::FlowGraph::Block *pred : succ->pred) {
 							if(pred == block.get()) {
@@ -112,8 +112,8 @@ namespace Transform {
 		}
 
 		// Add newly-created symbols into symbol table
-		for(std::unique_ptr<IR::Symbol> &symbol : newSymbols) {
-			proc.addSymbol(std::move(symbol));
+		for(IR::Symbol *symbol : newSymbols) {
+			proc.addSymbol(symbol);
 		}
 
 		analysis.invalidate();
@@ -0,0 +1,126 @@
+#include "Transform/StrengthReduction.h"
+#include "Transform/LoopInvariantCodeMotion.h"
+
+#include "Analysis/InductionVariables.h"
+
+#include "IR/Procedure.h"
+
+namespace Transform {
+	bool StrengthReduction::transform(IR::Procedure &procedure, Analysis::Analysis &analysis)
+	{
+		bool changed = false;
+
+		// Rebuild the loop analysis after each loop is transformed, since new entries are
+		// added to the flow graph
+		while(true) {
+			Analysis::Loops loops(procedure, analysis.flowGraph());
+			if(!processLoop(*loops.rootLoop(), procedure, loops, analysis)) {
+				break;
+			}
+
+			analysis.invalidate();
+			changed = true;
+		}
+
+		return changed;
+	}
+
+	/*!
+	 * \brief Recursively analyze and transform a loop and its descendents
+	 * \param loop Loop to transform
+	 * \param procedure Procedure that contains the loop
+	 * \param loops Loop analysis of the procedure
+	 * \param analysis Analysis of the procedure
+	 * \return True if a loop was transformed
+	 */
+	bool StrengthReduction::processLoop(Analysis::Loops::Loop &loop, IR::Procedure &procedure, Analysis::Loops &loops, Analysis::Analysis &analysis)
+	{
+		// Process all child loops recursively, stopping as soon as one is transformed
+		for(Analysis::Loops::Loop *child : loop.children) {
+			if(processLoop(*child, procedure, loops, analysis)) {
+				return true;
+			}
+		}
+
+		if(&loop == loops.rootLoop() || !loop.preheader) {
+			return false;
+		}
+
+		Analysis::InductionVariables inductionVariables(loop);
+
+		// Derived variables with the same basis and scale can share a reduced variable
+		std::map<std::pair<const IR::Symbol*, int>, IR::Symbol*> reduced;
+		std::vector<std::pair<IR::Entry*, IR::Symbol*>> replacements;
+
+		for(const Analysis::InductionVariables::DerivedVariable &derived : inductionVariables.derivedVariables()) {
+			if(derived.entry->type != IR::Entry::Type::Mult || isScaledIndex(derived.entry, analysis)) {
+				continue;
+			}
+
+			// The new variable's step must fit in an immediate operand
+			const Analysis::InductionVariables::BasicVariable &basic = *derived.basic;
+			long step = (long)basic.step * derived.scale;
+			if(step < MinStep || step > MaxStep) {
+				continue;
+			}
+
+			IR::Symbol *&symbol = reduced[std::make_pair(basic.symbol, derived.scale)];
+			if(!symbol) {
+				// Initialize the new variable before the loop, and advance it in step with the
+				// basic variable so that it always holds the product
+				symbol = procedure.newTemp(basic.symbol->size);
+				LoopInvariantCodeMotion::addToPreheader(procedure, loop, procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::Mult, symbol, basic.symbol, nullptr, derived.scale));
+
+				IR::Entry *increment = procedure.entries().entry(basic.increment);
+				procedure.entries().insert(increment->next, procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::Add, symbol, symbol, nullptr, step));
+			}
+
+			replacements.push_back(std::make_pair(procedure.entries().entry(derived.entry), symbol));
+		}
+
+		// Replace each multiplication with a copy of its reduced variable
+		for(auto &replacement : replacements) {
+			IR::Entry *entry = replacement.first;
+			procedure.entries().insert(entry, procedure.newEntry<IR::EntryThreeAddr>(IR::Entry::Type::Move, entry->assign(), replacement.second));
+			procedure.entries().erase(entry);
+		}
+
+		return replacements.size() > 0;
+	}
+
+	/*!
+	 * \brief Check whether a multiplication is only used as a memory index
+	 *
+	 * Multiplications by a power of two which feed memory accesses are folded into the scaled
+	 * addressing mode of those accesses, so reducing them would only add instructions.
+	 * \param entry Multiplication entry
+	 * \param analysis Analysis of the procedure
+	 * \return True if the multiplication will be folded into an addressing mode
+	 */
+	bool StrengthReduction::isScaledIndex(const IR::Entry *entry, Analysis::Analysis &analysis)
+	{
+		int scale = ((const IR::EntryThreeAddr*)entry)->imm;
+		if(scale <= 0 || (scale & (scale - 1)) != 0) {
+			return false;
+		}
+
+		for(const IR::Entry *use : analysis.useDefs().uses(entry)) {
+			const IR::EntryThreeAddr *threeAddr = (const IR::EntryThreeAddr*)use;
+			if((use->type != IR::Entry::Type::LoadMem && use->type != IR::Entry::Type::StoreMem) || threeAddr->rhs2 != entry->assign() || threeAddr->lhs == entry->assign() || threeAddr->rhs1 == entry->assign()) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	/*!
+	 * \brief Singleton
+	 * \return Instance
+	 */
+	StrengthReduction *StrengthReduction::instance()
+	{
+		static StrengthReduction inst;
+		return &inst;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,32 @@
+#ifndef TRANSFORM_STRENGTH_REDUCTION_H
+#define TRANSFORM_STRENGTH_REDUCTION_H
+
+#include "Transform/Transform.h"
+
+#include "Analysis/Loops.h"
+
+namespace Transform {
+	/*!
+	 * \brief Perform strength reduction on the induction variables of each loop
+	 *
+	 * A derived induction variable computed by multiplying a basic induction variable by a
+	 * constant is replaced by a new variable, initialized in the loop preheader and advanced
+	 * by a constant each time the basic variable is incremented, turning the multiplication
+	 * inside the loop into an addition.
+	 */
+	class StrengthReduction : public Transform {
+	public:
+		virtual bool transform(IR::Procedure &procedure, Analysis::Analysis &analysis);
+		virtual std::string name() { return "StrengthReduction"; }
+
+		static StrengthReduction *instance();
+
+		static const long MinStep = -0x8000; //!< Smallest step which fits in an immediate operand
+		static const long MaxStep = 0x7fff; //!< Largest step which fits in an immediate operand
+
+	private:
+		bool processLoop(Analysis::Loops::Loop &loop, IR::Procedure &procedure, Analysis::Loops &loops, Analysis::Analysis &analysis);
+		bool isScaledIndex(const IR::Entry *entry, Analysis::Analysis &analysis);
+	};
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,108 @@
+#ifndef UTIL_ARENA_H
+#define UTIL_ARENA_H
+
+#include <vector>
+#include <memory>
+#include <new>
+#include <utility>
+#include <type_traits>
+#include <cstddef>
+#include <cstdint>
+
+namespace Util {
+	/*!
+	 * \brief Bump-pointer allocator for objects that share a single lifetime
+	 *
+	 * Objects are carved sequentially out of large blocks, so that objects created
+	 * together are also adjacent in memory.  Individual objects are never freed;
+	 * instead, every object is destroyed and all blocks released at once when the
+	 * arena itself is destroyed.
+	 */
+	class Arena {
+	public:
+		Arena() : mCursor(0), mRemaining(0) {}
+		Arena(const Arena &) = delete;
+		Arena &operator=(const Arena &) = delete;
+
+		/*!
+		 * \brief Destructor.  Destroys all objects in reverse order of creation
+		 */
+		~Arena()
+		{
+			for(auto it = mDestructors.rbegin(); it != mDestructors.rend(); it++) {
+				it->destroy(it->object);
+			}
+		}
+
+		/*!
+		 * \brief Construct a new object in the arena
+		 * \param args Constructor arguments
+		 * \return New object
+		 */
+		template<typename T, typename... Args>
+		T *create(Args&&... args)
+		{
+			T *object = new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+			if(!std::is_trivially_destructible<T>::value) {
+				mDestructors.push_back(Destructor{object, [](void *p) { static_cast<T*>(p)->~T(); }});
+			}
+
+			return object;
+		}
+
+		/*!
+		 * \brief Allocate a value-initialized array in the arena
+		 * \param count Number of elements
+		 * \return Array
+		 */
+		template<typename T>
+		T *createArray(size_t count)
+		{
+			static_assert(std::is_trivially_destructible<T>::value, "Arena arrays must be trivially destructible");
+			T *array = static_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+			for(size_t i=0; i<count; i++) {
+				new (&array[i]) T();
+			}
+
+			return array;
+		}
+
+	private:
+		static const size_t BlockSize = 16384; //!< Size of each allocation block
+
+		struct Destructor {
+			void *object;
+			void (*destroy)(void*);
+		};
+
+		/*!
+		 * \brief Reserve raw memory from the current block, starting a new block if necessary
+		 * \param size Number of bytes
+		 * \param align Required alignment
+		 * \return Memory
+		 */
+		void *allocate(size_t size, size_t align)
+		{
+			size_t padding = (align - reinterpret_cast<uintptr_t>(mCursor) % align) % align;
+			if(padding + size > mRemaining) {
+				size_t blockSize = (size + align > BlockSize) ? size + align : BlockSize;
+				mBlocks.push_back(std::make_unique<unsigned char[]>(blockSize));
+				mCursor = mBlocks.back().get();
+				mRemaining = blockSize;
+				padding = (align - reinterpret_cast<uintptr_t>(mCursor) % align) % align;
+			}
+
+			void *result = mCursor + padding;
+			mCursor += padding + size;
+			mRemaining -= padding + size;
+
+			return result;
+		}
+
+		std::vector<std::unique_ptr<unsigned char[]>> mBlocks; //!< Allocated blocks
+		std::vector<Destructor> mDestructors; //!< Destructors to run on arena destruction
+		unsigned char *mCursor; //!< Next free byte in current block
+		size_t mRemaining; //!< Bytes remaining in current block
+	};
+}
+#endif
@@ -0,0 +1,51 @@
+#ifndef UTIL_ENDIAN_H
+#define UTIL_ENDIAN_H
+
+#include <cstdint>
+
+namespace Util {
+	/*!
+	 * \brief Read a 32-bit little-endian value
+	 * \param data Location of value
+	 * \return Value
+	 */
+	inline uint32_t readLittleEndian32(const unsigned char *data)
+	{
+		return (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+	}
+
+	/*!
+	 * \brief Read a 64-bit little-endian value
+	 * \param data Location of value
+	 * \return Value
+	 */
+	inline uint64_t readLittleEndian64(const unsigned char *data)
+	{
+		return (uint64_t)readLittleEndian32(data) | ((uint64_t)readLittleEndian32(data + 4) << 32);
+	}
+
+	/*!
+	 * \brief Write a 32-bit value in little-endian order
+	 * \param data Location to write to
+	 * \param value Value to write
+	 */
+	inline void writeLittleEndian32(unsigned char *data, uint32_t value)
+	{
+		for(int i=0; i<4; i++) {
+			data[i] = (unsigned char)(value >> (i * 8));
+		}
+	}
+
+	/*!
+	 * \brief Write a 64-bit value in little-endian order
+	 * \param data Location to write to
+	 * \param value Value to write
+	 */
+	inline void writeLittleEndian64(unsigned char *data, uint64_t value)
+	{
+		writeLittleEndian32(data, (uint32_t)value);
+		writeLittleEndian32(data + 4, (uint32_t)(value >> 32));
+	}
+}
+
+#endif
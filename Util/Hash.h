@@ -0,0 +1,75 @@
+#ifndef UTIL_HASH_H
+#define UTIL_HASH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace Util {
+	/*!
+	 * \brief Incremental 64-bit FNV-1a hash
+	 *
+	 * Unlike std::hash, the result depends only on the bytes hashed, so it is
+	 * stable across runs and builds and can be stored in files.
+	 */
+	class Hash {
+	public:
+		Hash() : mValue(OffsetBasis) {}
+
+		/*!
+		 * \brief Add a block of bytes to the hash
+		 * \param data Bytes to add
+		 * \param size Number of bytes
+		 */
+		void add(const void *data, size_t size)
+		{
+			const unsigned char *bytes = (const unsigned char*)data;
+			for(size_t i=0; i<size; i++) {
+				mValue = (mValue ^ bytes[i]) * Prime;
+			}
+		}
+
+		/*!
+		 * \brief Add a string to the hash, along with its length so that adjacent strings cannot run together
+		 * \param str String to add
+		 */
+		void add(std::string_view str)
+		{
+			addValue(str.size());
+			add(str.data(), str.size());
+		}
+
+		/*!
+		 * \brief Add a byte array to the hash, along with its length
+		 * \param data Bytes to add
+		 */
+		void add(const std::vector<unsigned char> &data)
+		{
+			addValue(data.size());
+			add(data.data(), data.size());
+		}
+
+		/*!
+		 * \brief Add an integer value to the hash
+		 * \param value Value to add
+		 */
+		void addValue(uint64_t value)
+		{
+			for(int i=0; i<8; i++) {
+				unsigned char byte = (unsigned char)(value >> (i * 8));
+				add(&byte, 1);
+			}
+		}
+
+		uint64_t value() const { return mValue; } //!< Hash of all data added so far
+
+	private:
+		static const uint64_t OffsetBasis = 0xcbf29ce484222325ull; //!< FNV offset basis
+		static const uint64_t Prime = 0x100000001b3ull; //!< FNV prime
+
+		uint64_t mValue; //!< Current hash value
+	};
+}
+
+#endif
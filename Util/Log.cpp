@@ -10,17 +10,44 @@ std::vector<std::string> enabledLogs = {
 	"output"
 };
 
-std::ofstream nullstream;
+thread_local std::ofstream nullstream;
+thread_local std::ostream *captureStream = 0;
 
-std::ostream &log(const std::string &name)
+bool logEnabled(const std::string &name)
 {
 	for(std::string &log : enabledLogs) {
 		if(log == name) {
-			return std::cout;
+			return true;
 		}
 	}
 
+	return false;
+}
+
+std::ostream &log(const std::string &name)
+{
+	if(logEnabled(name)) {
+		return captureStream ? *captureStream : std::cout;
+	}
+
 	return nullstream;
 }
 
+/*!
+ * \brief Constructor, begins capturing log output on the current thread
+ */
+LogCapture::LogCapture()
+{
+	mPrevious = captureStream;
+	captureStream = &mStream;
+}
+
+/*!
+ * \brief Destructor, restores the previous log destination
+ */
+LogCapture::~LogCapture()
+{
+	captureStream = mPrevious;
+}
+
 }
\ No newline at end of file
@@ -2,11 +2,31 @@
 #define UTIL_LOG_H
 
 #include <iostream>
+#include <sstream>
 #include <string>
 
 namespace Util {
 
 std::ostream &log(const std::string &name);
+bool logEnabled(const std::string &name);
+
+/*!
+ * \brief Collects the log output of the current thread while in scope
+ *
+ * Used when work runs concurrently, so that each task's log can be written out
+ * as a unit once it completes, rather than interleaved with other tasks.
+ */
+class LogCapture {
+public:
+	LogCapture();
+	~LogCapture();
+
+	std::string str() const { return mStream.str(); } //!< Log output captured so far
+
+private:
+	std::stringstream mStream; //!< Captured output
+	std::ostream *mPrevious; //!< Capture stream active when this capture began
+};
 
 }
-#endif
\ No newline at end of file
+#endif
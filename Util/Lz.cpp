@@ -0,0 +1,166 @@
+#include "Util/Lz.h"
+
+#include "Util/Endian.h"
+
+#include <cstring>
+
+namespace Util {
+	/*!
+	 * \brief Write the extension bytes of a length whose token nibble is 15
+	 * \param output Output buffer
+	 * \param length Remaining length, after subtracting 15
+	 */
+	void Lz::writeLength(std::vector<unsigned char> &output, size_t length)
+	{
+		while(length >= 255) {
+			output.push_back(255);
+			length -= 255;
+		}
+		output.push_back((unsigned char)length);
+	}
+
+	/*!
+	 * \brief Read the extension bytes of a length whose token nibble is 15
+	 * \param data Compressed data
+	 * \param position Position to read from, advanced past the extension
+	 * \param length Length to add the extension to
+	 * \return True if success, false if the data ended first
+	 */
+	bool Lz::readLength(std::span<const unsigned char> data, size_t &position, size_t &length)
+	{
+		while(true) {
+			if(position >= data.size()) {
+				return false;
+			}
+
+			unsigned char byte = data[position++];
+			length += byte;
+			if(byte < 255) {
+				return true;
+			}
+		}
+	}
+
+	/*!
+	 * \brief Write a sequence to the compressed output
+	 * \param output Output buffer
+	 * \param literals Literal bytes
+	 * \param distance Distance back to match, ignored for the final sequence
+	 * \param matchLength Length of match, or 0 for the final sequence
+	 */
+	void Lz::writeSequence(std::vector<unsigned char> &output, std::span<const unsigned char> literals, size_t distance, size_t matchLength)
+	{
+		size_t matchCode = matchLength > 0 ? matchLength - MinMatch : 0;
+		unsigned char token = (unsigned char)(((literals.size() < 15 ? literals.size() : 15) << 4) | (matchCode < 15 ? matchCode : 15));
+		output.push_back(token);
+		if(literals.size() >= 15) {
+			writeLength(output, literals.size() - 15);
+		}
+		output.insert(output.end(), literals.begin(), literals.end());
+
+		if(matchLength > 0) {
+			output.push_back((unsigned char)distance);
+			output.push_back((unsigned char)(distance >> 8));
+			if(matchCode >= 15) {
+				writeLength(output, matchCode - 15);
+			}
+		}
+	}
+
+	/*!
+	 * \brief Compress a block of data
+	 * \param data Data to compress
+	 * \return Compressed data
+	 */
+	std::vector<unsigned char> Lz::compress(std::span<const unsigned char> data)
+	{
+		std::vector<unsigned char> output;
+		std::vector<int> table(1 << HashBits, -1);
+
+		size_t anchor = 0;
+		size_t position = 0;
+		while(position + MinMatch <= data.size()) {
+			// Look up the last position at which the next MinMatch bytes were seen
+			uint32_t sequence = readLittleEndian32(&data[position]);
+			uint32_t hash = (sequence * 2654435761u) >> (32 - HashBits);
+			int candidate = table[hash];
+			table[hash] = (int)position;
+
+			if(candidate < 0 || position - candidate > MaxDistance || std::memcmp(&data[candidate], &data[position], MinMatch) != 0) {
+				position++;
+				continue;
+			}
+
+			size_t length = MinMatch;
+			while(position + length < data.size() && data[candidate + length] == data[position + length]) {
+				length++;
+			}
+
+			writeSequence(output, data.subspan(anchor, position - anchor), position - candidate, length);
+			position += length;
+			anchor = position;
+		}
+
+		writeSequence(output, data.subspan(anchor), 0, 0);
+
+		return output;
+	}
+
+	/*!
+	 * \brief Decompress a block of data
+	 * \param data Compressed data
+	 * \param size Size of the original data
+	 * \param output Buffer to receive decompressed data
+	 * \return True if success, false if the data was malformed
+	 */
+	bool Lz::decompress(std::span<const unsigned char> data, size_t size, std::vector<unsigned char> &output)
+	{
+		output.clear();
+		output.reserve(size);
+
+		size_t position = 0;
+		while(position < data.size()) {
+			unsigned char token = data[position++];
+
+			size_t literalLength = token >> 4;
+			if(literalLength == 15 && !readLength(data, position, literalLength)) {
+				return false;
+			}
+
+			if(literalLength > data.size() - position || literalLength > size - output.size()) {
+				return false;
+			}
+			output.insert(output.end(), data.begin() + position, data.begin() + position + literalLength);
+			position += literalLength;
+
+			// The final sequence ends after its literals
+			if(position == data.size()) {
+				break;
+			}
+
+			if(data.size() - position < 2) {
+				return false;
+			}
+			size_t distance = data[position] | (data[position + 1] << 8);
+			position += 2;
+
+			size_t matchLength = token & 0xf;
+			if(matchLength == 15 && !readLength(data, position, matchLength)) {
+				return false;
+			}
+			matchLength += MinMatch;
+
+			if(distance == 0 || distance > output.size() || matchLength > size - output.size()) {
+				return false;
+			}
+
+			// Copy byte by byte, since the match may overlap the bytes it produces
+			size_t start = output.size() - distance;
+			for(size_t i=0; i<matchLength; i++) {
+				output.push_back(output[start + i]);
+			}
+		}
+
+		return output.size() == size;
+	}
+}
@@ -0,0 +1,35 @@
+#ifndef UTIL_LZ_H
+#define UTIL_LZ_H
+
+#include <span>
+#include <vector>
+
+namespace Util {
+	/*!
+	 * \brief Simple LZ77-style compressor
+	 *
+	 * Compressed data is a series of sequences, each consisting of a run of
+	 * literal bytes followed by a match: a copy of earlier output, given as a
+	 * distance back and a length.  A sequence begins with a token byte whose high
+	 * nibble is the literal count and whose low nibble is the match length less
+	 * MinMatch; a nibble of 15 is extended by following bytes, each added to it,
+	 * until a byte less than 255.  Distances are 16-bit little-endian values.
+	 * The final sequence contains literals only.
+	 */
+	class Lz {
+	public:
+		static std::vector<unsigned char> compress(std::span<const unsigned char> data);
+		static bool decompress(std::span<const unsigned char> data, size_t size, std::vector<unsigned char> &output);
+
+	private:
+		static const int MinMatch = 4; //!< Shortest match which is encoded
+		static const int MaxDistance = 0xffff; //!< Furthest back a match may start
+		static const int HashBits = 12; //!< Size of the match-finding hash table, as a power of 2
+
+		static void writeLength(std::vector<unsigned char> &output, size_t length);
+		static bool readLength(std::span<const unsigned char> data, size_t &position, size_t &length);
+		static void writeSequence(std::vector<unsigned char> &output, std::span<const unsigned char> literals, size_t distance, size_t matchLength);
+	};
+}
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef VM_ADDRESS_INDEX_H
+#define VM_ADDRESS_INDEX_H
+
+#include "VM/Program.h"
+
+#include <algorithm>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace VM {
+	/*!
+	 * \brief Index of a program's symbols by code offset
+	 *
+	 * Symbols are sorted by offset, and then by name, so that finding the symbol
+	 * at an address is a binary search.  Where several symbols
+	 * share an offset, the first by name is reported.  Names are views into the
+	 * program, so the program must outlive the index.
+	 */
+	class AddressIndex {
+	public:
+		/*!
+		 * \brief Constructor
+		 * \param program Program to index
+		 */
+		AddressIndex(const Program &program)
+		{
+			program.forEachSymbol([&](std::string_view name, int offset) {
+				mEntries.push_back(std::make_pair((unsigned int)offset, name));
+			});
+			std::sort(mEntries.begin(), mEntries.end());
+		}
+
+		/*!
+		 * \brief Find the symbol at an address
+		 * \param address Code offset
+		 * \return Name of symbol, or empty if no symbol starts at the address
+		 */
+		std::string_view find(unsigned int address) const
+		{
+			auto it = std::lower_bound(mEntries.begin(), mEntries.end(), std::make_pair(address, std::string_view()));
+			if(it != mEntries.end() && it->first == address) {
+				return it->second;
+			}
+
+			return std::string_view();
+		}
+
+	private:
+		std::vector<std::pair<unsigned int, std::string_view>> mEntries; //!< Offset and name of each symbol, sorted
+	};
+}
+
+#endif
@@ -6,6 +6,9 @@
 
 #include "Linker.h"
 
+#include "Util/Log.h"
+
+#include <cstring>
 #include <sstream>
 
 namespace VM {
@@ -49,7 +52,8 @@ namespace VM {
 		Heap heap(addressSpace, HeapStart, HeapSize);
 		GarbageCollector collector(heap);
 
-		if(program.symbols.find("main") == program.symbols.end()) {
+		int mainOffset;
+		if(!program.findSymbol("main", mainOffset)) {
 			std::cerr << "Error: Undefined reference to main" << std::endl;
 			return;
 		}
@@ -86,8 +90,9 @@ namespace VM {
 		memset(regs, 0, 16 * sizeof(int));
 
 		const unsigned int CodeStart = 0;
-		addressSpace.addRegion(CodeStart, (unsigned int)linked->instructions.size());
-		std::memcpy(addressSpace.at(CodeStart), &linked->instructions[0], linked->instructions.size());
+		std::span<const unsigned char> code = linked->code();
+		addressSpace.addRegion(CodeStart, (unsigned int)code.size());
+		std::memcpy(addressSpace.at(CodeStart), code.data(), code.size());
 
 		const unsigned int StackStart = 0x10000;
 		const unsigned int StackSize = 0x100;
@@ -99,11 +104,14 @@ namespace VM {
 		regs[VM::RegLR] = 0xffffffff;
 
 		// Set PC to the program entry point
-		regs[VM::RegPC] = linked->symbols.find("main")->second + CodeStart;
+		linked->findSymbol("main", mainOffset);
+		regs[VM::RegPC] = mainOffset + CodeStart;
 
 		// Loop until PC is set beyond the end of the program
+		unsigned long instructionCount = 0;
 		while(regs[VM::RegPC] != 0xffffffff) {
 			curPC = regs[VM::RegPC];
+			instructionCount++;
 			Instruction instr;
 			std::memcpy(&instr, addressSpace.at(regs[VM::RegPC]), 4);
 
@@ -286,5 +294,7 @@ namespace VM {
 				regs[VM::RegPC] += 4;
 			}
 		}
+
+		Util::log("stats") << "Executed " << instructionCount << " instructions" << std::endl;
 	}
 }
\ No newline at end of file
@@ -0,0 +1,97 @@
+#include "VM/MappedFile.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace VM {
+
+#ifdef _WIN32
+/*!
+ * \brief Constructor
+ * \param filename File to map
+ */
+MappedFile::MappedFile(const std::string &filename)
+	: mData(0), mSize(0), mFileHandle(INVALID_HANDLE_VALUE), mMappingHandle(0)
+{
+	mFileHandle = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+	if(mFileHandle == INVALID_HANDLE_VALUE) {
+		return;
+	}
+
+	LARGE_INTEGER size;
+	if(!GetFileSizeEx(mFileHandle, &size) || size.QuadPart == 0) {
+		return;
+	}
+
+	mMappingHandle = CreateFileMappingA(mFileHandle, 0, PAGE_READONLY, 0, 0, 0);
+	if(!mMappingHandle) {
+		return;
+	}
+
+	mData = (const unsigned char*)MapViewOfFile(mMappingHandle, FILE_MAP_READ, 0, 0, 0);
+	if(mData) {
+		mSize = (size_t)size.QuadPart;
+	}
+}
+
+/*!
+ * \brief Destructor
+ */
+MappedFile::~MappedFile()
+{
+	if(mData) {
+		UnmapViewOfFile(mData);
+	}
+
+	if(mMappingHandle) {
+		CloseHandle(mMappingHandle);
+	}
+
+	if(mFileHandle != INVALID_HANDLE_VALUE) {
+		CloseHandle(mFileHandle);
+	}
+}
+#else
+/*!
+ * \brief Constructor
+ * \param filename File to map
+ */
+MappedFile::MappedFile(const std::string &filename)
+	: mData(0), mSize(0)
+{
+	int fd = open(filename.c_str(), O_RDONLY);
+	if(fd == -1) {
+		return;
+	}
+
+	// The mapping remains valid once the descriptor is closed
+	struct stat status;
+	if(fstat(fd, &status) == 0 && status.st_size > 0) {
+		void *data = mmap(0, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if(data != MAP_FAILED) {
+			mData = (const unsigned char*)data;
+			mSize = (size_t)status.st_size;
+		}
+	}
+
+	close(fd);
+}
+
+/*!
+ * \brief Destructor
+ */
+MappedFile::~MappedFile()
+{
+	if(mData) {
+		munmap((void*)mData, mSize);
+	}
+}
+#endif
+
+}
@@ -0,0 +1,35 @@
+#ifndef VM_MAPPED_FILE_H
+#define VM_MAPPED_FILE_H
+
+#include <span>
+#include <string>
+
+namespace VM {
+/*!
+ * \brief A file mapped read-only into memory
+ *
+ * Pages of the file are only read from disk when they are first touched, so
+ * the cost of opening a file is independent of its size.
+ */
+class MappedFile {
+public:
+	MappedFile(const std::string &filename);
+	~MappedFile();
+
+	MappedFile(const MappedFile &) = delete;
+	MappedFile &operator=(const MappedFile &) = delete;
+
+	bool valid() const { return mData != 0; } //!< True if the file was mapped successfully
+	std::span<const unsigned char> data() const { return std::span<const unsigned char>(mData, mSize); } //!< Contents of the file
+
+private:
+	const unsigned char *mData; //!< Start of the mapping, or 0 if the file could not be mapped
+	size_t mSize; //!< Size of the file
+#ifdef _WIN32
+	void *mFileHandle; //!< Handle of the open file
+	void *mMappingHandle; //!< Handle of the file mapping object
+#endif
+};
+}
+
+#endif
@@ -1,35 +1,77 @@
 #include "VM/OrcFile.h"
 
+#include "Util/Endian.h"
+#include "Util/Hash.h"
+#include "Util/Lz.h"
+
+#include <cstring>
 #include <fstream>
+#include <iterator>
 
 namespace VM {
 
-struct OrcHeader {
-	char magic[4];
-	unsigned int numSections;
-	unsigned int nameSection;
-};
-
-struct OrcSectionHeader {
-	unsigned int name;
-	unsigned int offset;
-	unsigned int size;
-};
+/*
+ * Version 2 layout.  All fields are little-endian.
+ *
+ * Header:
+ *   0  magic "ORCF"
+ *   4  u32 version
+ *   8  u32 number of sections
+ *  12  u32 index of section name string table
+ *  16  u32 section alignment
+ *  20  u32 reserved
+ *
+ * Section header, following the header for each section:
+ *   0  u32 offset of name in section name string table
+ *   4  u32 flags
+ *   8  u32 offset of section contents in file
+ *  12  u32 stored size of section
+ *  16  u32 size of section once decompressed
+ *  20  u32 reserved
+ *  24  u64 FNV-1a checksum of stored contents
+ *
+ * Version 1 files have the magic "ORC\0", followed by the number of sections
+ * and name section index, then a 12-byte (name, offset, size) header for each
+ * section.  Sections are packed with no alignment or checksum.
+ */
+static const unsigned char MagicVersion1[4] = { 'O', 'R', 'C', 0 };
+static const unsigned char MagicVersion2[4] = { 'O', 'R', 'C', 'F' };
+static const size_t HeaderSizeVersion1 = 12;
+static const size_t SectionHeaderSizeVersion1 = 12;
+static const size_t HeaderSize = 24;
+static const size_t SectionHeaderSize = 32;
 
-struct OrcSymbol {
-	unsigned int name;
-	unsigned int offset;
-};
+/*!
+ * \brief Compute the checksum of a section's stored contents
+ * \param contents Stored contents
+ * \return Checksum
+ */
+static uint64_t checksum(std::span<const unsigned char> contents)
+{
+	Util::Hash hash;
+	hash.add(contents.data(), contents.size());
+	return hash.value();
+}
 
 OrcFile::OrcFile(std::istream &stream)
 {
 	read(stream);
 }
 
+/*!
+ * \brief Open a file.  The file is mapped into memory, and its sections are views of the
+ * mapping, so that only the parts of the file which are used are ever read from disk
+ * \param filename Filename
+ */
 OrcFile::OrcFile(const std::string &filename)
 {
-	std::ifstream stream(filename.c_str(), std::ios_base::in | std::ios_base::binary);
-	read(stream);
+	mMapping = std::make_unique<MappedFile>(filename);
+	if(mMapping->valid()) {
+		read(mMapping->data());
+	} else {
+		std::ifstream stream(filename.c_str(), std::ios_base::in | std::ios_base::binary);
+		read(stream);
+	}
 }
 
 OrcFile::OrcFile()
@@ -38,32 +80,63 @@ OrcFile::OrcFile()
 	nameSection->name = addString(*nameSection, "$strings");
 	mNameSection = 0;
 
-	mSectionMap.insert(std::pair<std::string, std::reference_wrapper<Section>>("$strings", *nameSection));
+	mSectionMap["$strings"] = 0;
 	mSectionList.push_back(std::move(nameSection));
 }
 
 void OrcFile::write(std::ostream &stream)
 {
-	OrcHeader header;
-	std::memcpy((char*)&header.magic, "ORC", 4);
-	header.numSections = (unsigned int)mSectionList.size();
-	header.nameSection = mNameSection;
+	// Determine the stored form of each section
+	std::vector<std::vector<unsigned char>> compressed(mSectionList.size());
+	std::vector<std::span<const unsigned char>> stored(mSectionList.size());
+	std::vector<unsigned int> flags(mSectionList.size());
+	for(size_t i=0; i<mSectionList.size(); i++) {
+		const Section &section = *mSectionList[i];
+		stored[i] = section.contents();
+		flags[i] = 0;
 
-	stream.write((char*)&header, sizeof(header));
+		// The name table is read when the file is opened, so it is always stored uncompressed
+		if(section.compress && i != mNameSection) {
+			compressed[i] = Util::Lz::compress(section.contents());
+			if(compressed[i].size() < section.contents().size()) {
+				stored[i] = compressed[i];
+				flags[i] |= FlagCompressed;
+			}
+		}
+	}
+
+	std::vector<unsigned char> header(HeaderSize + mSectionList.size() * SectionHeaderSize);
+	std::memcpy(&header[0], MagicVersion2, 4);
+	Util::writeLittleEndian32(&header[4], Version);
+	Util::writeLittleEndian32(&header[8], (uint32_t)mSectionList.size());
+	Util::writeLittleEndian32(&header[12], mNameSection);
+	Util::writeLittleEndian32(&header[16], SectionAlignment);
+
+	std::vector<size_t> offsets(mSectionList.size());
+	size_t offset = header.size();
+	for(size_t i=0; i<mSectionList.size(); i++) {
+		offset = (offset + SectionAlignment - 1) & ~(size_t)(SectionAlignment - 1);
+		offsets[i] = offset;
 
-	unsigned int offset = (unsigned int)(sizeof(OrcHeader) + mSectionList.size() * sizeof(OrcSectionHeader));
-	for (const std::unique_ptr<Section> &section : mSectionList) {
-		OrcSectionHeader sectionHeader;
-		sectionHeader.name = section->name;
-		sectionHeader.offset = offset;
-		sectionHeader.size = (unsigned int)section->data.size();
-		offset += (unsigned int)section->data.size();
+		unsigned char *sectionHeader = &header[HeaderSize + i * SectionHeaderSize];
+		Util::writeLittleEndian32(sectionHeader + 0, mSectionList[i]->name);
+		Util::writeLittleEndian32(sectionHeader + 4, flags[i]);
+		Util::writeLittleEndian32(sectionHeader + 8, (uint32_t)offset);
+		Util::writeLittleEndian32(sectionHeader + 12, (uint32_t)stored[i].size());
+		Util::writeLittleEndian32(sectionHeader + 16, (uint32_t)mSectionList[i]->contents().size());
+		Util::writeLittleEndian64(sectionHeader + 24, checksum(stored[i]));
 
-		stream.write((char*)&sectionHeader, sizeof(sectionHeader));
+		offset += stored[i].size();
 	}
 
-	for(const std::unique_ptr<Section> &section : mSectionList) {
-		stream.write((char*)&section->data[0], (std::streamsize)section->data.size());
+	stream.write((const char*)header.data(), (std::streamsize)header.size());
+
+	size_t position = header.size();
+	const char padding[SectionAlignment] = {};
+	for(size_t i=0; i<mSectionList.size(); i++) {
+		stream.write(padding, (std::streamsize)(offsets[i] - position));
+		stream.write((const char*)stored[i].data(), (std::streamsize)stored[i].size());
+		position = offsets[i] + stored[i].size();
 	}
 }
 
@@ -73,26 +146,34 @@ void OrcFile::write(const std::string &filename)
 	write(stream);
 }
 
+/*!
+ * \brief Look up a section by name, verifying it if this is the first time it has been used
+ * \param name Section name
+ * \return Section, or 0 if not present or corrupt
+ */
 const OrcFile::Section *OrcFile::section(const std::string &name) const
 {
 	auto it = mSectionMap.find(name);
-	if(it != mSectionMap.end()) {
-		const Section &section = it->second;
-		return &section;
-	} else {
+	if(it == mSectionMap.end() || !load(it->second)) {
 		return 0;
 	}
+
+	return mSectionList[it->second].get();
 }
 
+/*!
+ * \brief Look up a section by name, verifying it if this is the first time it has been used
+ * \param name Section name
+ * \return Section, or 0 if not present or corrupt
+ */
 OrcFile::Section *OrcFile::section(const std::string &name)
 {
 	auto it = mSectionMap.find(name);
-	if(it != mSectionMap.end()) {
-		Section &section = it->second;
-		return &section;
-	} else {
+	if(it == mSectionMap.end() || !load(it->second)) {
 		return 0;
 	}
+
+	return mSectionList[it->second].get();
 }
 
 unsigned int OrcFile::addString(Section &stringTable, const std::string &str)
@@ -106,7 +187,13 @@ unsigned int OrcFile::addString(Section &stringTable, const std::string &str)
 
 std::string OrcFile::getString(const Section &stringTable, unsigned int offset)
 {
-	return std::string((char*)&stringTable.data[offset]);
+	std::span<const unsigned char> contents = stringTable.contents();
+	if(offset >= contents.size()) {
+		return "";
+	}
+
+	const char *start = (const char*)contents.data() + offset;
+	return std::string(start, strnlen(start, contents.size() - offset));
 }
 
 OrcFile::Section &OrcFile::addSection(const std::string &name)
@@ -114,36 +201,163 @@ OrcFile::Section &OrcFile::addSection(const std::string &name)
 	std::unique_ptr<Section> section = std::make_unique<Section>();
 	section->name = addString(*mSectionList[mNameSection], name);
 	Section &ret = *section;
-	mSectionMap.insert(std::pair<std::string, std::reference_wrapper<Section>>(name, *section));
+	mSectionMap[name] = mSectionList.size();
 	mSectionList.push_back(std::move(section));
 
 	return ret;
 }
 
+/*!
+ * \brief Read a file from a stream.  The stream is copied into memory once, and its sections
+ * are views of the copy
+ * \param stream Stream to read from
+ */
 void OrcFile::read(std::istream &stream)
 {
 	stream.seekg(0);
-	OrcHeader header;
-	stream.read((char*)&header, sizeof(header));
+	mBuffer.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+	read(mBuffer);
+}
 
-	mNameSection = header.nameSection;
+/*!
+ * \brief Parse the section table of a file which is held in memory
+ * \param file File contents, which must outlive this object
+ */
+void OrcFile::read(std::span<const unsigned char> file)
+{
+	mNameSection = 0;
 
-	std::vector<OrcSectionHeader> sectionHeaders;
-	sectionHeaders.resize(header.numSections);
-	stream.read((char*)&sectionHeaders[0], sizeof(OrcSectionHeader) * header.numSections);
+	if(file.size() >= HeaderSize && std::memcmp(file.data(), MagicVersion2, 4) == 0) {
+		readVersion2(file);
+	} else if(file.size() >= HeaderSizeVersion1 && std::memcmp(file.data(), MagicVersion1, 4) == 0) {
+		readVersion1(file);
+	}
+
+	// Section names are needed to look up any other section, so verify the name table up front
+	if(mNameSection >= mSectionList.size() || !load(mNameSection)) {
+		mSectionList.clear();
+		mStoredSections.clear();
+		return;
+	}
 
-	for(unsigned int i=0; i<header.numSections; i++) {
-		std::unique_ptr<Section> section = std::make_unique<Section>();
-		section->data.resize(sectionHeaders[i].size);
-		stream.seekg(sectionHeaders[i].offset);
-		stream.read((char*)&section->data[0], sectionHeaders[i].size);
-		section->name = sectionHeaders[i].name;
-		mSectionList.push_back(std::move(section));
+	for(size_t i=0; i<mSectionList.size(); i++) {
+		mSectionMap[getString(*mSectionList[mNameSection], mSectionList[i]->name)] = i;
 	}
+}
 
-	for(const std::unique_ptr<Section> &section : mSectionList) {
-		mSectionMap.insert(std::pair<std::string, std::reference_wrapper<Section>>(getString(*mSectionList[mNameSection], section->name), *section));
+/*!
+ * \brief Parse the section table of a version 1 file
+ * \param file File contents
+ */
+void OrcFile::readVersion1(std::span<const unsigned char> file)
+{
+	unsigned int numSections = Util::readLittleEndian32(&file[4]);
+	mNameSection = Util::readLittleEndian32(&file[8]);
+	if((file.size() - HeaderSizeVersion1) / SectionHeaderSizeVersion1 < numSections) {
+		return;
 	}
+
+	for(unsigned int i=0; i<numSections; i++) {
+		const unsigned char *sectionHeader = &file[HeaderSizeVersion1 + i * SectionHeaderSizeVersion1];
+		unsigned int name = Util::readLittleEndian32(sectionHeader + 0);
+		unsigned int offset = Util::readLittleEndian32(sectionHeader + 4);
+		unsigned int size = Util::readLittleEndian32(sectionHeader + 8);
+		addStoredSection(name, file, offset, size, size, 0, 0);
+
+		// Version 1 files have no checksums, so there is nothing to verify
+		if(mStoredSections.back().state == StoredSection::State::Unchecked) {
+			mSectionList.back()->view = mStoredSections.back().contents;
+			mStoredSections.back().state = StoredSection::State::Valid;
+		}
+	}
+}
+
+/*!
+ * \brief Parse the section table of a version 2 file
+ * \param file File contents
+ */
+void OrcFile::readVersion2(std::span<const unsigned char> file)
+{
+	if(Util::readLittleEndian32(&file[4]) > Version) {
+		return;
+	}
+
+	unsigned int numSections = Util::readLittleEndian32(&file[8]);
+	mNameSection = Util::readLittleEndian32(&file[12]);
+	if((file.size() - HeaderSize) / SectionHeaderSize < numSections) {
+		return;
+	}
+
+	for(unsigned int i=0; i<numSections; i++) {
+		const unsigned char *sectionHeader = &file[HeaderSize + i * SectionHeaderSize];
+		unsigned int name = Util::readLittleEndian32(sectionHeader + 0);
+		unsigned int flags = Util::readLittleEndian32(sectionHeader + 4);
+		unsigned int offset = Util::readLittleEndian32(sectionHeader + 8);
+		unsigned int storedSize = Util::readLittleEndian32(sectionHeader + 12);
+		unsigned int size = Util::readLittleEndian32(sectionHeader + 16);
+		uint64_t sectionChecksum = Util::readLittleEndian64(sectionHeader + 24);
+		addStoredSection(name, file, offset, storedSize, size, flags, sectionChecksum);
+	}
+}
+
+/*!
+ * \brief Record a section read from a file, to be verified when it is first used
+ * \param name Offset of section name in name table
+ * \param file File contents
+ * \param offset Offset of stored contents in file
+ * \param storedSize Size of stored contents
+ * \param size Size of section once decompressed
+ * \param flags Section flags
+ * \param sectionChecksum Checksum of stored contents
+ */
+void OrcFile::addStoredSection(unsigned int name, std::span<const unsigned char> file, size_t offset, size_t storedSize, unsigned int size, unsigned int flags, uint64_t sectionChecksum)
+{
+	std::unique_ptr<Section> section = std::make_unique<Section>();
+	section->name = name;
+	mSectionList.push_back(std::move(section));
+
+	StoredSection stored;
+	stored.flags = flags;
+	stored.size = size;
+	stored.checksum = sectionChecksum;
+	if(offset <= file.size() && storedSize <= file.size() - offset) {
+		stored.contents = file.subspan(offset, storedSize);
+		stored.state = StoredSection::State::Unchecked;
+	} else {
+		stored.state = StoredSection::State::Corrupt;
+	}
+	mStoredSections.push_back(stored);
+}
+
+/*!
+ * \brief Verify a section read from a file and make its contents available, if not already done
+ * \param index Index of section
+ * \return True if the section is usable
+ */
+bool OrcFile::load(size_t index) const
+{
+	// Sections added in memory have nothing to verify
+	if(index >= mStoredSections.size()) {
+		return true;
+	}
+
+	StoredSection &stored = mStoredSections[index];
+	if(stored.state == StoredSection::State::Unchecked) {
+		Section &section = *mSectionList[index];
+		stored.state = StoredSection::State::Corrupt;
+		if(checksum(stored.contents) == stored.checksum) {
+			if(stored.flags & FlagCompressed) {
+				if(Util::Lz::decompress(stored.contents, stored.size, section.data)) {
+					stored.state = StoredSection::State::Valid;
+				}
+			} else if(stored.contents.size() == stored.size) {
+				section.view = stored.contents;
+				stored.state = StoredSection::State::Valid;
+			}
+		}
+	}
+
+	return stored.state == StoredSection::State::Valid;
 }
 
 }
@@ -1,14 +1,28 @@
 #ifndef VM_ORCFILE_H
 #define VM_ORCFILE_H
 
+#include "VM/MappedFile.h"
+
+#include <cstdint>
 #include <vector>
 #include <map>
+#include <span>
 #include <string>
 #include <iostream>
 #include <memory>
 
 namespace VM {
 
+/*!
+ * \brief A compiled module file, made up of named sections
+ *
+ * Files are written in version 2 of the format: all fields are fixed-width and
+ * little-endian, each section begins on a SectionAlignment boundary and carries
+ * a checksum, and sections may be compressed.  A section is verified, and
+ * decompressed if necessary, the first time it is looked up, so that opening a
+ * file does not touch the sections which are never used.  Version 1 files are
+ * still read.
+ */
 class OrcFile {
 public:
 	OrcFile();
@@ -20,23 +34,59 @@ public:
 
 	struct Section {
 		unsigned int name;
-		std::vector<unsigned char> data;
+		std::vector<unsigned char> data; //!< Contents of a section being written, or of a read section which was decompressed
+		std::span<const unsigned char> view; //!< Contents of a section read from a file, in place
+		bool compress; //!< Compress the section when writing, if that makes it smaller
+
+		std::span<const unsigned char> contents() const { return data.empty() ? view : std::span<const unsigned char>(data); } //!< Contents of section
 	};
 
 	const Section *section(const std::string &name) const;
 	Section *section(const std::string &name);
+	bool hasSection(const std::string &name) const { return mSectionMap.find(name) != mSectionMap.end(); } //!< True if the file lists a section, whether or not it is intact
 
 	static unsigned int addString(Section &stringTable, const std::string &str);
 	static std::string getString(const Section &stringTable, unsigned int offset);
 
 	Section &addSection(const std::string &name);
 
+	static const unsigned int Version = 2; //!< Version of the format written
+	static const unsigned int SectionAlignment = 16; //!< Alignment of section contents within the file
+
 private:
+	/*!
+	 * \brief A section as stored in a file which has been read
+	 */
+	struct StoredSection {
+		enum class State {
+			Unchecked, //!< Not yet verified
+			Valid, //!< Verified, and available through the Section
+			Corrupt //!< Failed verification or decompression
+		};
+
+		std::span<const unsigned char> contents; //!< Stored bytes, possibly compressed
+		unsigned int flags; //!< Section flags
+		unsigned int size; //!< Size of section once decompressed
+		uint64_t checksum; //!< Checksum of stored bytes
+		State state; //!< Verification state
+	};
+
+	static const unsigned int FlagCompressed = 0x1; //!< Section is compressed
+
 	std::vector<std::unique_ptr<Section>> mSectionList;
-	std::map<std::string, std::reference_wrapper<Section>> mSectionMap;
+	std::map<std::string, size_t> mSectionMap; //!< Index in mSectionList of each section, keyed by name
 	unsigned int mNameSection;
+	mutable std::vector<StoredSection> mStoredSections; //!< Stored form of each section read from a file, indexed as mSectionList
+
+	std::unique_ptr<MappedFile> mMapping; //!< Mapping of the file, which read sections view
+	std::vector<unsigned char> mBuffer; //!< Copy of the file, which read sections view if it could not be mapped
 
 	void read(std::istream &stream);
+	void read(std::span<const unsigned char> file);
+	void readVersion1(std::span<const unsigned char> file);
+	void readVersion2(std::span<const unsigned char> file);
+	void addStoredSection(unsigned int name, std::span<const unsigned char> file, size_t offset, size_t storedSize, unsigned int size, unsigned int flags, uint64_t checksum);
+	bool load(size_t index) const;
 };
 
 }
@@ -1,74 +1,160 @@
 #include "VM/Program.h"
 
+#include "VM/AddressIndex.h"
 #include "VM/OrcFile.h"
 
+#include "Util/Endian.h"
+
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 #include <iomanip>
 
 namespace VM {
 
-struct OrcSymbol {
-	unsigned int name;
+struct OrcRelocation {
 	unsigned int offset;
+	unsigned int type;
+	unsigned int symbol;
 };
 
 Program::Program()
 {
 }
 
+/*!
+ * \brief Constructor.  The program views the file's sections, so the file must outlive it
+ * \param file File to read
+ */
 Program::Program(const OrcFile &file)
 {
 	read(file);
 }
 
+/*!
+ * \brief Constructor.  The file is mapped and owned by the program
+ * \param filename File to read
+ */
 Program::Program(const std::string &filename)
 {
-	OrcFile file(filename);
-	read(file);
+	open(filename);
 }
 
-void Program::read(const OrcFile &file)
+/*!
+ * \brief Open a file and read the program from it.  The file is mapped and owned by the program
+ * \param filename File to read
+ * \return True if success, false if the file is missing, corrupt or incomplete
+ */
+bool Program::open(const std::string &filename)
 {
-	const OrcFile::Section *codeSection = file.section("code");
-	instructions.resize(codeSection->data.size());
-	std::memcpy(&instructions[0], &codeSection->data[0], codeSection->data.size());
+	file = std::make_unique<OrcFile>(filename);
+	return read(*file);
+}
 
+/*!
+ * \brief Read a program from a file, viewing its code and symbol sections in place
+ * \param file File to read
+ * \return True if success, false if a section is missing or corrupt
+ */
+bool Program::read(const OrcFile &file)
+{
+	const OrcFile::Section *codeSection = file.section("code");
 	const OrcFile::Section *symbolsSection = file.section("symbols");
 	const OrcFile::Section *symbolStringsSection = file.section("symbols.strings");
-	for(unsigned int i=0; i<symbolsSection->data.size() / sizeof(OrcSymbol); i++) {
-		const OrcSymbol *symbol = (OrcSymbol*)&symbolsSection->data[0] + i;
-		std::string name = file.getString(*symbolStringsSection, symbol->name);
-		symbols[name] = symbol->offset;
+	if(!codeSection || !symbolsSection || !symbolStringsSection) {
+		return false;
+	}
+
+	codeView = codeSection->contents();
+	symbolTable = SymbolTable(symbolsSection->contents(), symbolStringsSection->contents());
+
+	// Unlinked programs also carry their unresolved relocations
+	const OrcFile::Section *relocationsSection = file.section("relocations");
+	if(!relocationsSection && file.hasSection("relocations")) {
+		return false;
+	} else if(relocationsSection) {
+		std::span<const unsigned char> relocationData = relocationsSection->contents();
+		for(unsigned int i=0; i<relocationData.size() / sizeof(OrcRelocation); i++) {
+			const unsigned char *data = relocationData.data() + i * sizeof(OrcRelocation);
+			Relocation relocation;
+			relocation.offset = (int)Util::readLittleEndian32(data);
+			relocation.type = (Relocation::Type)Util::readLittleEndian32(data + 4);
+			relocation.symbol = file.getString(*symbolStringsSection, Util::readLittleEndian32(data + 8));
+			relocations.push_back(relocation);
+		}
 	}
 
 	const OrcFile::Section *exportInfoSection = file.section("export_info");
 	const OrcFile::Section *exportInfoStringsSection = file.section("export_info.strings");
-	exportInfo = std::make_unique<Front::ExportInfo>(exportInfoSection->data, exportInfoStringsSection->data);
+	if(exportInfoSection && exportInfoStringsSection) {
+		exportInfo = std::make_unique<Front::ExportInfo>(exportInfoSection->contents(), exportInfoStringsSection->contents());
+	} else if(file.hasSection("export_info") || file.hasSection("export_info.strings")) {
+		return false;
+	}
+
+	return true;
+}
+
+/*!
+ * \brief Look up a symbol by name
+ * \param name Symbol name
+ * \param offset Set to the symbol's offset if found
+ * \return True if the symbol was found
+ */
+bool Program::findSymbol(std::string_view name, int &offset) const
+{
+	auto it = symbols.find(name);
+	if(it != symbols.end()) {
+		offset = it->second;
+		return true;
+	}
+
+	return symbolTable.find(name, offset);
 }
 
 void Program::write(OrcFile &file)
 {
 	OrcFile::Section &codeSection = file.addSection("code");
-	codeSection.data = instructions;
+	codeSection.data.assign(code().begin(), code().end());
 
 	OrcFile::Section &symbolStringsSection = file.addSection("symbols.strings");
 	OrcFile::Section &symbolsSection = file.addSection("symbols");
 
-	symbolsSection.data.resize(symbols.size() * sizeof(OrcSymbol));
-	unsigned int s=0;
-	for(auto &symbolEntry : symbols) {
-		OrcSymbol *symbol = (OrcSymbol*)&symbolsSection.data[0] + s;
-		s++;
-		symbol->name = file.addString(symbolStringsSection, symbolEntry.first);
-		symbol->offset = symbolEntry.second;
+	// Symbols are written sorted by name, so that SymbolTable can search them in place
+	std::vector<std::pair<std::string_view, int>> sortedSymbols;
+	forEachSymbol([&](std::string_view name, int offset) {
+		sortedSymbols.push_back(std::make_pair(name, offset));
+	});
+	std::sort(sortedSymbols.begin(), sortedSymbols.end());
+
+	symbolsSection.data.resize(sortedSymbols.size() * sizeof(OrcSymbol));
+	for(unsigned int s=0; s<sortedSymbols.size(); s++) {
+		unsigned char *data = &symbolsSection.data[s * sizeof(OrcSymbol)];
+		Util::writeLittleEndian32(data, file.addString(symbolStringsSection, std::string(sortedSymbols[s].first)));
+		Util::writeLittleEndian32(data + 4, sortedSymbols[s].second);
+	}
+
+	if(relocations.size() > 0) {
+		OrcFile::Section &relocationsSection = file.addSection("relocations");
+		relocationsSection.data.resize(relocations.size() * sizeof(OrcRelocation));
+		for(unsigned int i=0; i<relocations.size(); i++) {
+			unsigned char *data = &relocationsSection.data[i * sizeof(OrcRelocation)];
+			Util::writeLittleEndian32(data, relocations[i].offset);
+			Util::writeLittleEndian32(data + 4, (unsigned int)relocations[i].type);
+			Util::writeLittleEndian32(data + 8, file.addString(symbolStringsSection, relocations[i].symbol));
+		}
 	}
 
 	if(exportInfo) {
 		OrcFile::Section &exportInfoSection = file.addSection("export_info");
 		OrcFile::Section &exportInfoStringsSection = file.addSection("export_info.strings");
 
+		// Export info is copied out when read rather than viewed in place, so compressing it
+		// costs nothing extra
 		exportInfoSection.data = exportInfo->data();
+		exportInfoSection.compress = true;
 		exportInfoStringsSection.data = exportInfo->strings();
+		exportInfoStringsSection.compress = true;
 	}
 }
 
@@ -81,35 +167,36 @@ void Program::write(const std::string &filename)
 
 void Program::print(std::ostream &o)
 {
+	std::span<const unsigned char> bytes = code();
+
 	int addressWidth = 0;
-	unsigned int size = (unsigned int)instructions.size();
+	unsigned int size = (unsigned int)bytes.size();
 	while(size > 0) {
 		size >>= 4;
 		addressWidth++;
 	}
 
-	for(unsigned int i = 0; i < instructions.size(); i+=4) {
+	AddressIndex index(*this);
+	for(unsigned int i = 0; i < bytes.size(); i+=4) {
 		VM::Instruction instr;
-		for(auto it=symbols.begin(); it != symbols.end(); it++) {
-			if(i == it->second) {
-				o << it->first << ":" << std::endl;
-				break;
-			}
+		std::string_view label = index.find(i);
+		if(!label.empty()) {
+			o << label << ":" << std::endl;
 		}
 
 		o << "  0x" << std::setw(addressWidth) << std::setfill('0') << std::setbase(16) << i << ": ";
 		for(int j=0; j<4; j++) {
 			int d = 0;
-			if(i + j < instructions.size()) {
-				d = instructions[i + j];
+			if(i + j < bytes.size()) {
+				d = bytes[i + j];
 			}
 			o << std::setw(2) << std::setfill('0') << std::setbase(16) << d;
 		}
 		o << std::setbase(10);
-		std::memcpy(&instr, &instructions[i], 4);
+		std::memcpy(&instr, &bytes[i], 4);
 
 		o << "  ";
-		if(!prettyPrintInstruction(o, instr, i, addressWidth)) {
+		if(!prettyPrintInstruction(o, instr, i, addressWidth, index)) {
 			o << instr;
 		}
 		o << std::endl;
@@ -122,9 +209,10 @@ void Program::print(std::ostream &o)
  * \param instr Instruction
  * \param addr Address of instruction
  * \param addressWidth Width to print addresses
+ * \param index Index of the program's symbols by address
  * \return True if pretty printing was possible
  */
-bool Program::prettyPrintInstruction(std::ostream &o, const Instruction &instr, unsigned int addr, int addressWidth)
+bool Program::prettyPrintInstruction(std::ostream &o, const Instruction &instr, unsigned int addr, int addressWidth, const AddressIndex &index)
 {
 	switch(instr.type) {
 		case VM::InstrOneAddr:
@@ -132,11 +220,10 @@ bool Program::prettyPrintInstruction(std::ostream &o, const Instruction &instr,
 				case VM::OneAddrCall:
 					{
 						unsigned int target = addr + instr.one.imm * 4;
-						for(auto &symbolEntry : symbols) {
-							if(symbolEntry.second == target) {
-								o << "call " << symbolEntry.first;
-								return true;
-							}
+						std::string_view name = index.find(target);
+						if(!name.empty()) {
+							o << "call " << name;
+							return true;
 						}
 						break;
 					}
@@ -3,22 +3,45 @@
 
 #include "VM/Instruction.h"
 #include "VM/OrcFile.h"
+#include "VM/SymbolTable.h"
 
 #include "Front/ExportInfo.h"
 
 #include <vector>
+#include <span>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 
 /*!
  * \brief A virtual machine that is targeted by the compiler
  */
 namespace VM {
+	class AddressIndex;
+
+	/*!
+	 * \brief Hash for symbol names, which allows string_views to be looked up without a copy
+	 */
+	struct SymbolHash {
+		typedef void is_transparent;
+		size_t operator()(std::string_view name) const { return std::hash<std::string_view>()(name); }
+	};
+
 	/*!
 	 * \brief A program to be executed by the VM
+	 *
+	 * A program being built holds its code and symbols in instructions and symbols.
+	 * A program read from a file instead views the file's code and symbol sections
+	 * in place, through codeView and symbolTable; code(), findSymbol() and
+	 * forEachSymbol() give access to either form.
 	 */
 	struct Program {
 		std::vector<unsigned char> instructions; //!< Instruction list
-		std::map<std::string, int> symbols;
+		std::unordered_map<std::string, int, SymbolHash, std::equal_to<>> symbols; //!< Offset of each symbol in instructions
+
+		std::unique_ptr<OrcFile> file; //!< File the program was opened from, if it owns one
+		std::span<const unsigned char> codeView; //!< Code section of the file the program was read from
+		SymbolTable symbolTable; //!< Symbol section of the file the program was read from
 
 		struct Relocation {
 			enum class Type {
@@ -39,12 +62,31 @@ namespace VM {
 		Program(const OrcFile &file);
 		Program(const std::string &filename);
 
-		void read(const OrcFile &file);
+		bool open(const std::string &filename);
+		bool read(const OrcFile &file);
 		void write(OrcFile &file);
 		void write(const std::string &filename);
 
+		std::span<const unsigned char> code() const { return codeView.empty() ? std::span<const unsigned char>(instructions) : codeView; } //!< Program code
+		bool findSymbol(std::string_view name, int &offset) const;
+
+		/*!
+		 * \brief Call a function with the name and offset of each symbol in the program
+		 * \param function Function to call
+		 */
+		template<typename Function> void forEachSymbol(Function function) const
+		{
+			for(const auto &symbol : symbols) {
+				function(std::string_view(symbol.first), symbol.second);
+			}
+
+			for(size_t i=0; i<symbolTable.size(); i++) {
+				function(symbolTable.name(i), symbolTable.offset(i));
+			}
+		}
+
 		void print(std::ostream &o);
-		bool prettyPrintInstruction(std::ostream &o, const Instruction &instr, unsigned int addr, int addressWidth);
+		bool prettyPrintInstruction(std::ostream &o, const Instruction &instr, unsigned int addr, int addressWidth, const AddressIndex &index);
 	};
 }
 
@@ -0,0 +1,106 @@
+#ifndef VM_SYMBOL_TABLE_H
+#define VM_SYMBOL_TABLE_H
+
+#include "Util/Endian.h"
+
+#include <cstring>
+#include <span>
+#include <string_view>
+
+namespace VM {
+	/*!
+	 * \brief Entry in the symbol section of a .orc file
+	 */
+	struct OrcSymbol {
+		unsigned int name; //!< Offset of name in the symbol string section
+		unsigned int offset; //!< Offset of symbol in the code section
+	};
+
+	/*!
+	 * \brief View of a .orc symbol section, used in place
+	 *
+	 * Entries are stored sorted by name, so lookups are a binary search over the
+	 * section itself and opening a file does not build any index.  Fields are
+	 * stored little-endian, and are decoded one entry at a time.
+	 */
+	class SymbolTable {
+	public:
+		SymbolTable() {}
+
+		/*!
+		 * \brief Constructor
+		 * \param symbols Contents of symbol section
+		 * \param strings Contents of symbol string section
+		 */
+		SymbolTable(std::span<const unsigned char> symbols, std::span<const unsigned char> strings)
+			: mSymbols(symbols), mStrings(strings)
+		{}
+
+		size_t size() const { return mSymbols.size() / sizeof(OrcSymbol); } //!< Number of symbols
+
+		/*!
+		 * \brief Retrieve a symbol's name
+		 * \param index Index of symbol
+		 * \return Symbol name
+		 */
+		std::string_view name(size_t index) const
+		{
+			unsigned int name = entry(index).name;
+			if(name >= mStrings.size()) {
+				return std::string_view();
+			}
+
+			const char *start = (const char*)mStrings.data() + name;
+			return std::string_view(start, strnlen(start, mStrings.size() - name));
+		}
+
+		int offset(size_t index) const { return (int)entry(index).offset; } //!< Code offset of a symbol
+
+		/*!
+		 * \brief Look up a symbol by name
+		 * \param name Name to search for
+		 * \param offset Set to the symbol's code offset if found
+		 * \return True if the symbol was found
+		 */
+		bool find(std::string_view name, int &offset) const
+		{
+			size_t low = 0;
+			size_t high = size();
+			while(low < high) {
+				size_t middle = low + (high - low) / 2;
+				if(this->name(middle) < name) {
+					low = middle + 1;
+				} else {
+					high = middle;
+				}
+			}
+
+			if(low < size() && this->name(low) == name) {
+				offset = this->offset(low);
+				return true;
+			}
+
+			return false;
+		}
+
+	private:
+		std::span<const unsigned char> mSymbols; //!< Contents of symbol section
+		std::span<const unsigned char> mStrings; //!< Contents of symbol string section
+
+		/*!
+		 * \brief Read a symbol entry
+		 * \param index Index of entry
+		 * \return Entry
+		 */
+		OrcSymbol entry(size_t index) const
+		{
+			const unsigned char *data = mSymbols.data() + index * sizeof(OrcSymbol);
+			OrcSymbol symbol;
+			symbol.name = Util::readLittleEndian32(data);
+			symbol.offset = Util::readLittleEndian32(data + 4);
+			return symbol;
+		}
+	};
+}
+
+#endif